@@ -5,6 +5,77 @@ struct FrameReferece {
     2: string frameName;
 }
 
+/**
+ * Latency of one stage of the acquisition path, in seconds
+ */
+struct LatencyStatistics {
+    1: string stage;
+    2: i64 count;
+    3: double mean;
+    4: double minimum;
+    5: double maximum;
+    6: double median;
+    7: double percentile99;
+}
+
+/**
+ * Counters of the frames seen by one stage of the acquisition path
+ */
+struct FrameCounters {
+    1: i64 frames;
+    /** frame numbers skipped between two consecutive frames */
+    2: i64 missing;
+    /** frames with the same number as the previous one */
+    3: i64 duplicated;
+    /** frames older than the previous one */
+    4: i64 outOfOrder;
+    /** frames discarded by the stage itself (e.g. buffer overruns) */
+    5: i64 dropped;
+}
+
+struct FrameContinuityStatistics {
+    1: string source;
+    2: FrameCounters total;
+    /** counters of the last complete second */
+    3: FrameCounters lastSecond;
+}
+
+/**
+ * Channels enabled in the device, each as "all", "none" or a comma separated list
+ */
+struct EnabledChannels {
+    /** among pose, velocity, acceleration */
+    1: string segments;
+    /** among orientation, angular-velocity, linear-acceleration, magnetic-field */
+    2: string sensors;
+}
+
+/**
+ * Frames kept in the history of the device, each laid out as
+ * [frame number, time | segment positions, orientations, linear velocities,
+ * angular velocities, linear accelerations, angular accelerations |
+ * sensor orientations, angular velocities, linear accelerations, magnetic fields],
+ * with the values of all the segments (or sensors) of a channel stored contiguously
+ */
+struct FrameDataHistory {
+    1: i32 segmentCount;
+    2: i32 sensorCount;
+    /** number of frames in data */
+    3: i32 frameCount;
+    /** the frames, oldest first, one after the other */
+    4: list<double> data;
+}
+
+/**
+ * Status of the wrapper, written on the status port once per second
+ * and at each change of the device status
+ */
+struct XsensStatusFrame {
+    1: list<FrameContinuityStatistics> frameContinuity;
+    /** status of the device, as the XsensStatus of the segments frames */
+    2: i32 status;
+}
+
 /**
  * Methods definition for the XsensDriver Wrapper service
  */
@@ -74,6 +145,22 @@ service XsensDriverService {
      */
     list<FrameReferece> imu_segments_order();
 
+    /** return the version of the list returned by segments_order
+     *
+     * \note the version changes when the model changes, and is the
+     * modelVersion written in the segments frames. 0 if the device does
+     * not version its model (the list is then assumed constant)
+     * @return the version of the segments list
+     */
+    i32 segments_order_version();
+
+    /** return the version of the list returned by imu_segments_order
+     *
+     * \note as segments_order_version, for the modelVersion of the sensors frames
+     * @return the version of the sensors list
+     */
+    i32 imu_segments_order_version();
+
     /** returns the body dimensions currently used in the Xsens suit
      *
      * \note these are the dimensions currently used by the Xsens,
@@ -97,4 +184,55 @@ service XsensDriverService {
      */
     bool setBodyDimensions(map<string, double> dimensions);
 
+    /** returns the latency statistics of each stage of the acquisition path
+     *
+     * \note the stages measured by the driver (if it provides them) come first,
+     * followed by the ones measured by the wrapper. The "-jitter" entries hold the
+     * scheduling jitter of the driver processor thread and of the wrapper thread
+     * @return the statistics of each stage, in the order of the acquisition path
+     */
+    list<LatencyStatistics> latency_statistics();
+
+    /** restart the latency statistics of the driver and of the wrapper
+     */
+    oneway void reset_latency_statistics();
+
+    /** returns the counters of missing, duplicated, out of order and dropped frames
+     *
+     * \note the "driver" source (if the driver provides it) comes first, followed by
+     * the "wrapper" one, which counts the frames skipped or published twice by the wrapper
+     * @return the counters of each source, in total and over the last second
+     */
+    list<FrameContinuityStatistics> frame_continuity_statistics();
+
+    /** restart the frame continuity counters of the driver and of the wrapper
+     */
+    oneway void reset_frame_continuity_statistics();
+
+    /** returns the frames kept by the device newer than lastFrameNumber
+     *
+     * \note the whole history is returned if the frame numbering restarted, and
+     * no frames if the device does not keep a history
+     * @param lastFrameNumber last frame already received, -1 for the whole history
+     * @return the frames, oldest first
+     */
+    FrameDataHistory frames_since(1: i32 lastFrameNumber);
+
+    /** select the channels processed by the device and written by the wrapper
+     *
+     * \note disabled channels are written as zeros, and a frame without any
+     * enabled channel is written with the status only
+     * @param segments "all", "none" or a comma separated list of pose, velocity, acceleration
+     * @param sensors "all", "none" or a comma separated list of orientation,
+     * angular-velocity, linear-acceleration, magnetic-field
+     * @return true if the channels are valid and the device supports the selection
+     */
+    bool set_enabled_channels(1: string segments, 2: string sensors);
+
+    /** returns the channels currently enabled in the device
+     *
+     * @return the enabled channels, in the format of set_enabled_channels
+     */
+    EnabledChannels enabled_channels();
+
 }
@@ -70,6 +70,11 @@ struct XsensSegmentsFrame {
     1: required XsensStatus status;
     /** segments data */
     2: optional list<XsensSegmentData> segmentsData;
+    /** version of the segments list, changed when the model changes (0 if not versioned) */
+    3: i32 modelVersion;
+    /** true if no segment channel is streamed: the frame has no data, and the last data received
+     *  must not be used anymore */
+    4: bool channelsDisabled;
 }
 
 /** Frame output from Xsens with sensors raw data
@@ -78,4 +83,9 @@ struct XsensSensorsFrame {
     1: required XsensStatus status;
     /** sensors data */
     2: optional list<XsensSensorData> sensorsData
+    /** version of the sensors list, changed when the model changes (0 if not versioned) */
+    3: i32 modelVersion;
+    /** true if no sensor channel is streamed: the frame has no data, and the last data received
+     *  must not be used anymore */
+    4: bool channelsDisabled;
 }
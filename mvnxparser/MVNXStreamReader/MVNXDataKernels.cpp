@@ -0,0 +1,576 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "MVNXDataKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+using namespace xmlstream::mvnx::kernels;
+
+void RunningStatistics::reset(const std::size_t width)
+{
+    m_shift.assign(width, 0.0);
+    m_sum.assign(width, 0.0);
+    m_sumOfSquares.assign(width, 0.0);
+    m_min.assign(width, std::numeric_limits<double>::infinity());
+    m_max.assign(width, -std::numeric_limits<double>::infinity());
+    m_validCount.assign(width, 0.0);
+    m_rowCount = 0;
+    m_sample.assign(width, 0.0);
+    m_mask.assign(width, 0.0);
+}
+
+void RunningStatistics::accumulate(const double* row)
+{
+    const std::size_t width = m_sum.size();
+    const double largest = std::numeric_limits<double>::max();
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    // The loops below are kept free of branches and conditional loads, and each one touches only
+    // a few arrays, so that the compiler can vectorise them without too many runtime alias checks.
+    // Non-finite values are masked out once, the remaining loops are plain arithmetic.
+    double* sample = m_sample.data();
+    double* mask = m_mask.data();
+    for (std::size_t i = 0; i < width; ++i) {
+        const double value = row[i];
+        const bool valid = std::fabs(value) <= largest;
+        sample[i] = valid ? value : 0.0;
+        mask[i] = valid ? 1.0 : 0.0;
+    }
+
+    if (m_rowCount == 0) {
+        m_shift = m_sample;
+    }
+    ++m_rowCount;
+
+    const double* shift = m_shift.data();
+    double* sum = m_sum.data();
+    double* sumOfSquares = m_sumOfSquares.data();
+    for (std::size_t i = 0; i < width; ++i) {
+        const double delta = (sample[i] - shift[i]) * mask[i];
+        sum[i] += delta;
+        sumOfSquares[i] += delta * delta;
+    }
+
+    double* validCount = m_validCount.data();
+    for (std::size_t i = 0; i < width; ++i) {
+        validCount[i] += mask[i];
+    }
+
+    double* minimum = m_min.data();
+    double* maximum = m_max.data();
+    for (std::size_t i = 0; i < width; ++i) {
+        const double value = row[i];
+        const bool valid = std::fabs(value) <= largest;
+        const double low = valid ? value : infinity;
+        const double high = valid ? value : -infinity;
+        minimum[i] = low < minimum[i] ? low : minimum[i];
+        maximum[i] = high > maximum[i] ? high : maximum[i];
+    }
+}
+
+unsigned long RunningStatistics::validCount(const std::size_t column) const
+{
+    return static_cast<unsigned long>(m_validCount.at(column));
+}
+
+unsigned long RunningStatistics::nonFiniteCount(const std::size_t column) const
+{
+    return m_rowCount - static_cast<unsigned long>(m_validCount.at(column));
+}
+
+double RunningStatistics::min(const std::size_t column) const
+{
+    if (m_validCount.at(column) == 0.0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return m_min.at(column);
+}
+
+double RunningStatistics::max(const std::size_t column) const
+{
+    if (m_validCount.at(column) == 0.0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return m_max.at(column);
+}
+
+double RunningStatistics::mean(const std::size_t column) const
+{
+    const double count = m_validCount.at(column);
+    if (count == 0.0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return m_shift.at(column) + m_sum.at(column) / count;
+}
+
+double RunningStatistics::standardDeviation(const std::size_t column) const
+{
+    const double count = m_validCount.at(column);
+    if (count == 0.0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (count < 2.0) {
+        return 0.0;
+    }
+    // sample standard deviation computed from the shifted sums
+    const double sum = m_sum.at(column);
+    const double variance = (m_sumOfSquares.at(column) - sum * sum / count) / (count - 1.0);
+    return variance > 0.0 ? std::sqrt(variance) : 0.0;
+}
+
+namespace {
+    const double Pi = 3.14159265358979323846;
+
+    // Row of the source interval [row, row + 1] containing each target time and the normalized
+    // position within it (clamped to [0, 1] outside of the source range)
+    void locateTargets(const std::vector<double>& sourceTimes,
+                       const std::vector<double>& targetTimes,
+                       std::vector<std::size_t>& rows,
+                       std::vector<double>& alphas)
+    {
+        rows.resize(targetTimes.size());
+        alphas.resize(targetTimes.size());
+
+        std::size_t row = 0;
+        for (std::size_t i = 0; i < targetTimes.size(); ++i) {
+            const double time = targetTimes[i];
+            while (row + 2 < sourceTimes.size() && sourceTimes[row + 1] <= time) {
+                ++row;
+            }
+            const double span = sourceTimes[row + 1] - sourceTimes[row];
+            const double alpha = span > 0.0 ? (time - sourceTimes[row]) / span : 0.0;
+            rows[i] = row;
+            alphas[i] = std::min(1.0, std::max(0.0, alpha));
+        }
+    }
+
+    // Fill the output with the only available row, if any. Returns false if the input is long
+    // enough to be interpolated.
+    bool handleShortInput(const std::vector<double>& input,
+                          const std::size_t width,
+                          const std::size_t sourceCount,
+                          const std::size_t targetCount,
+                          std::vector<double>& output)
+    {
+        if (sourceCount >= 2) {
+            return false;
+        }
+        if (sourceCount == 0) {
+            output.assign(targetCount * width, std::numeric_limits<double>::quiet_NaN());
+            return true;
+        }
+        output.resize(targetCount * width);
+        for (std::size_t i = 0; i < targetCount; ++i) {
+            std::copy(input.begin(), input.begin() + width, output.begin() + i * width);
+        }
+        return true;
+    }
+} // namespace
+
+std::vector<double> xmlstream::mvnx::kernels::designLowPassFilter(const double cutoff,
+                                                                   const std::size_t halfLength)
+{
+    const std::size_t length = 2 * halfLength + 1;
+    std::vector<double> taps(length);
+
+    double gain = 0.0;
+    for (std::size_t k = 0; k < length; ++k) {
+        const double n = static_cast<double>(k) - static_cast<double>(halfLength);
+        const double sinc = n == 0.0 ? 2.0 * cutoff : std::sin(2.0 * Pi * cutoff * n) / (Pi * n);
+        const double window =
+            length > 1 ? 0.54 - 0.46 * std::cos(2.0 * Pi * static_cast<double>(k) / (length - 1))
+                       : 1.0;
+        taps[k] = sinc * window;
+        gain += taps[k];
+    }
+
+    for (auto& tap : taps) {
+        tap /= gain;
+    }
+    return taps;
+}
+
+void xmlstream::mvnx::kernels::filterRows(const std::vector<double>& input,
+                                          const std::size_t width,
+                                          const std::vector<double>& taps,
+                                          std::vector<double>& output)
+{
+    const std::size_t rowCount = width > 0 ? input.size() / width : 0;
+    const long halfLength = static_cast<long>(taps.size() / 2);
+    const long lastRow = static_cast<long>(rowCount) - 1;
+    output.assign(rowCount * width, 0.0);
+
+    for (long row = 0; row <= lastRow; ++row) {
+        double* out = output.data() + row * width;
+        for (long k = 0; k < static_cast<long>(taps.size()); ++k) {
+            const long sourceRow = std::min(lastRow, std::max(0L, row + k - halfLength));
+            const double* in = input.data() + sourceRow * width;
+            const double tap = taps[k];
+            for (std::size_t i = 0; i < width; ++i) {
+                out[i] += tap * in[i];
+            }
+        }
+    }
+}
+
+void xmlstream::mvnx::kernels::interpolateLinear(const std::vector<double>& input,
+                                                 const std::size_t width,
+                                                 const std::vector<double>& sourceTimes,
+                                                 const std::vector<double>& targetTimes,
+                                                 std::vector<double>& output)
+{
+    if (handleShortInput(input, width, sourceTimes.size(), targetTimes.size(), output)) {
+        return;
+    }
+
+    std::vector<std::size_t> rows;
+    std::vector<double> alphas;
+    locateTargets(sourceTimes, targetTimes, rows, alphas);
+
+    output.resize(targetTimes.size() * width);
+    for (std::size_t t = 0; t < targetTimes.size(); ++t) {
+        const double* a = input.data() + rows[t] * width;
+        const double* b = a + width;
+        double* out = output.data() + t * width;
+        const double alpha = alphas[t];
+        for (std::size_t i = 0; i < width; ++i) {
+            out[i] = a[i] + alpha * (b[i] - a[i]);
+        }
+    }
+}
+
+void xmlstream::mvnx::kernels::interpolateCubic(const std::vector<double>& input,
+                                                const std::size_t width,
+                                                const std::vector<double>& sourceTimes,
+                                                const std::vector<double>& targetTimes,
+                                                std::vector<double>& output)
+{
+    if (handleShortInput(input, width, sourceTimes.size(), targetTimes.size(), output)) {
+        return;
+    }
+
+    std::vector<std::size_t> rows;
+    std::vector<double> alphas;
+    locateTargets(sourceTimes, targetTimes, rows, alphas);
+
+    const std::size_t lastRow = sourceTimes.size() - 1;
+    output.resize(targetTimes.size() * width);
+    for (std::size_t t = 0; t < targetTimes.size(); ++t) {
+        const std::size_t row = rows[t];
+        const double* p0 = input.data() + (row > 0 ? row - 1 : 0) * width;
+        const double* p1 = input.data() + row * width;
+        const double* p2 = input.data() + (row + 1) * width;
+        const double* p3 = input.data() + std::min(row + 2, lastRow) * width;
+        double* out = output.data() + t * width;
+
+        // Catmull-Rom basis weights
+        const double s = alphas[t];
+        const double s2 = s * s;
+        const double s3 = s2 * s;
+        const double w0 = 0.5 * (-s3 + 2.0 * s2 - s);
+        const double w1 = 0.5 * (3.0 * s3 - 5.0 * s2 + 2.0);
+        const double w2 = 0.5 * (-3.0 * s3 + 4.0 * s2 + s);
+        const double w3 = 0.5 * (s3 - s2);
+        for (std::size_t i = 0; i < width; ++i) {
+            out[i] = w0 * p0[i] + w1 * p1[i] + w2 * p2[i] + w3 * p3[i];
+        }
+    }
+}
+
+void xmlstream::mvnx::kernels::interpolateQuaternions(const std::vector<double>& input,
+                                                      const std::size_t width,
+                                                      const std::vector<double>& sourceTimes,
+                                                      const std::vector<double>& targetTimes,
+                                                      std::vector<double>& output)
+{
+    if (handleShortInput(input, width, sourceTimes.size(), targetTimes.size(), output)) {
+        return;
+    }
+
+    std::vector<std::size_t> rows;
+    std::vector<double> alphas;
+    locateTargets(sourceTimes, targetTimes, rows, alphas);
+
+    output.resize(targetTimes.size() * width);
+    for (std::size_t t = 0; t < targetTimes.size(); ++t) {
+        const double* a = input.data() + rows[t] * width;
+        const double* b = a + width;
+        double* out = output.data() + t * width;
+        const double alpha = alphas[t];
+
+        for (std::size_t q = 0; q + 4 <= width; q += 4) {
+            double dot =
+                a[q] * b[q] + a[q + 1] * b[q + 1] + a[q + 2] * b[q + 2] + a[q + 3] * b[q + 3];
+            // take the shortest path between q and -q
+            const double sign = dot < 0.0 ? -1.0 : 1.0;
+            dot = std::min(1.0, dot * sign);
+
+            double weightA = 1.0 - alpha;
+            double weightB = alpha;
+            // fall back to the normalized linear interpolation for almost parallel quaternions
+            if (dot < 0.9995) {
+                const double theta = std::acos(dot);
+                const double sinTheta = std::sin(theta);
+                weightA = std::sin((1.0 - alpha) * theta) / sinTheta;
+                weightB = std::sin(alpha * theta) / sinTheta;
+            }
+            weightB *= sign;
+
+            double norm = 0.0;
+            for (std::size_t i = q; i < q + 4; ++i) {
+                out[i] = weightA * a[i] + weightB * b[i];
+                norm += out[i] * out[i];
+            }
+            norm = std::sqrt(norm);
+            for (std::size_t i = q; i < q + 4; ++i) {
+                out[i] /= norm;
+            }
+        }
+    }
+}
+
+void xmlstream::mvnx::kernels::fillGaps(std::vector<double>& values,
+                                        const std::size_t width,
+                                        const std::vector<double>& times)
+{
+    const std::size_t rowCount = width > 0 ? values.size() / width : 0;
+    // row of the last finite value of each column, rowCount if there is none yet
+    std::vector<std::size_t> lastValid(width, rowCount);
+
+    for (std::size_t row = 0; row < rowCount; ++row) {
+        const double* current = values.data() + row * width;
+        for (std::size_t i = 0; i < width; ++i) {
+            if (!std::isfinite(current[i])) {
+                continue;
+            }
+            const std::size_t previous = lastValid[i];
+            const std::size_t gapBegin = previous == rowCount ? 0 : previous + 1;
+            for (std::size_t gap = gapBegin; gap < row; ++gap) {
+                double value = current[i];
+                if (previous != rowCount) {
+                    const double span = times[row] - times[previous];
+                    const double alpha = span > 0.0 ? (times[gap] - times[previous]) / span : 0.0;
+                    const double before = values[previous * width + i];
+                    value = before + alpha * (current[i] - before);
+                }
+                values[gap * width + i] = value;
+            }
+            lastValid[i] = row;
+        }
+    }
+
+    for (std::size_t i = 0; i < width; ++i) {
+        if (lastValid[i] == rowCount) {
+            continue;
+        }
+        for (std::size_t row = lastValid[i] + 1; row < rowCount; ++row) {
+            values[row * width + i] = values[lastValid[i] * width + i];
+        }
+    }
+}
+
+void xmlstream::mvnx::kernels::alignQuaternionSigns(std::vector<double>& values,
+                                                    const std::size_t width)
+{
+    const std::size_t rowCount = width > 0 ? values.size() / width : 0;
+    // row of the last finite quaternion of each column, rowCount if there is none yet
+    std::vector<std::size_t> lastValid(width / 4, rowCount);
+
+    for (std::size_t row = 0; row < rowCount; ++row) {
+        double* current = values.data() + row * width;
+        for (std::size_t q = 0; q + 4 <= width; q += 4) {
+            if (!std::isfinite(current[q] + current[q + 1] + current[q + 2] + current[q + 3])) {
+                continue;
+            }
+            if (lastValid[q / 4] != rowCount) {
+                const double* previous = values.data() + lastValid[q / 4] * width;
+                const double dot = previous[q] * current[q] + previous[q + 1] * current[q + 1]
+                                   + previous[q + 2] * current[q + 2]
+                                   + previous[q + 3] * current[q + 3];
+                const double sign = dot < 0.0 ? -1.0 : 1.0;
+                for (std::size_t i = q; i < q + 4; ++i) {
+                    current[i] *= sign;
+                }
+            }
+            lastValid[q / 4] = row;
+        }
+    }
+}
+
+void xmlstream::mvnx::kernels::normalizeQuaternions(std::vector<double>& values,
+                                                    const std::size_t width)
+{
+    const std::size_t rowCount = width > 0 ? values.size() / width : 0;
+    for (std::size_t row = 0; row < rowCount; ++row) {
+        double* current = values.data() + row * width;
+        for (std::size_t q = 0; q + 4 <= width; q += 4) {
+            const double norm =
+                std::sqrt(current[q] * current[q] + current[q + 1] * current[q + 1]
+                          + current[q + 2] * current[q + 2] + current[q + 3] * current[q + 3]);
+            for (std::size_t i = q; i < q + 4; ++i) {
+                current[i] /= norm;
+            }
+        }
+    }
+}
+
+void xmlstream::mvnx::kernels::quaternionsToRotationMatrices(
+    const std::vector<double>& quaternions,
+    std::vector<double>& matrices)
+{
+    const std::size_t count = quaternions.size() / 4;
+    matrices.resize(9 * count);
+
+    const double* q = quaternions.data();
+    double* r = matrices.data();
+    for (std::size_t i = 0; i < count; ++i) {
+        const double w = q[4 * i];
+        const double x = q[4 * i + 1];
+        const double y = q[4 * i + 2];
+        const double z = q[4 * i + 3];
+        // scaling by the squared norm tolerates quaternions which are not exactly unitary
+        const double s = 2.0 / (w * w + x * x + y * y + z * z);
+
+        r[9 * i] = 1.0 - s * (y * y + z * z);
+        r[9 * i + 1] = s * (x * y - w * z);
+        r[9 * i + 2] = s * (x * z + w * y);
+        r[9 * i + 3] = s * (x * y + w * z);
+        r[9 * i + 4] = 1.0 - s * (x * x + z * z);
+        r[9 * i + 5] = s * (y * z - w * x);
+        r[9 * i + 6] = s * (x * z - w * y);
+        r[9 * i + 7] = s * (y * z + w * x);
+        r[9 * i + 8] = 1.0 - s * (x * x + y * y);
+    }
+}
+
+void xmlstream::mvnx::kernels::quaternionsToRPY(const std::vector<double>& quaternions,
+                                                std::vector<double>& angles)
+{
+    const std::size_t count = quaternions.size() / 4;
+    angles.resize(3 * count);
+
+    const double* q = quaternions.data();
+    double* rpy = angles.data();
+    for (std::size_t i = 0; i < count; ++i) {
+        const double w = q[4 * i];
+        const double x = q[4 * i + 1];
+        const double y = q[4 * i + 2];
+        const double z = q[4 * i + 3];
+        const double s = 2.0 / (w * w + x * x + y * y + z * z);
+
+        // only the matrix elements needed by the ZYX decomposition
+        const double r11 = 1.0 - s * (y * y + z * z);
+        const double r21 = s * (x * y + w * z);
+        const double r31 = s * (x * z - w * y);
+        const double r32 = s * (y * z + w * x);
+        const double r33 = 1.0 - s * (x * x + y * y);
+
+        rpy[3 * i] = std::atan2(r32, r33);
+        rpy[3 * i + 1] = std::asin(std::min(1.0, std::max(-1.0, -r31)));
+        rpy[3 * i + 2] = std::atan2(r21, r11);
+    }
+}
+
+std::vector<std::uint64_t>
+xmlstream::mvnx::kernels::combineBitsetRows(const std::vector<std::uint64_t>& words,
+                                            const std::size_t wordCount)
+{
+    std::vector<std::uint64_t> combined(wordCount, 0);
+    const std::size_t rowCount = wordCount > 0 ? words.size() / wordCount : 0;
+    for (std::size_t row = 0; row < rowCount; ++row) {
+        const std::uint64_t* current = words.data() + row * wordCount;
+        for (std::size_t i = 0; i < wordCount; ++i) {
+            combined[i] |= current[i];
+        }
+    }
+    return combined;
+}
+
+void xmlstream::mvnx::kernels::unpackBitsetRows(const std::vector<std::uint64_t>& words,
+                                                const std::size_t wordCount,
+                                                const std::vector<std::size_t>& rows,
+                                                const std::vector<std::size_t>& bits,
+                                                std::vector<double>& output)
+{
+    output.resize(rows.size() * bits.size());
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        const std::uint64_t* current = words.data() + rows[i] * wordCount;
+        double* out = output.data() + i * bits.size();
+        for (std::size_t k = 0; k < bits.size(); ++k) {
+            out[k] = static_cast<double>((current[bits[k] / 64] >> (bits[k] % 64)) & 1u);
+        }
+    }
+}
+
+void xmlstream::mvnx::kernels::transformSegmentPoints(const std::vector<double>& positions,
+                                                      const std::vector<double>& orientations,
+                                                      const SegmentPoints& points,
+                                                      std::vector<double>& output,
+                                                      const unsigned threadCount)
+{
+    const std::size_t segmentCount = points.begins.size() - 1;
+    const std::size_t pointCount = points.x.size();
+    const std::size_t rowCount = segmentCount > 0 ? positions.size() / (3 * segmentCount) : 0;
+    output.resize(rowCount * 3 * pointCount);
+    if (rowCount == 0 || pointCount == 0) {
+        return;
+    }
+
+    auto transformRows = [&](const std::size_t rowBegin, const std::size_t rowEnd) {
+        const double* x = points.x.data();
+        const double* y = points.y.data();
+        const double* z = points.z.data();
+        std::vector<double> quaternions;
+        std::vector<double> rotations;
+        for (std::size_t row = rowBegin; row < rowEnd; ++row) {
+            // rotation matrices of all the segments of the row
+            const auto quaternionsBegin = orientations.begin() + row * 4 * segmentCount;
+            quaternions.assign(quaternionsBegin, quaternionsBegin + 4 * segmentCount);
+            quaternionsToRotationMatrices(quaternions, rotations);
+
+            const double* t = positions.data() + row * 3 * segmentCount;
+            double* out = output.data() + row * 3 * pointCount;
+            for (std::size_t s = 0; s < segmentCount; ++s) {
+                // the segment transform is kept in locals, so the point loop only reads offsets
+                const double tx = t[3 * s];
+                const double ty = t[3 * s + 1];
+                const double tz = t[3 * s + 2];
+                const double* r = rotations.data() + 9 * s;
+                const double r11 = r[0], r12 = r[1], r13 = r[2];
+                const double r21 = r[3], r22 = r[4], r23 = r[5];
+                const double r31 = r[6], r32 = r[7], r33 = r[8];
+                for (std::size_t p = points.begins[s]; p < points.begins[s + 1]; ++p) {
+                    out[3 * p] = tx + r11 * x[p] + r12 * y[p] + r13 * z[p];
+                    out[3 * p + 1] = ty + r21 * x[p] + r22 * y[p] + r23 * z[p];
+                    out[3 * p + 2] = tz + r31 * x[p] + r32 * y[p] + r33 * z[p];
+                }
+            }
+        }
+    };
+
+    // blocks of contiguous rows, small recordings are not worth the threads
+    const std::size_t minimumBlockSize = 256;
+    std::size_t blockCount = threadCount > 0 ? threadCount : std::thread::hardware_concurrency();
+    blockCount = std::max<std::size_t>(1, std::min(blockCount, rowCount / minimumBlockSize));
+    const std::size_t blockSize = (rowCount + blockCount - 1) / blockCount;
+
+    std::vector<std::thread> workers;
+    for (std::size_t block = 1; block < blockCount; ++block) {
+        workers.emplace_back(transformRows,
+                             block * blockSize,
+                             std::min(rowCount, (block + 1) * blockSize));
+    }
+    transformRows(0, std::min(rowCount, blockSize));
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef MVNX_DATA_KERNELS_H
+#define MVNX_DATA_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Batch kernels operating on the numeric frame data extracted by MVNXStreamReader.
+//
+// Data are stored row-major (one row per frame, one column per segment/sensor/joint axis), so
+// that every kernel runs its inner loop over contiguous columns without branches. This layout lets
+// the compiler vectorise the loops without relying on any instruction set specific code.
+
+namespace xmlstream {
+    namespace mvnx {
+        namespace kernels {
+            class RunningStatistics;
+            struct SegmentPoints;
+
+            // Windowed-sinc (Hamming) low-pass filter with 2 * halfLength + 1 taps and unit DC
+            // gain. The cutoff is expressed as a fraction of the sampling rate (0 < cutoff < 0.5).
+            std::vector<double> designLowPassFilter(const double cutoff,
+                                                    const std::size_t halfLength);
+
+            // Zero-phase FIR filtering of every column of a row-major buffer. The first and last
+            // rows are repeated beyond the buffer ends. NaN rows spread over the filter length.
+            void filterRows(const std::vector<double>& input,
+                            const std::size_t width,
+                            const std::vector<double>& taps,
+                            std::vector<double>& output);
+
+            // Resample every column of a row-major buffer from sourceTimes to targetTimes, both
+            // sorted in ascending order. Targets outside the source range take the closest row.
+            void interpolateLinear(const std::vector<double>& input,
+                                   const std::size_t width,
+                                   const std::vector<double>& sourceTimes,
+                                   const std::vector<double>& targetTimes,
+                                   std::vector<double>& output);
+            // Catmull-Rom spline through the rows around each target
+            void interpolateCubic(const std::vector<double>& input,
+                                  const std::size_t width,
+                                  const std::vector<double>& sourceTimes,
+                                  const std::vector<double>& targetTimes,
+                                  std::vector<double>& output);
+            // Spherical linear interpolation of rows made of (w, x, y, z) quaternions
+            void interpolateQuaternions(const std::vector<double>& input,
+                                        const std::size_t width,
+                                        const std::vector<double>& sourceTimes,
+                                        const std::vector<double>& targetTimes,
+                                        std::vector<double>& output);
+
+            // Replace the non-finite values of every column of a row-major buffer with the linear
+            // interpolation in time of the closest finite values of the column. Values before the
+            // first or after the last finite one take its value, columns without any are kept.
+            void fillGaps(std::vector<double>& values,
+                          const std::size_t width,
+                          const std::vector<double>& times);
+
+            // Flip the sign of the quaternions whose dot product with the last finite one of the
+            // same column is negative, so that q and -q do not alternate along the time series.
+            // Quaternions with non-finite components are left unchanged.
+            void alignQuaternionSigns(std::vector<double>& values, const std::size_t width);
+            void normalizeQuaternions(std::vector<double>& values, const std::size_t width);
+
+            // Batch conversions of a buffer of (w, x, y, z) quaternions. Matrices are stored
+            // row-major (R11, R12, ..., R33), RPY angles are the ZYX Euler angles
+            // (roll, pitch, yaw) in radians.
+            void quaternionsToRotationMatrices(const std::vector<double>& quaternions,
+                                               std::vector<double>& matrices);
+            void quaternionsToRPY(const std::vector<double>& quaternions,
+                                  std::vector<double>& angles);
+
+            // World positions of the points rigidly attached to the segments, computed from the
+            // rows of segment positions (x, y, z) and orientations (w, x, y, z). The rows are
+            // processed in blocks by up to threadCount threads (0 uses all the hardware ones).
+            void transformSegmentPoints(const std::vector<double>& positions,
+                                        const std::vector<double>& orientations,
+                                        const SegmentPoints& points,
+                                        std::vector<double>& output,
+                                        const unsigned threadCount = 0);
+
+            // Bitwise OR of all the rows of a row-major buffer of bitsets, wordCount words each
+            std::vector<std::uint64_t> combineBitsetRows(const std::vector<std::uint64_t>& words,
+                                                         const std::size_t wordCount);
+            // Expand the selected bits of the requested rows into 0/1 columns
+            void unpackBitsetRows(const std::vector<std::uint64_t>& words,
+                                  const std::size_t wordCount,
+                                  const std::vector<std::size_t>& rows,
+                                  const std::vector<std::size_t>& bits,
+                                  std::vector<double>& output);
+        } // namespace kernels
+    } // namespace mvnx
+} // namespace xmlstream
+
+// Offsets of the points in the frame of their segment, grouped by segment: the points of segment s
+// are [begins[s], begins[s + 1]). Coordinates are stored in separate arrays so that a segment's
+// points are transformed by a single loop over contiguous memory.
+struct xmlstream::mvnx::kernels::SegmentPoints
+{
+    std::vector<std::size_t> begins{0};
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> z;
+};
+
+// Per-column min/max/mean/std and non-finite counters, updated one row at a time.
+// Sums are computed with respect to the first row (its finite values) to limit the cancellation
+// error of the single-pass variance.
+class xmlstream::mvnx::kernels::RunningStatistics
+{
+private:
+    std::vector<double> m_shift;
+    std::vector<double> m_sum;
+    std::vector<double> m_sumOfSquares;
+    std::vector<double> m_min;
+    std::vector<double> m_max;
+    // counters are kept as doubles to share the vector width of the data
+    std::vector<double> m_validCount;
+    unsigned long m_rowCount = 0;
+
+    // scratch rows: the input with non-finite values zeroed, and 1.0/0.0 validity flags
+    std::vector<double> m_sample;
+    std::vector<double> m_mask;
+
+public:
+    void reset(const std::size_t width);
+    void accumulate(const double* row);
+
+    std::size_t width() const { return m_sum.size(); }
+    unsigned long validCount(const std::size_t column) const;
+    unsigned long nonFiniteCount(const std::size_t column) const;
+    double min(const std::size_t column) const;
+    double max(const std::size_t column) const;
+    double mean(const std::size_t column) const;
+    double standardDeviation(const std::size_t column) const;
+};
+
+#endif // MVNX_DATA_KERNELS_H
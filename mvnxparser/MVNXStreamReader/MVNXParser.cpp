@@ -53,6 +53,59 @@ int main(int argc, char* argv[])
         QCoreApplication::translate("main", "xsd-file-path"));
     optionsParser.addOption(validateSchemaOption);
 
+    // Boolean option to enable the per-channel statistics summary
+    QCommandLineOption statisticsOption(
+        "stats",
+        QCoreApplication::translate("main",
+                                    "Save min/max/mean/std and NaN/gap counts of every channel"));
+    optionsParser.addOption(statisticsOption);
+
+    // Option to resample the exported data at the user-provided rate
+    QCommandLineOption resampleOption(
+        "resample",
+        QCoreApplication::translate(
+            "main", "Resample the exported data at <rate> Hz, low-pass filtering when decimating."),
+        QCoreApplication::translate("main", "rate"));
+    optionsParser.addOption(resampleOption);
+
+    // Option to select the interpolation used for the non-quaternion data when resampling
+    QCommandLineOption interpolationOption(
+        "interpolation",
+        QCoreApplication::translate(
+            "main", "Interpolation of the resampled vectors: linear (default) or cubic."),
+        QCoreApplication::translate("main", "method"),
+        "linear");
+    optionsParser.addOption(interpolationOption);
+
+    // Option to select the representation of the exported orientations
+    QCommandLineOption orientationOption(
+        "orientation",
+        QCoreApplication::translate(
+            "main", "Export orientations as quaternion (default), matrix or rpy (ZYX, radians)."),
+        QCoreApplication::translate("main", "format"),
+        "quaternion");
+    optionsParser.addOption(orientationOption);
+
+    // Boolean option to remove the q / -q sign flips of the exported quaternions
+    QCommandLineOption continuousQuaternionsOption(
+        "continuousQuaternions",
+        QCoreApplication::translate("main", "Keep consecutive quaternions in the same hemisphere"));
+    optionsParser.addOption(continuousQuaternionsOption);
+
+    // Option to export the contacts of the frames
+    QCommandLineOption contactsOption(
+        "contacts",
+        QCoreApplication::translate(
+            "main", "Save the contacts as 0/1 columns or as a packed hexadecimal bitset."),
+        QCoreApplication::translate("main", "columns|packed"));
+    optionsParser.addOption(contactsOption);
+
+    // Boolean option to export the world trajectories of the points of the segments
+    QCommandLineOption pointsOption(
+        "points",
+        QCoreApplication::translate("main", "Save the world position of the segment points"));
+    optionsParser.addOption(pointsOption);
+
     // Option to enable mvnx validation based on user-provided XSD file
     QCommandLineOption targetDirectoryOption(
         "outputFolder",
@@ -63,6 +116,31 @@ int main(int argc, char* argv[])
     // process the command line arguments and options used
     optionsParser.process(mvnxParser);
 
+    MVNXStreamReader::OutputDataType linkOrientation = MVNXStreamReader::LINK_ORIENTATION;
+    MVNXStreamReader::OutputDataType sensorOrientation = MVNXStreamReader::SENSOR_ORIENTATION;
+    if (optionsParser.value(orientationOption) == "matrix") {
+        linkOrientation = MVNXStreamReader::LINK_ORIENTATION_MATRIX;
+        sensorOrientation = MVNXStreamReader::SENSOR_ORIENTATION_MATRIX;
+    }
+    else if (optionsParser.value(orientationOption) == "rpy") {
+        linkOrientation = MVNXStreamReader::LINK_ORIENTATION_RPY;
+        sensorOrientation = MVNXStreamReader::SENSOR_ORIENTATION_RPY;
+    }
+    else if (optionsParser.value(orientationOption) != "quaternion") {
+        std::cerr << "Unknown orientation format" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    MVNXStreamReader::OutputDataType contacts = MVNXStreamReader::CONTACTS;
+    if (optionsParser.value(contactsOption) == "packed") {
+        contacts = MVNXStreamReader::CONTACTS_PACKED;
+    }
+    else if (optionsParser.isSet(contactsOption)
+             && optionsParser.value(contactsOption) != "columns") {
+        std::cerr << "Unknown contacts format" << std::endl;
+        return EXIT_FAILURE;
+    }
+
     // create MVNXStreamReader object
     MVNXStreamReader mvnx;
 
@@ -122,6 +200,30 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
     }
 
+    // if requested, resample the data before printing them
+    if (optionsParser.isSet(resampleOption)) {
+        bool isRateValid = false;
+        const double rate = optionsParser.value(resampleOption).toDouble(&isRateValid);
+
+        MVNXStreamReader::InterpolationMethod method = MVNXStreamReader::LINEAR;
+        if (optionsParser.value(interpolationOption) == "cubic") {
+            method = MVNXStreamReader::CUBIC;
+        }
+        else if (optionsParser.value(interpolationOption) != "linear") {
+            std::cerr << "Unknown interpolation method" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        if (!isRateValid || !mvnx.resample(rate, method)) {
+            std::cerr << "Failed to resample the MVNX data" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (optionsParser.isSet(continuousQuaternionsOption)) {
+        mvnx.enforceQuaternionContinuity();
+    }
+
     // create output files
     // ===================
 
@@ -146,10 +248,10 @@ int main(int argc, char* argv[])
         mvnx.printDataFile(modelCreationDataFile,
                            std::vector<MVNXStreamReader::OutputDataType>{
                                MVNXStreamReader::OutputDataType::LINK_ACCELERATION,
-                               MVNXStreamReader::OutputDataType::LINK_ORIENTATION,
+                               linkOrientation,
                                MVNXStreamReader::OutputDataType::LINK_ANGULAR_VELOCITY,
                                MVNXStreamReader::OutputDataType::LINK_ANGULAR_ACCELERATION,
-                               MVNXStreamReader::OutputDataType::SENSOR_ORIENTATION,
+                               sensorOrientation,
                                MVNXStreamReader::OutputDataType::SENSOR_FREE_BODY_ACCELERATION,
                            },
                            ',');
@@ -168,5 +270,33 @@ int main(int argc, char* argv[])
                            ',');
     }
 
+    // if requested print the contacts, the dictionary of the packed bits is in the .log file
+    if (optionsParser.isSet(contactsOption)) {
+        std::string contactsFile =
+            (outputFolder.absolutePath() + QDir::separator()).toStdString()
+            + inputFileInfo.baseName().toStdString() + "_contacts.csv";
+        mvnx.printDataFile(
+            contactsFile, std::vector<MVNXStreamReader::OutputDataType>{contacts}, ',');
+    }
+
+    // if requested print the world trajectories of the points of the segments
+    if (optionsParser.isSet(pointsOption)) {
+        std::string pointsFile =
+            (outputFolder.absolutePath() + QDir::separator()).toStdString()
+            + inputFileInfo.baseName().toStdString() + "_points.csv";
+        mvnx.printDataFile(
+            pointsFile,
+            std::vector<MVNXStreamReader::OutputDataType>{MVNXStreamReader::POINT_POSITION},
+            ',');
+    }
+
+    // if requested print the statistics computed while parsing
+    if (optionsParser.isSet(statisticsOption)) {
+        std::string statisticsFile =
+            (outputFolder.absolutePath() + QDir::separator()).toStdString()
+            + inputFileInfo.baseName().toStdString() + "_stats.csv";
+        mvnx.printStatisticsFile(statisticsFile, ',');
+    }
+
     return EXIT_SUCCESS;
 }
@@ -7,8 +7,15 @@
  */
 
 #include "MVNXStreamReader.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <limits>
+#include <locale>
 #include <sstream>
 
 using namespace xmlstream;
@@ -25,6 +32,80 @@ std::vector<double> stringToDoubles(const std::string& aString)
     return vec;
 }
 
+// Parse a "nan" or "inf" token, with an optional sign and in any case, which the stream
+// operators do not accept
+static bool parseNonFinite(const std::string& token, double& value)
+{
+    std::string name = token;
+    const bool negative = !name.empty() && name[0] == '-';
+    if (!name.empty() && (name[0] == '-' || name[0] == '+')) {
+        name.erase(0, 1);
+    }
+    std::transform(name.begin(), name.end(), name.begin(), [](const unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    if (name == "nan") {
+        value = std::numeric_limits<double>::quiet_NaN();
+    }
+    else if (name == "inf" || name == "infinity") {
+        value = negative ? -std::numeric_limits<double>::infinity()
+                         : std::numeric_limits<double>::infinity();
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+// Parse exactly count values from a whitespace separated text. The stream uses the classic
+// locale, as the MVNX files always have a decimal point whatever LC_NUMERIC the application set,
+// and "nan" and "inf" are parsed apart: they are stored and then counted by the channel
+// statistics.
+static bool parseDoubles(const std::string& text, double* values, const std::size_t count)
+{
+    std::istringstream stream(text);
+    stream.imbue(std::locale::classic());
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::istringstream::pos_type begin = stream.tellg();
+        if (stream >> values[i]) {
+            // a number followed by other characters is malformed
+            if (!stream.eof() && !std::isspace(stream.peek())) {
+                return false;
+            }
+            continue;
+        }
+        // the operator may have consumed a sign: read the whole token again
+        stream.clear();
+        stream.seekg(begin);
+        std::string token;
+        if (!(stream >> token) || !parseNonFinite(token, values[i])) {
+            return false;
+        }
+    }
+    // more values than expected make the text malformed as well
+    std::string extra;
+    return !(stream >> extra);
+}
+
+// Number of decimal digits of the first value of a whitespace separated text
+static int countDecimals(const std::string& text)
+{
+    const std::size_t begin = text.find_first_not_of(" \t\r\n");
+    const std::size_t end = text.find_first_of(" \t\r\n", begin);
+    const std::size_t point = text.find('.', begin);
+    if (begin == std::string::npos || point == std::string::npos || point > end) {
+        return 0;
+    }
+    int decimals = 0;
+    for (std::size_t i = point + 1; i < text.size(); ++i) {
+        if (!std::isdigit(static_cast<unsigned char>(text[i]))) {
+            break;
+        }
+        ++decimals;
+    }
+    return decimals;
+}
+
 MVNXStreamReader::MVNXStreamReader()
 {
     m_xmlKeysMap =
@@ -392,9 +473,9 @@ bool MVNXStreamReader::parseFrame(const xmlstream::XMLContentPtrS inFrame,
                 std::string out{};
                 for (const auto& contacts : *(child->getChildElements())) {
                     for (const auto& contact : *(contacts.second)) {
-                        out.append(contact->getAttribute("segment"));
-                        out.append(":");
-                        out.append(contact->getAttribute("point"));
+                        outFrame.contacts.push_back(contact->getAttribute("segment") + ":"
+                                                    + contact->getAttribute("point"));
+                        out.append(outFrame.contacts.back());
                         out.append(std::string{sep});
                     }
                 }
@@ -408,6 +489,10 @@ bool MVNXStreamReader::parseFrame(const xmlstream::XMLContentPtrS inFrame,
 void MVNXStreamReader::parseFrames()
 {
     std::vector<XMLContentPtrS> frames = this->findElement(m_xmlKeysMap.at("frame"));
+    // the frames may be disabled by the parsing configuration
+    if (frames.empty()) {
+        return;
+    }
 
     // Update generic info about number of sensors, segments, and joints from frames attributes
     if (!frames.front()->getParent()->getAttribute("segmentCount").empty()) {
@@ -420,7 +505,9 @@ void MVNXStreamReader::parseFrames()
         m_nJoints = std::stoi(frames.front()->getParent()->getAttribute("jointCount"));
     }
 
-    // parse the frames
+    initializeChannels(frames.size());
+
+    // parse the frames, filling the column store and its statistics in the same pass
     for (auto& frame : frames) {
         Frame tmpFrame;
         if (!parseFrame(frame, tmpFrame)) {
@@ -428,10 +515,351 @@ void MVNXStreamReader::parseFrames()
                       << std::endl;
             exit(EXIT_FAILURE);
         };
+        if (tmpFrame.properties.type == "normal") {
+            appendFrameToChannels(tmpFrame);
+        }
         m_parsedFrames.push_back(std::make_shared<Frame>(tmpFrame));
     }
 }
 
+void MVNXStreamReader::initializeChannels(const unsigned long expectedFrameCount)
+{
+    const std::vector<std::string> segmentNames = getSegmentNames();
+    const std::vector<std::string> sensorNames = getSensorNames();
+    const std::vector<std::string> jointNames = getJointNames();
+    const std::vector<std::string> xyz{"X", "Y", "Z"};
+    const std::vector<std::string> wxyz{"W", "X", "Y", "Z"};
+
+    m_channels.clear();
+    m_channelFrameCount = 0;
+    m_channelTimes.clear();
+    m_channelTimes.reserve(expectedFrameCount);
+    m_channelIndices.clear();
+    m_channelIndices.reserve(expectedFrameCount);
+    m_channelClockTimes.clear();
+    m_channelClockTimes.reserve(expectedFrameCount);
+    m_quaternionSignsAligned = false;
+    m_channelDecimals = -1;
+
+    // the contact points declared in the header come first in the dictionary
+    m_contactPoints.clear();
+    m_contactPointIds.clear();
+    for (const auto& point : getPoints()) {
+        m_contactPointIds.emplace(point.first, m_contactPoints.size());
+        m_contactPoints.push_back(point.first);
+    }
+    m_contactWordCount = std::max<std::size_t>(1, (m_contactPoints.size() + 63) / 64);
+    m_contactBits.clear();
+    m_contactBits.reserve(expectedFrameCount * m_contactWordCount);
+
+    initializeSegmentPoints();
+    m_resampledTimes.clear();
+    m_resampledRate = 0;
+
+    auto addChannel = [&](const std::string& label,
+                          const std::vector<std::string>& itemLabels,
+                          const std::vector<std::string>& postfixes) {
+        // skip the channels not available in the current MVNX version
+        if (m_xmlKeysMap.at(label).empty()) {
+            return;
+        }
+        DataChannel channel;
+        channel.key = label;
+        channel.name = m_xmlKeysMap.at(label);
+        channel.labels = createSingleTypeLabelList(channel.name, itemLabels, postfixes);
+        channel.isQuaternion = postfixes.size() == 4;
+        channel.values.reserve(expectedFrameCount * channel.labels.size());
+        channel.statistics.reset(channel.labels.size());
+        m_channels.push_back(channel);
+    };
+
+    addChannel("link_position", segmentNames, xyz);
+    addChannel("link_velocity", segmentNames, xyz);
+    addChannel("link_acceleration", segmentNames, xyz);
+    addChannel("link_orientation", segmentNames, wxyz);
+    addChannel("link_angular_velocity", segmentNames, xyz);
+    addChannel("link_angular_acceleration", segmentNames, xyz);
+    addChannel("sensor_orientation", sensorNames, wxyz);
+    addChannel("sensor_angular_velocity", sensorNames, xyz);
+    addChannel("sensor_acceleration", sensorNames, xyz);
+    addChannel("sensor_free_body_acceleration", sensorNames, xyz);
+    addChannel("sensor_magnetic_field", sensorNames, xyz);
+    addChannel("joint_angle", jointNames, xyz);
+    addChannel("joint_angle_xzy", jointNames, xyz);
+    addChannel("center_of_mass", std::vector<std::string>{"com"}, xyz);
+}
+
+void MVNXStreamReader::appendFrameToChannels(const Frame& frame)
+{
+    for (auto& channel : m_channels) {
+        const std::size_t width = channel.labels.size();
+        const std::size_t rowBegin = channel.values.size();
+        channel.values.resize(rowBegin + width);
+        double* row = channel.values.data() + rowBegin;
+
+        auto element = frame.data.find(channel.name);
+        if (element != frame.data.end() && m_channelFrameCount == 0) {
+            m_channelDecimals = std::max(m_channelDecimals, countDecimals(element->second));
+        }
+        if (element == frame.data.end() || !parseDoubles(element->second, row, width)) {
+            std::fill(row, row + width, std::numeric_limits<double>::quiet_NaN());
+            ++channel.gapCount;
+            continue;
+        }
+        channel.statistics.accumulate(row);
+    }
+
+    const std::size_t contactRowBegin = m_contactBits.size();
+    m_contactBits.resize(contactRowBegin + m_contactWordCount, 0);
+    for (const auto& contact : frame.contacts) {
+        const std::size_t id = getContactPointId(contact);
+        // the row may have moved if the dictionary needed more words
+        const std::size_t rowBegin = m_contactBits.size() - m_contactWordCount;
+        m_contactBits[rowBegin + id / 64] |= std::uint64_t{1} << (id % 64);
+    }
+
+    m_channelTimes.push_back(frame.properties.timeFromStart);
+    m_channelIndices.push_back(frame.properties.index);
+    m_channelClockTimes.push_back(frame.properties.clockTimems);
+    ++m_channelFrameCount;
+}
+
+void MVNXStreamReader::initializeSegmentPoints()
+{
+    const std::vector<std::string> segmentNames = getSegmentNames();
+    const std::vector<Point> points = getPoints();
+
+    // point names are "segment:point", group them following the order of the segments
+    std::vector<std::vector<const Point*>> segmentPoints(segmentNames.size());
+    for (const auto& point : points) {
+        const std::string segment = point.first.substr(0, point.first.find(':'));
+        const auto it = std::find(segmentNames.begin(), segmentNames.end(), segment);
+        if (it == segmentNames.end() || point.second.size() != 3) {
+            std::cerr << "Warning: ignoring point " << point.first << std::endl;
+            continue;
+        }
+        segmentPoints.at(it - segmentNames.begin()).push_back(&point);
+    }
+
+    m_segmentPoints = kernels::SegmentPoints();
+    m_segmentPointNames.clear();
+    for (const auto& pointsOfSegment : segmentPoints) {
+        for (const auto point : pointsOfSegment) {
+            m_segmentPointNames.push_back(point->first);
+            m_segmentPoints.x.push_back(point->second.at(0));
+            m_segmentPoints.y.push_back(point->second.at(1));
+            m_segmentPoints.z.push_back(point->second.at(2));
+        }
+        m_segmentPoints.begins.push_back(m_segmentPointNames.size());
+    }
+}
+
+std::size_t MVNXStreamReader::getContactPointId(const std::string& contactPoint)
+{
+    auto id = m_contactPointIds.find(contactPoint);
+    if (id != m_contactPointIds.end()) {
+        return id->second;
+    }
+
+    // contact points not declared in the header are appended to the dictionary, adding one word
+    // to every stored bitset when needed
+    const std::size_t newId = m_contactPoints.size();
+    m_contactPointIds.emplace(contactPoint, newId);
+    m_contactPoints.push_back(contactPoint);
+
+    if (newId / 64 >= m_contactWordCount) {
+        const std::size_t rowCount = m_contactBits.size() / m_contactWordCount;
+        std::vector<std::uint64_t> grown(rowCount * (m_contactWordCount + 1), 0);
+        for (std::size_t row = 0; row < rowCount; ++row) {
+            std::copy(m_contactBits.begin() + row * m_contactWordCount,
+                      m_contactBits.begin() + (row + 1) * m_contactWordCount,
+                      grown.begin() + row * (m_contactWordCount + 1));
+        }
+        m_contactBits.swap(grown);
+        ++m_contactWordCount;
+    }
+    return newId;
+}
+
+std::vector<std::size_t> MVNXStreamReader::getActiveContactPoints() const
+{
+    const std::vector<std::uint64_t> combined =
+        kernels::combineBitsetRows(m_contactBits, m_contactWordCount);
+
+    std::vector<std::size_t> activePoints;
+    for (std::size_t id = 0; id < m_contactPoints.size(); ++id) {
+        if ((combined[id / 64] >> (id % 64)) & 1u) {
+            activePoints.push_back(id);
+        }
+    }
+    return activePoints;
+}
+
+const DataChannel*
+MVNXStreamReader::findChannel(const MVNXStreamReader::OutputDataType& dataType) const
+{
+    std::string key;
+    switch (dataType) {
+        case LINK_POSITION:
+            key = "link_position";
+            break;
+        case LINK_VELOCITY:
+            key = "link_velocity";
+            break;
+        case LINK_ACCELERATION:
+            key = "link_acceleration";
+            break;
+        case LINK_ORIENTATION:
+        case LINK_ORIENTATION_MATRIX:
+        case LINK_ORIENTATION_RPY:
+            key = "link_orientation";
+            break;
+        case LINK_ANGULAR_VELOCITY:
+            key = "link_angular_velocity";
+            break;
+        case LINK_ANGULAR_ACCELERATION:
+            key = "link_angular_acceleration";
+            break;
+        case SENSOR_ORIENTATION:
+        case SENSOR_ORIENTATION_MATRIX:
+        case SENSOR_ORIENTATION_RPY:
+            key = "sensor_orientation";
+            break;
+        case SENSOR_ANGULAR_VELOCITY:
+            key = "sensor_angular_velocity";
+            break;
+        case SENSOR_ACCELERATION:
+            key = "sensor_acceleration";
+            break;
+        case SENSOR_FREE_BODY_ACCELERATION:
+            key = "sensor_free_body_acceleration";
+            break;
+        case SENSOR_MAGNETIC_FIELD:
+            key = "sensor_magnetic_field";
+            break;
+        case JOINT_ANGLE:
+            key = "joint_angle";
+            break;
+        case JOINT_ANGLE_XZY:
+            key = "joint_angle_xzy";
+            break;
+        case CENTER_OF_MASS:
+            key = "center_of_mass";
+            break;
+        case CONTACTS:
+        case CONTACTS_PACKED:
+        case POINT_POSITION:
+            break;
+    }
+
+    for (const auto& channel : m_channels) {
+        if (channel.key == key) {
+            return &channel;
+        }
+    }
+    return nullptr;
+}
+
+double MVNXStreamReader::getFrameRate() const
+{
+    if (!m_XMLTreeRoot) {
+        return 0;
+    }
+
+    const auto subjects = m_XMLTreeRoot->findChildElements(m_xmlKeysMap.at("subject"));
+    if (subjects.empty() || subjects.front()->getAttribute("frameRate").empty()) {
+        return 0;
+    }
+    return std::stod(subjects.front()->getAttribute("frameRate"));
+}
+
+bool MVNXStreamReader::resample(const double targetRate, const InterpolationMethod method)
+{
+    if (targetRate <= 0) {
+        std::cerr << "Invalid resampling rate " << targetRate << std::endl;
+        return false;
+    }
+    if (m_channelTimes.size() < 2) {
+        std::cerr << "Not enough frames to resample the data" << std::endl;
+        return false;
+    }
+
+    // use the average rate of the frames if the subject does not specify it
+    const double firstTime = m_channelTimes.front();
+    const double lastTime = m_channelTimes.back();
+    double sourceRate = getFrameRate();
+    if (sourceRate <= 0 && lastTime > firstTime) {
+        sourceRate = 1000.0 * (m_channelTimes.size() - 1) / (lastTime - firstTime);
+    }
+
+    const double period = 1000.0 / targetRate;
+    m_resampledTimes.clear();
+    for (unsigned long k = 0; firstTime + k * period <= lastTime; ++k) {
+        m_resampledTimes.push_back(firstTime + k * period);
+    }
+
+    // anti-aliasing filter, needed only when decimating
+    std::vector<double> taps;
+    if (sourceRate > targetRate) {
+        const double ratio = sourceRate / targetRate;
+        taps = kernels::designLowPassFilter(0.5 / ratio,
+                                            static_cast<std::size_t>(std::ceil(4.0 * ratio)));
+    }
+
+    std::vector<double> gapless;
+    std::vector<double> filtered;
+    for (auto& channel : m_channels) {
+        const std::size_t width = channel.labels.size();
+        // the missing or malformed values would spread NaN over the whole filter window, they are
+        // interpolated from the closest valid rows first (after the sign alignment, so that the
+        // quaternions are interpolated along the shortest path)
+        gapless = channel.values;
+        if (channel.isQuaternion) {
+            kernels::alignQuaternionSigns(gapless, width);
+        }
+        kernels::fillGaps(gapless, width, m_channelTimes);
+        if (channel.isQuaternion) {
+            kernels::normalizeQuaternions(gapless, width);
+        }
+        const std::vector<double>* source = &gapless;
+
+        if (!taps.empty()) {
+            kernels::filterRows(*source, width, taps, filtered);
+            if (channel.isQuaternion) {
+                kernels::normalizeQuaternions(filtered, width);
+            }
+            source = &filtered;
+        }
+
+        if (channel.isQuaternion) {
+            kernels::interpolateQuaternions(
+                *source, width, m_channelTimes, m_resampledTimes, channel.resampledValues);
+        }
+        else if (method == CUBIC) {
+            kernels::interpolateCubic(
+                *source, width, m_channelTimes, m_resampledTimes, channel.resampledValues);
+        }
+        else {
+            kernels::interpolateLinear(
+                *source, width, m_channelTimes, m_resampledTimes, channel.resampledValues);
+        }
+    }
+
+    m_resampledRate = targetRate;
+    return true;
+}
+
+void MVNXStreamReader::enforceQuaternionContinuity()
+{
+    for (auto& channel : m_channels) {
+        if (channel.isQuaternion) {
+            kernels::alignQuaternionSigns(channel.values, channel.labels.size());
+            kernels::alignQuaternionSigns(channel.resampledValues, channel.labels.size());
+        }
+    }
+    m_quaternionSignsAligned = true;
+}
+
 std::string MVNXStreamReader::getSingleDataTypeFromFrame(const std::string& label,
                                                          const Frame& frame,
                                                          const int& sampleSize,
@@ -543,8 +971,14 @@ void MVNXStreamReader::printFrame(std::stringstream& ss,
                 ss << getSingleDataTypeFromFrame("center_of_mass", frame, 3, sep);
                 break;
             case CONTACTS:
-                std::cerr << "TODO: Contacts are not yet supported. Ignoring for time being."
-                          << std::endl;
+            case CONTACTS_PACKED:
+            case LINK_ORIENTATION_MATRIX:
+            case LINK_ORIENTATION_RPY:
+            case SENSOR_ORIENTATION_MATRIX:
+            case SENSOR_ORIENTATION_RPY:
+            case POINT_POSITION:
+                // contacts and data computed from the frames are printed from the column store by
+                // printChannelFrames
                 break;
         }
     }
@@ -577,6 +1011,13 @@ void MVNXStreamReader::printCalibrationFile_LOG(const std::string& filePath, con
            << point.second.at(2) << std::endl;
     ss << std::endl;
 
+    // dictionary of the bits of the packed contacts
+    ss << "ContactPointList" << std::endl;
+    ss << "Bit" << sep << "Segment/PointName" << std::endl;
+    for (std::size_t id = 0; id < m_contactPoints.size(); ++id)
+        ss << id << sep << m_contactPoints.at(id) << std::endl;
+    ss << std::endl;
+
     std::vector<std::string> segmentNames = getSegmentNames();
     ss << "FrameType" << sep;
     ss << createSingleTypeLabels(m_xmlKeysMap.at("link_position"),
@@ -726,12 +1167,25 @@ std::string MVNXStreamReader::createSingleTypeLabels(const std::string& prefix,
                                                      const char& sep) const
 {
     std::stringstream out;
+    for (const auto& label : createSingleTypeLabelList(prefix, itemLabels, postfixes)) {
+        out << sep << label;
+    }
+    return out.str();
+}
+
+std::vector<std::string>
+MVNXStreamReader::createSingleTypeLabelList(const std::string& prefix,
+                                            const std::vector<std::string>& itemLabels,
+                                            const std::vector<std::string>& postfixes) const
+{
+    std::vector<std::string> labels;
+    labels.reserve(itemLabels.size() * postfixes.size());
     for (const auto& item : itemLabels) {
         for (const auto& postfix : postfixes) {
-            out << sep << prefix << ":" << item << "." << postfix;
+            labels.push_back(prefix + ":" + item + "." + postfix);
         };
     }
-    return out.str();
+    return labels;
 }
 
 void MVNXStreamReader::createLabels(std::stringstream& ss,
@@ -742,6 +1196,8 @@ void MVNXStreamReader::createLabels(std::stringstream& ss,
     const std::vector<std::string> segmentNames = getSegmentNames();
     const std::vector<std::string> sensorNames = getSensorNames();
     const std::vector<std::string> jointNames = getJointNames();
+    const std::vector<std::string> rotationMatrixPostfixes{
+        "R11", "R12", "R13", "R21", "R22", "R23", "R31", "R32", "R33"};
 
     ss << "index" << sep << "msTime" << sep << "xSensTime";
 
@@ -856,8 +1312,42 @@ void MVNXStreamReader::createLabels(std::stringstream& ss,
                                              sep);
                 break;
             case CONTACTS:
-                std::cerr << "TODO: Contacts not yet supported. Ignoring contacs for time being."
-                          << std::endl;
+                for (const auto& id : getActiveContactPoints()) {
+                    ss << sep << m_xmlKeysMap.at("contact") << ":" << m_contactPoints.at(id);
+                }
+                break;
+            case CONTACTS_PACKED:
+                ss << sep << m_xmlKeysMap.at("contacts");
+                break;
+            case POINT_POSITION:
+                ss << createSingleTypeLabels(m_xmlKeysMap.at("point"),
+                                             m_segmentPointNames,
+                                             std::vector<std::string>{"X", "Y", "Z"},
+                                             sep);
+                break;
+            case LINK_ORIENTATION_MATRIX:
+                ss << createSingleTypeLabels(m_xmlKeysMap.at("link_orientation"),
+                                             segmentNames,
+                                             rotationMatrixPostfixes,
+                                             sep);
+                break;
+            case LINK_ORIENTATION_RPY:
+                ss << createSingleTypeLabels(m_xmlKeysMap.at("link_orientation"),
+                                             segmentNames,
+                                             std::vector<std::string>{"Roll", "Pitch", "Yaw"},
+                                             sep);
+                break;
+            case SENSOR_ORIENTATION_MATRIX:
+                ss << createSingleTypeLabels(m_xmlKeysMap.at("sensor_orientation"),
+                                             sensorNames,
+                                             rotationMatrixPostfixes,
+                                             sep);
+                break;
+            case SENSOR_ORIENTATION_RPY:
+                ss << createSingleTypeLabels(m_xmlKeysMap.at("sensor_orientation"),
+                                             sensorNames,
+                                             std::vector<std::string>{"Roll", "Pitch", "Yaw"},
+                                             sep);
                 break;
         }
     }
@@ -871,6 +1361,24 @@ void MVNXStreamReader::printDataFile(const std::string& filePath,
     std::stringstream ss;
     createLabels(ss, dataList, sep);
 
+    // contacts, converted orientations, resampled and sign-aligned data are available only in the
+    // column store, otherwise the text of the frames is printed as it is
+    const bool needsChannelStore =
+        std::any_of(dataList.begin(), dataList.end(), [](const OutputDataType& dataType) {
+            return dataType == LINK_ORIENTATION_MATRIX || dataType == LINK_ORIENTATION_RPY
+                   || dataType == SENSOR_ORIENTATION_MATRIX || dataType == SENSOR_ORIENTATION_RPY
+                   || dataType == CONTACTS || dataType == CONTACTS_PACKED
+                   || dataType == POINT_POSITION;
+        });
+
+    if (needsChannelStore || m_resampledRate > 0 || m_quaternionSignsAligned) {
+        printChannelFrames(ss, dataList, sep);
+        std::ofstream myFile(filePath);
+        myFile << ss.rdbuf();
+        myFile.close();
+        return;
+    }
+
     for (unsigned long i = 0; i < m_parsedFrames.size(); ++i) {
         if (m_parsedFrames.at(i)->properties.type == "normal") {
             ss << m_parsedFrames.at(i)->properties.index << sep
@@ -884,3 +1392,188 @@ void MVNXStreamReader::printDataFile(const std::string& filePath,
     myFile << ss.rdbuf();
     myFile.close();
 }
+
+void MVNXStreamReader::printChannelFrames(
+    std::stringstream& ss,
+    const std::vector<MVNXStreamReader::OutputDataType>& dataList,
+    const char& sep) const
+{
+    const bool resampled = m_resampledRate > 0;
+    const unsigned long rowCount = resampled ? m_resampledTimes.size() : m_channelFrameCount;
+
+    // rows of the stored contacts to print: the last frame before each resampled time
+    std::vector<std::size_t> contactRows(rowCount);
+    for (std::size_t i = 0, row = 0; i < rowCount; ++i) {
+        if (resampled) {
+            while (row + 1 < m_channelTimes.size()
+                   && m_channelTimes.at(row + 1) <= m_resampledTimes.at(i)) {
+                ++row;
+            }
+        }
+        else {
+            row = i;
+        }
+        contactRows[i] = row;
+    }
+
+    struct OutputColumns
+    {
+        const double* values;
+        std::size_t width;
+        bool packedContacts;
+    };
+
+    // collect the buffers to print, converting the quaternions of the whole store at once
+    std::vector<std::vector<double>> convertedValues;
+    convertedValues.reserve(dataList.size());
+    std::vector<OutputColumns> columns;
+    for (const auto& dataType : dataList) {
+        if (dataType == CONTACTS) {
+            const std::vector<std::size_t> activePoints = getActiveContactPoints();
+            convertedValues.emplace_back();
+            kernels::unpackBitsetRows(m_contactBits,
+                                      m_contactWordCount,
+                                      contactRows,
+                                      activePoints,
+                                      convertedValues.back());
+            columns.push_back({convertedValues.back().data(), activePoints.size(), false});
+            continue;
+        }
+        if (dataType == CONTACTS_PACKED) {
+            columns.push_back({nullptr, 1, true});
+            continue;
+        }
+        if (dataType == POINT_POSITION) {
+            const DataChannel* positions = findChannel(LINK_POSITION);
+            const DataChannel* orientations = findChannel(LINK_ORIENTATION);
+            if (!positions || !orientations) {
+                std::cerr << "Point positions require link positions and orientations" << std::endl;
+                continue;
+            }
+            convertedValues.emplace_back();
+            kernels::transformSegmentPoints(
+                resampled ? positions->resampledValues : positions->values,
+                resampled ? orientations->resampledValues : orientations->values,
+                m_segmentPoints,
+                convertedValues.back());
+            columns.push_back(
+                {convertedValues.back().data(), 3 * m_segmentPointNames.size(), false});
+            continue;
+        }
+
+        const DataChannel* channel = findChannel(dataType);
+        if (!channel) {
+            continue;
+        }
+
+        const std::vector<double>& values = resampled ? channel->resampledValues : channel->values;
+        const std::size_t quaternionCount = channel->labels.size() / 4;
+        switch (dataType) {
+            case LINK_ORIENTATION_MATRIX:
+            case SENSOR_ORIENTATION_MATRIX:
+                convertedValues.emplace_back();
+                kernels::quaternionsToRotationMatrices(values, convertedValues.back());
+                columns.push_back({convertedValues.back().data(), 9 * quaternionCount, false});
+                break;
+            case LINK_ORIENTATION_RPY:
+            case SENSOR_ORIENTATION_RPY:
+                convertedValues.emplace_back();
+                kernels::quaternionsToRPY(values, convertedValues.back());
+                columns.push_back({convertedValues.back().data(), 3 * quaternionCount, false});
+                break;
+            default:
+                columns.push_back({values.data(), channel->labels.size(), false});
+                break;
+        }
+    }
+
+    // print the values with the decimals of the frames text, as the text itself is printed when
+    // the column store is not needed
+    const std::ios_base::fmtflags flags = ss.flags();
+    const std::streamsize precision = ss.precision();
+    if (m_channelDecimals >= 0) {
+        ss << std::fixed << std::setprecision(m_channelDecimals);
+    }
+    else {
+        ss << std::setprecision(std::numeric_limits<double>::digits10);
+    }
+    for (unsigned long i = 0; i < rowCount; ++i) {
+        if (resampled) {
+            const double time = m_resampledTimes.at(i);
+            const auto elapsed =
+                static_cast<unsigned long long>(std::llround(time - m_channelTimes.front()));
+            ss << i << sep << m_channelClockTimes.front() + elapsed << sep << std::llround(time);
+        }
+        else {
+            ss << m_channelIndices.at(i) << sep << m_channelClockTimes.at(i) << sep
+               << std::llround(m_channelTimes.at(i));
+        }
+
+        for (const auto& column : columns) {
+            if (column.packedContacts) {
+                // most significant word first, so that the column reads as a single number
+                const std::uint64_t* words =
+                    m_contactBits.data() + contactRows[i] * m_contactWordCount;
+                ss << sep << "0x" << std::hex << std::setfill('0');
+                for (std::size_t k = m_contactWordCount; k > 0; --k) {
+                    ss << std::setw(16) << words[k - 1];
+                }
+                ss << std::dec << std::setfill(' ');
+                continue;
+            }
+
+            const double* row = column.values + i * column.width;
+            // gaps are left empty as in the original data
+            for (std::size_t k = 0; k < column.width; ++k) {
+                if (std::isfinite(row[k])) {
+                    ss << sep << row[k];
+                }
+                else {
+                    ss << sep << " ";
+                }
+            }
+        }
+        ss << std::endl;
+    }
+    ss.flags(flags);
+    ss.precision(precision);
+}
+
+const std::vector<ChannelStatistics> MVNXStreamReader::getChannelStatistics() const
+{
+    std::vector<ChannelStatistics> statistics;
+    for (const auto& channel : m_channels) {
+        for (std::size_t column = 0; column < channel.labels.size(); ++column) {
+            ChannelStatistics columnStatistics;
+            columnStatistics.label = channel.labels.at(column);
+            columnStatistics.sampleCount = channel.statistics.validCount(column);
+            columnStatistics.min = channel.statistics.min(column);
+            columnStatistics.max = channel.statistics.max(column);
+            columnStatistics.mean = channel.statistics.mean(column);
+            columnStatistics.standardDeviation = channel.statistics.standardDeviation(column);
+            columnStatistics.nanCount = channel.statistics.nonFiniteCount(column);
+            columnStatistics.gapCount = channel.gapCount;
+            statistics.push_back(columnStatistics);
+        }
+    }
+    return statistics;
+}
+
+void MVNXStreamReader::printStatisticsFile(const std::string& filePath, const char& sep) const
+{
+    std::stringstream ss;
+    ss << std::setprecision(std::numeric_limits<double>::digits10);
+    ss << "channel" << sep << "frames" << sep << "samples" << sep << "min" << sep << "max" << sep
+       << "mean" << sep << "std" << sep << "nanCount" << sep << "gapCount" << std::endl;
+
+    for (const auto& statistics : getChannelStatistics()) {
+        ss << statistics.label << sep << m_channelFrameCount << sep << statistics.sampleCount
+           << sep << statistics.min << sep << statistics.max << sep << statistics.mean << sep
+           << statistics.standardDeviation << sep << statistics.nanCount << sep
+           << statistics.gapCount << std::endl;
+    }
+
+    std::ofstream myFile(filePath);
+    myFile << ss.rdbuf();
+    myFile.close();
+}
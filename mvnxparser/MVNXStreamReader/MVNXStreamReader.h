@@ -9,11 +9,13 @@
 #ifndef MVNX_STREAM_READER_H
 #define MVNX_STREAM_READER_H
 
+#include "MVNXDataKernels.h"
 #include "XMLDataContainers.h"
 #include "XMLStreamReader.h"
 
 #include <QXmlStreamReader>
 #include <array>
+#include <cstdint>
 #include <unordered_map>
 
 namespace xmlstream {
@@ -49,6 +51,35 @@ struct Frame
     std::vector<std::string> contacts;
 };
 
+// Numeric content of a frame element (e.g. <position>) for all the "normal" frames.
+// Values are stored row-major: one row per frame, one column per label.
+struct DataChannel
+{
+    // key of the element in the MVNX keys map (e.g. "link_orientation") and its xml name
+    std::string key;
+    std::string name;
+    std::vector<std::string> labels;
+    bool isQuaternion = false;
+    std::vector<double> values;
+    // number of frames in which the element was missing or malformed (their row is NaN)
+    unsigned long gapCount = 0;
+    xmlstream::mvnx::kernels::RunningStatistics statistics;
+    // rows at the times of the resampled store, empty if the data have not been resampled
+    std::vector<double> resampledValues;
+};
+
+struct ChannelStatistics
+{
+    std::string label;
+    unsigned long sampleCount = 0;
+    double min = 0;
+    double max = 0;
+    double mean = 0;
+    double standardDeviation = 0;
+    unsigned long nanCount = 0;
+    unsigned long gapCount = 0;
+};
+
 class xmlstream::mvnx::MVNXStreamReader : public xmlstream::XMLStreamReader
 {
 private:
@@ -64,6 +95,31 @@ private:
 
     std::vector<std::shared_ptr<Frame>> m_parsedFrames;
 
+    // Column store of the "normal" frames, filled while parsing the frames
+    std::vector<DataChannel> m_channels;
+    unsigned long m_channelFrameCount = 0;
+    std::vector<double> m_channelTimes; // ms from the start of the recording
+    std::vector<int> m_channelIndices;
+    std::vector<unsigned long long> m_channelClockTimes;
+    bool m_quaternionSignsAligned = false;
+    // decimal digits of the values in the frames text, -1 if unknown
+    int m_channelDecimals = -1;
+
+    // Contact points ("segment:point", from the header plus those found only in the frames) and
+    // one bitset of m_contactWordCount words per frame of the column store
+    std::vector<std::string> m_contactPoints;
+    std::unordered_map<std::string, std::size_t> m_contactPointIds;
+    std::vector<std::uint64_t> m_contactBits;
+    std::size_t m_contactWordCount = 1;
+
+    // Offsets of the points of the segments, sorted by segment, and their names
+    xmlstream::mvnx::kernels::SegmentPoints m_segmentPoints;
+    std::vector<std::string> m_segmentPointNames;
+
+    // Times of the resampled store and its rate, 0 if the data have not been resampled
+    std::vector<double> m_resampledTimes;
+    double m_resampledRate = 0;
+
     std::map<std::string, std::string> m_xmlKeysMap{};
 
 public:
@@ -83,7 +139,22 @@ public:
         JOINT_ANGLE,
         JOINT_ANGLE_XZY,
         CENTER_OF_MASS,
-        CONTACTS // TODO: not yet supported
+        CONTACTS, // one 0/1 column for each point that is in contact at least once
+        // orientations converted from the quaternions of the column store
+        LINK_ORIENTATION_MATRIX,
+        LINK_ORIENTATION_RPY,
+        SENSOR_ORIENTATION_MATRIX,
+        SENSOR_ORIENTATION_RPY,
+        // contacts bitset of the frame as a hexadecimal number (bit i is contact point i)
+        CONTACTS_PACKED,
+        // world position of the points of the segments, from the link position and orientation
+        POINT_POSITION
+    };
+
+    enum InterpolationMethod
+    {
+        LINEAR,
+        CUBIC
     };
 
     MVNXStreamReader();
@@ -130,6 +201,28 @@ public:
                        const std::vector<MVNXStreamReader::OutputDataType>& dataList,
                        const char& sep = '\t') const;
 
+    // Frame rate of the recording in Hz, as specified in the subject element
+    double getFrameRate() const;
+
+    // Resample the column store at targetRate Hz. When decimating, the data are low-pass filtered
+    // first. Quaternions are always interpolated with slerp. Missing or malformed values are
+    // interpolated from the closest valid frames before filtering. Once resampled,
+    // printDataFile() prints the resampled data.
+    bool resample(const double targetRate, const InterpolationMethod method = LINEAR);
+
+    // Contact points dictionary and per-frame bitsets of the "normal" frames
+    const std::vector<std::string>& getContactPoints() const { return m_contactPoints; }
+    const std::vector<std::uint64_t>& getContactBits() const { return m_contactBits; }
+    std::size_t getContactWordCount() const { return m_contactWordCount; }
+
+    // Flip the sign of the stored quaternions so that consecutive frames lie in the same
+    // hemisphere. Once called, printDataFile() prints the quaternions from the column store.
+    void enforceQuaternionContinuity();
+
+    // Statistics of every channel column, computed while parsing
+    const std::vector<ChannelStatistics> getChannelStatistics() const;
+    void printStatisticsFile(const std::string& filePath, const char& sep = '\t') const;
+
 private:
     void handleStartElement(const xmlstream::ElementName& name,
                             const QXmlStreamAttributes& attributes);
@@ -149,6 +242,16 @@ private:
                     const char& sep = '\t') const;
     void parseFrames();
 
+    void initializeChannels(const unsigned long expectedFrameCount);
+    void appendFrameToChannels(const Frame& frame);
+    std::size_t getContactPointId(const std::string& contactPoint);
+    std::vector<std::size_t> getActiveContactPoints() const;
+    void initializeSegmentPoints();
+    const DataChannel* findChannel(const MVNXStreamReader::OutputDataType& dataType) const;
+    void printChannelFrames(std::stringstream& ss,
+                            const std::vector<MVNXStreamReader::OutputDataType>& dataList,
+                            const char& sep = '\t') const;
+
     void printFrame(std::stringstream& out,
                     const Frame& frame,
                     const std::vector<MVNXStreamReader::OutputDataType>& dataList,
@@ -161,6 +264,10 @@ private:
                                        const std::vector<std::string>& itemLabels,
                                        const std::vector<std::string>& postfixes,
                                        const char& sep = '\t') const;
+    std::vector<std::string>
+    createSingleTypeLabelList(const std::string& prefix,
+                              const std::vector<std::string>& itemLabels,
+                              const std::vector<std::string>& postfixes) const;
 
     std::string getSingleDataTypeFromFrame(const std::string& label,
                                            const Frame& frame,
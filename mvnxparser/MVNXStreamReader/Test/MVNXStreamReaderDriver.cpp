@@ -6,10 +6,18 @@
  * GNU Lesser General Public License v2.1 or any later version.
  */
 
+#include "MVNXDataKernels.h"
 #include "MVNXStreamReader.h"
 #include "XMLDataContainers.h"
+#include <algorithm>
+#include <clocale>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <sstream>
+#include <string>
 #include <vector>
 
 using namespace xmlstream;
@@ -21,6 +29,667 @@ bool file_exist(const char* fileName)
     return infile.good();
 }
 
+std::string read_file(const std::string& fileName)
+{
+    std::ifstream infile(fileName);
+    std::stringstream buffer;
+    buffer << infile.rdbuf();
+    return buffer.str();
+}
+
+// Parse a copy of the document whose first "normal" frame has a nan position value, and check
+// that the statistics count it apart from the valid samples and from the missing elements, and
+// that it does not reach the resampled data.
+bool check_nan_value(const char* fileName, const char* schemaName)
+{
+    std::string document = read_file(fileName);
+
+    unsigned long normalFrames = 0;
+    for (std::size_t pos = document.find("type=\"normal\""); pos != std::string::npos;
+         pos = document.find("type=\"normal\"", pos + 1)) {
+        ++normalFrames;
+    }
+
+    const std::size_t frame = document.find("type=\"normal\"");
+    const std::size_t position = document.find("<position>", frame);
+    if (frame == std::string::npos || position == std::string::npos) {
+        std::cerr << "The document has no normal frame with positions" << std::endl;
+        return false;
+    }
+    const std::size_t valueBegin = position + std::string("<position>").size();
+    document.replace(valueBegin, document.find(' ', valueBegin) - valueBegin, "nan");
+
+    const std::string copyName = std::string(fileName) + ".statistics.mvnx";
+    std::ofstream outfile(copyName);
+    outfile << document;
+    outfile.close();
+
+    // all the elements are needed to fill the frames, no configuration is set
+    MVNXStreamReader mvnx;
+    if (!mvnx.setDocument(copyName)) {
+        std::cerr << "Failed to load the document with the nan value!" << std::endl;
+        return false;
+    }
+    mvnx.setSchema(schemaName);
+    mvnx.parse();
+    std::remove(copyName.c_str());
+
+    const std::vector<ChannelStatistics> statistics = mvnx.getChannelStatistics();
+    if (statistics.empty()) {
+        std::cerr << "No channel statistics" << std::endl;
+        return false;
+    }
+
+    bool ok = true;
+    for (std::size_t i = 0; i < statistics.size(); ++i) {
+        const ChannelStatistics& column = statistics[i];
+        // the first column of the statistics is the x position of the first segment
+        const unsigned long expectedNans = i == 0 ? 1 : 0;
+        if (column.nanCount != expectedNans
+            || column.sampleCount + column.nanCount + column.gapCount != normalFrames) {
+            std::cerr << column.label << ": " << column.sampleCount << " samples, "
+                      << column.nanCount << " nan, " << column.gapCount << " gaps in "
+                      << normalFrames << " frames" << std::endl;
+            ok = false;
+        }
+        if (column.sampleCount > 0
+            && !(column.min <= column.mean && column.mean <= column.max
+                 && column.standardDeviation >= 0)) {
+            std::cerr << column.label << ": inconsistent min " << column.min << ", max "
+                      << column.max << ", mean " << column.mean << ", std "
+                      << column.standardDeviation << std::endl;
+            ok = false;
+        }
+    }
+
+    // decimate, so that the low-pass filter runs over the nan row
+    const std::string dataName = copyName + ".txt";
+    if (!mvnx.resample(mvnx.getFrameRate() / 2)) {
+        return false;
+    }
+    mvnx.printDataFile(dataName,
+                       {MVNXStreamReader::LINK_POSITION, MVNXStreamReader::LINK_ORIENTATION});
+    // non-finite values are printed as blank fields
+    std::ifstream data(dataName);
+    std::string line;
+    std::getline(data, line);
+    while (std::getline(data, line)) {
+        if (line.find("\t ") != std::string::npos) {
+            std::cerr << "Non-finite resampled value in row " << line.substr(0, line.find('\t'))
+                      << std::endl;
+            ok = false;
+        }
+    }
+    data.close();
+    std::remove(dataName.c_str());
+    return ok;
+}
+
+// The data printed from the column store have the format of the frames text
+bool check_column_format(const char* fileName)
+{
+    MVNXStreamReader mvnx;
+    if (!mvnx.setDocument(fileName)) {
+        return false;
+    }
+    mvnx.parse();
+
+    const std::vector<MVNXStreamReader::OutputDataType> dataList{
+        MVNXStreamReader::LINK_POSITION, MVNXStreamReader::LINK_VELOCITY};
+    const std::string dataName = std::string(fileName) + ".format.txt";
+    mvnx.printDataFile(dataName, dataList);
+    const std::string text = read_file(dataName);
+    // the sign alignment makes printDataFile() use the column store, positions are not changed
+    mvnx.enforceQuaternionContinuity();
+    mvnx.printDataFile(dataName, dataList);
+    const std::string columns = read_file(dataName);
+    std::remove(dataName.c_str());
+
+    if (text.empty() || text != columns) {
+        std::cerr << "The column store is printed differently from the frames text" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// The frame values are parsed with a decimal point under a comma-decimal LC_NUMERIC as well, as
+// set by the QCoreApplication of MVNXParser: the statistics match the ones of the C locale
+bool check_numeric_locale(const char* fileName)
+{
+    MVNXStreamReader classic;
+    if (!classic.setDocument(fileName)) {
+        return false;
+    }
+    classic.parse();
+
+    const std::string previous = std::setlocale(LC_NUMERIC, nullptr);
+    const char* locale = nullptr;
+    for (const char* name : {"de_DE.UTF-8", "de_DE.utf8", "de_DE", "it_IT.UTF-8", "it_IT.utf8",
+                             "fr_FR.UTF-8", "fr_FR.utf8"}) {
+        if (std::setlocale(LC_NUMERIC, name) && *std::localeconv()->decimal_point == ',') {
+            locale = name;
+            break;
+        }
+    }
+    if (!locale) {
+        std::setlocale(LC_NUMERIC, previous.c_str());
+        std::cout << "No comma-decimal locale installed, the LC_NUMERIC check is skipped"
+                  << std::endl;
+        return true;
+    }
+
+    MVNXStreamReader localized;
+    const bool loaded = localized.setDocument(fileName);
+    if (loaded) {
+        localized.parse();
+    }
+    std::setlocale(LC_NUMERIC, previous.c_str());
+    if (!loaded) {
+        return false;
+    }
+
+    const std::vector<ChannelStatistics> expected = classic.getChannelStatistics();
+    const std::vector<ChannelStatistics> statistics = localized.getChannelStatistics();
+    if (expected.empty() || statistics.size() != expected.size()) {
+        std::cerr << "Different channels under LC_NUMERIC " << locale << std::endl;
+        return false;
+    }
+    for (std::size_t i = 0; i < statistics.size(); ++i) {
+        if (statistics[i].sampleCount != expected[i].sampleCount
+            || statistics[i].gapCount != expected[i].gapCount
+            || statistics[i].mean != expected[i].mean) {
+            std::cerr << statistics[i].label << ": " << statistics[i].sampleCount
+                      << " samples and " << statistics[i].gapCount << " gaps under LC_NUMERIC "
+                      << locale << ", " << expected[i].sampleCount << " and "
+                      << expected[i].gapCount << " in the C locale" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool near(const double a, const double b)
+{
+    return std::fabs(a - b) < 1e-12;
+}
+
+// Gaps are interpolated in time and quaternion signs are aligned across them
+bool check_gap_kernels()
+{
+    const double nan = std::nan("");
+    const std::vector<double> times{0, 1, 3, 4, 5};
+    std::vector<double> values{nan, 1, 2, nan, 6, 7, 8, nan, nan, nan};
+    kernels::fillGaps(values, 2, times);
+    const std::vector<double> filled{2, 1, 2, 3, 6, 7, 8, 7, 8, 7};
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (!near(values[i], filled[i])) {
+            std::cerr << "fillGaps: value " << i << " is " << values[i] << " instead of "
+                      << filled[i] << std::endl;
+            return false;
+        }
+    }
+
+    // q, missing, -q, -q: the last two are flipped against the first one
+    std::vector<double> quaternions{0.6, 0.8, 0, 0, nan, nan, nan, nan, -0.6, -0.8, 0, 0, -0.6,
+                                    -0.8, 0, 0};
+    kernels::alignQuaternionSigns(quaternions, 4);
+    for (std::size_t row : {2, 3}) {
+        if (!near(quaternions[4 * row], 0.6) || !near(quaternions[4 * row + 1], 0.8)) {
+            std::cerr << "alignQuaternionSigns: row " << row << " not aligned" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool nearValues(const std::vector<double>& values, const std::vector<double>& expected)
+{
+    if (values.size() != expected.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        if (std::fabs(values[i] - expected[i]) > 1e-12) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Product of two (w, x, y, z) quaternions
+std::vector<double> multiplyQuaternions(const std::vector<double>& a, const std::vector<double>& b)
+{
+    return {a[0] * b[0] - a[1] * b[1] - a[2] * b[2] - a[3] * b[3],
+            a[0] * b[1] + a[1] * b[0] + a[2] * b[3] - a[3] * b[2],
+            a[0] * b[2] - a[1] * b[3] + a[2] * b[0] + a[3] * b[1],
+            a[0] * b[3] + a[1] * b[2] - a[2] * b[1] + a[3] * b[0]};
+}
+
+// Rotation matrices and ZYX angles of known quaternions, which do not depend on the sign or the
+// norm of the quaternion
+bool check_orientation_kernels()
+{
+    const double pi = std::acos(-1.0);
+    const double c = std::cos(pi / 4);
+    struct Orientation
+    {
+        const char* name;
+        std::vector<double> quaternion;
+        std::vector<double> matrix;
+        std::vector<double> rpy;
+    };
+    const std::vector<Orientation> orientations{
+        {"identity", {1, 0, 0, 0}, {1, 0, 0, 0, 1, 0, 0, 0, 1}, {0, 0, 0}},
+        {"90 degrees about x", {c, c, 0, 0}, {1, 0, 0, 0, 0, -1, 0, 1, 0}, {pi / 2, 0, 0}},
+        // the pitch of the ZYX angles is singular at 90 degrees: roll and yaw are not checked
+        {"90 degrees about y", {c, 0, c, 0}, {0, 0, 1, 0, 1, 0, -1, 0, 0}, {}},
+        {"90 degrees about z", {c, 0, 0, c}, {0, -1, 0, 1, 0, 0, 0, 0, 1}, {0, 0, pi / 2}}};
+
+    for (const auto& orientation : orientations) {
+        const std::vector<double>& q = orientation.quaternion;
+        // q, -q and 2q are the same rotation
+        const std::vector<double> quaternions{q[0],
+                                              q[1],
+                                              q[2],
+                                              q[3],
+                                              -q[0],
+                                              -q[1],
+                                              -q[2],
+                                              -q[3],
+                                              2 * q[0],
+                                              2 * q[1],
+                                              2 * q[2],
+                                              2 * q[3]};
+        std::vector<double> matrices;
+        std::vector<double> angles;
+        kernels::quaternionsToRotationMatrices(quaternions, matrices);
+        kernels::quaternionsToRPY(quaternions, angles);
+        for (std::size_t i = 0; i < 3; ++i) {
+            const std::vector<double> matrix(matrices.begin() + 9 * i,
+                                             matrices.begin() + 9 * i + 9);
+            const std::vector<double> rpy(angles.begin() + 3 * i, angles.begin() + 3 * i + 3);
+            const bool rpyOk = orientation.rpy.empty() ? near(rpy[1], pi / 2)
+                                                       : nearValues(rpy, orientation.rpy);
+            if (!nearValues(matrix, orientation.matrix) || !rpyOk) {
+                std::cerr << "Wrong rotation matrix or RPY angles of the quaternion " << i
+                          << " of " << orientation.name << std::endl;
+                return false;
+            }
+        }
+    }
+
+    // R = Rz(yaw) Ry(pitch) Rx(roll) gives back roll, pitch and yaw
+    const double roll = 0.1;
+    const double pitch = -0.2;
+    const double yaw = 2.5;
+    const std::vector<double> q = multiplyQuaternions(
+        multiplyQuaternions({std::cos(yaw / 2), 0, 0, std::sin(yaw / 2)},
+                            {std::cos(pitch / 2), 0, std::sin(pitch / 2), 0}),
+        {std::cos(roll / 2), std::sin(roll / 2), 0, 0});
+    std::vector<double> angles;
+    kernels::quaternionsToRPY(q, angles);
+    if (!nearValues(angles, {roll, pitch, yaw})) {
+        std::cerr << "Wrong RPY angles: " << angles[0] << " " << angles[1] << " " << angles[2]
+                  << " instead of " << roll << " " << pitch << " " << yaw << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Flip the sign of the first quaternion of a text of values
+void negateFirstQuaternion(std::string& text)
+{
+    std::size_t begin = 0;
+    for (int k = 0; k < 4; ++k) {
+        begin = text.find_first_not_of(' ', begin);
+        if (text[begin] == '-') {
+            text.erase(begin, 1);
+        }
+        else {
+            text.insert(begin, "-");
+        }
+        begin = text.find(' ', begin);
+    }
+}
+
+// Parse a copy of the document where the orientation of the first segment alternates between q
+// and -q (q, -q, q, -q): after enforceQuaternionContinuity() the orientations printed are the ones
+// of the original document
+bool check_quaternion_continuity(const char* fileName)
+{
+    const std::vector<MVNXStreamReader::OutputDataType> dataList{
+        MVNXStreamReader::LINK_ORIENTATION};
+    const std::string dataName = std::string(fileName) + ".continuity.txt";
+
+    MVNXStreamReader original;
+    if (!original.setDocument(fileName)) {
+        return false;
+    }
+    original.parse();
+    original.printDataFile(dataName, dataList);
+    const std::string expected = read_file(dataName);
+
+    std::string document = read_file(fileName);
+    std::size_t frame = document.find("type=\"normal\"");
+    for (unsigned long index = 0; frame != std::string::npos;
+         frame = document.find("type=\"normal\"", frame + 1), ++index) {
+        if (index % 2 == 0) {
+            continue;
+        }
+        const std::size_t begin = document.find("<orientation>", frame) + 13;
+        const std::size_t end = document.find("</orientation>", begin);
+        std::string values = document.substr(begin, end - begin);
+        negateFirstQuaternion(values);
+        document.replace(begin, end - begin, values);
+    }
+    const std::string copyName = std::string(fileName) + ".continuity.mvnx";
+    std::ofstream outfile(copyName);
+    outfile << document;
+    outfile.close();
+
+    MVNXStreamReader flipped;
+    const bool loaded = flipped.setDocument(copyName);
+    if (loaded) {
+        flipped.parse();
+        flipped.printDataFile(dataName, dataList);
+    }
+    const std::string unaligned = read_file(dataName);
+    if (loaded) {
+        flipped.enforceQuaternionContinuity();
+        flipped.printDataFile(dataName, dataList);
+    }
+    const std::string aligned = read_file(dataName);
+    std::remove(copyName.c_str());
+    std::remove(dataName.c_str());
+
+    if (!loaded || expected.empty() || unaligned == expected || aligned != expected) {
+        std::cerr << "enforceQuaternionContinuity does not undo the q/-q flips" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Split a line of a data file on tabs
+std::vector<std::string> split_fields(const std::string& line)
+{
+    std::vector<std::string> fields;
+    std::istringstream stream(line);
+    std::string field;
+    while (std::getline(stream, field, '\t')) {
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+// p + R(q) offset, rotating the offset with the quaternion (w, x, y, z) as v + 2w (u x v) +
+// 2u x (u x v), independently of the rotation matrices of the kernels
+std::vector<double> transformPoint(const double* p, const double* q, const std::vector<double>& v)
+{
+    const double norm = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    const double w = q[0] / norm;
+    const double u[3] = {q[1] / norm, q[2] / norm, q[3] / norm};
+    const double uv[3] = {u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2],
+                          u[0] * v[1] - u[1] * v[0]};
+    const double uuv[3] = {u[1] * uv[2] - u[2] * uv[1], u[2] * uv[0] - u[0] * uv[2],
+                           u[0] * uv[1] - u[1] * uv[0]};
+    std::vector<double> result(3);
+    for (int k = 0; k < 3; ++k) {
+        result[k] = p[k] + v[k] + 2 * w * uv[k] + 2 * uuv[k];
+    }
+    return result;
+}
+
+// World positions of the segment points on a recording of 1000 rows, split in three blocks that
+// are not a multiple of each other, against the hand-computed p + R(q) offset, and against a
+// single thread
+bool check_point_transform()
+{
+    const std::size_t rowCount = 1000;
+    const std::size_t segmentCount = 2;
+    kernels::SegmentPoints points;
+    // two points on the first segment, one on the second
+    points.begins = {0, 2, 3};
+    points.x = {0.1, 0, -0.3};
+    points.y = {0, 0.2, 0.05};
+    points.z = {0, -0.1, 0.4};
+
+    std::vector<double> positions(rowCount * 3 * segmentCount);
+    std::vector<double> orientations(rowCount * 4 * segmentCount);
+    for (std::size_t row = 0; row < rowCount; ++row) {
+        for (std::size_t s = 0; s < segmentCount; ++s) {
+            double* p = positions.data() + (row * segmentCount + s) * 3;
+            double* q = orientations.data() + (row * segmentCount + s) * 4;
+            const double t = 0.01 * row + s;
+            p[0] = std::sin(t);
+            p[1] = 0.5 * t;
+            p[2] = 1.0 - s;
+            // a rotation about a changing axis, not normalised on odd rows
+            const double scale = row % 2 == 0 ? 1.0 : 1.5;
+            q[0] = scale * std::cos(t);
+            q[1] = scale * std::sin(t) * 0.6;
+            q[2] = scale * std::sin(t) * 0.8 * std::cos(3 * t);
+            q[3] = scale * std::sin(t) * 0.8 * std::sin(3 * t);
+        }
+    }
+
+    std::vector<double> output;
+    std::vector<double> singleThread;
+    kernels::transformSegmentPoints(positions, orientations, points, output, 3);
+    kernels::transformSegmentPoints(positions, orientations, points, singleThread, 1);
+    if (output.size() != rowCount * 3 * points.x.size() || output != singleThread) {
+        std::cerr << "transformSegmentPoints: the blocks differ from a single thread" << std::endl;
+        return false;
+    }
+    for (std::size_t row = 0; row < rowCount; ++row) {
+        for (std::size_t s = 0; s < segmentCount; ++s) {
+            for (std::size_t i = points.begins[s]; i < points.begins[s + 1]; ++i) {
+                const std::vector<double> expected =
+                    transformPoint(positions.data() + (row * segmentCount + s) * 3,
+                                   orientations.data() + (row * segmentCount + s) * 4,
+                                   {points.x[i], points.y[i], points.z[i]});
+                const double* point = output.data() + (row * points.x.size() + i) * 3;
+                if (!nearValues(std::vector<double>(point, point + 3), expected)) {
+                    std::cerr << "transformSegmentPoints: wrong point " << i << " of row " << row
+                              << std::endl;
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+// The POINT_POSITION export of the fixture matches p + R(q) offset computed from the positions
+// and orientations printed in the same rows, up to their decimals
+bool check_point_export(const char* fileName)
+{
+    MVNXStreamReader mvnx;
+    if (!mvnx.setDocument(fileName)) {
+        return false;
+    }
+    mvnx.parse();
+    const std::vector<std::string> segments = mvnx.getSegmentNames();
+    const std::vector<Point> points = mvnx.getPoints();
+
+    const std::string dataName = std::string(fileName) + ".points.txt";
+    mvnx.printDataFile(dataName,
+                       {MVNXStreamReader::LINK_POSITION,
+                        MVNXStreamReader::LINK_ORIENTATION,
+                        MVNXStreamReader::POINT_POSITION});
+    std::ifstream data(dataName);
+    std::string line;
+    std::getline(data, line);
+    const std::vector<std::string> labels = split_fields(line);
+    const std::size_t orientationBegin = 3 + 3 * segments.size();
+
+    bool ok = !points.empty();
+    unsigned long rowCount = 0;
+    while (ok && std::getline(data, line)) {
+        const std::vector<std::string> fields = split_fields(line);
+        ok = fields.size() == labels.size();
+        for (std::size_t i = 0; ok && i < points.size(); ++i) {
+            const std::string& name = points[i].first;
+            const std::size_t s =
+                std::find(segments.begin(), segments.end(), name.substr(0, name.find(':')))
+                - segments.begin();
+            const std::size_t column =
+                std::find(labels.begin(), labels.end(), "point:" + name + ".X") - labels.begin();
+            if (s == segments.size() || column + 3 > labels.size()) {
+                std::cerr << "No printed position of the point " << name << std::endl;
+                ok = false;
+                break;
+            }
+            double p[3];
+            double q[4];
+            for (int k = 0; k < 3; ++k) {
+                p[k] = std::stod(fields[3 + 3 * s + k]);
+            }
+            for (int k = 0; k < 4; ++k) {
+                q[k] = std::stod(fields[orientationBegin + 4 * s + k]);
+            }
+            const std::vector<double> expected = transformPoint(p, q, points[i].second);
+            for (int k = 0; k < 3; ++k) {
+                if (std::fabs(std::stod(fields[column + k]) - expected[k]) > 1e-5) {
+                    std::cerr << "Wrong printed position of the point " << name << " in row "
+                              << rowCount << std::endl;
+                    ok = false;
+                    break;
+                }
+            }
+        }
+        ++rowCount;
+    }
+    data.close();
+    std::remove(dataName.c_str());
+    return ok && rowCount > 0;
+}
+
+// Parse a copy of the document with contacts injected in its frames. The dictionary starts with
+// the points of the header (more than 64, two words per frame), and the pairs found only in the
+// frames are appended to it, adding a third word to the bitsets already stored. The bitsets, the
+// 0/1 columns of CONTACTS and the hexadecimal numbers of CONTACTS_PACKED are checked.
+bool check_contacts(const char* fileName)
+{
+    MVNXStreamReader original;
+    if (!original.setDocument(fileName)) {
+        return false;
+    }
+    original.parse();
+    const std::vector<Point> points = original.getPoints();
+    // the packed bitsets below are the ones of the 125 points of Meri-020
+    if (points.size() != 125) {
+        std::cerr << "The document has " << points.size() << " points instead of 125" << std::endl;
+        return false;
+    }
+
+    auto contact = [](const std::string& name) {
+        const std::size_t colon = name.find(':');
+        return "<contact segment=\"" + name.substr(0, colon) + "\" point=\""
+               + name.substr(colon + 1) + "\"/>";
+    };
+    const std::size_t last = points.size() - 1;
+    // ids of the points only in the frames: the last one needs a third word
+    const std::size_t first = points.size();
+    const std::size_t added = 128 - first + 1;
+    std::vector<std::string> frameContacts(4);
+    frameContacts[0] = contact(points[0].first) + contact(points[64].first)
+                       + contact(points[last].first);
+    frameContacts[1] = contact(points[0].first);
+    for (std::size_t i = 0; i < added; ++i) {
+        frameContacts[1] += contact("LeftHand:pContact" + std::to_string(i));
+    }
+    frameContacts[3] = contact(points[64].first) + contact("LeftHand:pContact"
+                                                           + std::to_string(added - 1));
+
+    std::string document = read_file(fileName);
+    std::size_t frame = document.find("type=\"normal\"");
+    for (std::size_t index = 0; frame != std::string::npos && index < frameContacts.size();
+         ++index, frame = document.find("type=\"normal\"", frame + 1)) {
+        if (!frameContacts[index].empty()) {
+            document.insert(document.find("</frame>", frame),
+                            "<contacts>" + frameContacts[index] + "</contacts>");
+        }
+    }
+    const std::string copyName = std::string(fileName) + ".contacts.mvnx";
+    std::ofstream outfile(copyName);
+    outfile << document;
+    outfile.close();
+
+    MVNXStreamReader mvnx;
+    const bool loaded = mvnx.setDocument(copyName);
+    if (loaded) {
+        mvnx.parse();
+    }
+    std::remove(copyName.c_str());
+    if (!loaded) {
+        return false;
+    }
+
+    // expected bitsets, least significant word first
+    const std::size_t wordCount = 3;
+    std::vector<std::uint64_t> expected(4 * wordCount, 0);
+    auto set = [&](const std::size_t row, const std::size_t id) {
+        expected[row * wordCount + id / 64] |= std::uint64_t{1} << (id % 64);
+    };
+    for (const std::size_t id : {std::size_t{0}, std::size_t{64}, last}) {
+        set(0, id);
+    }
+    set(1, 0);
+    for (std::size_t i = 0; i < added; ++i) {
+        set(1, first + i);
+    }
+    set(3, 64);
+    set(3, 128);
+
+    const std::vector<std::string>& dictionary = mvnx.getContactPoints();
+    if (dictionary.size() != 129 || dictionary[0] != points[0].first
+        || dictionary[last] != points[last].first || dictionary[first] != "LeftHand:pContact0"
+        || dictionary[128] != "LeftHand:pContact" + std::to_string(added - 1)) {
+        std::cerr << "Wrong contact points dictionary of " << dictionary.size() << " points"
+                  << std::endl;
+        return false;
+    }
+    if (mvnx.getContactWordCount() != wordCount || mvnx.getContactBits() != expected) {
+        std::cerr << "Wrong contact bitsets of " << mvnx.getContactWordCount() << " words"
+                  << std::endl;
+        return false;
+    }
+
+    const std::string dataName = copyName + ".txt";
+    mvnx.printDataFile(dataName, {MVNXStreamReader::CONTACTS, MVNXStreamReader::CONTACTS_PACKED});
+    std::ifstream data(dataName);
+    std::string line;
+    std::getline(data, line);
+    const std::vector<std::string> labels = split_fields(line);
+    // the points in contact at least once
+    const std::vector<std::size_t> active{0, 64, last, first, first + 1, first + 2, 128};
+    bool ok = labels.size() == 3 + active.size() + 1;
+    for (std::size_t k = 0; ok && k < active.size(); ++k) {
+        ok = labels[3 + k] == "contact:" + dictionary[active[k]];
+    }
+    if (!ok) {
+        std::cerr << "Wrong contact labels: " << line << std::endl;
+    }
+    const std::vector<std::string> packed{"0x000000000000000010000000000000010000000000000001",
+                                          "0x0000000000000001e0000000000000000000000000000001",
+                                          "0x000000000000000000000000000000000000000000000000",
+                                          "0x000000000000000100000000000000010000000000000000"};
+    for (std::size_t row = 0; ok && row < packed.size(); ++row) {
+        std::getline(data, line);
+        const std::vector<std::string> fields = split_fields(line);
+        ok = fields.size() == labels.size() && fields.back() == packed[row];
+        for (std::size_t k = 0; ok && k < active.size(); ++k) {
+            const std::uint64_t word = expected[row * wordCount + active[k] / 64];
+            ok = std::stod(fields[3 + k]) == static_cast<double>((word >> (active[k] % 64)) & 1);
+        }
+        if (!ok) {
+            std::cerr << "Wrong contacts printed in row " << row << ": " << line << std::endl;
+        }
+    }
+    data.close();
+    std::remove(dataName.c_str());
+    return ok;
+}
+
 int main(int argc, char* argv[])
 {
     if (argc != 3) {
@@ -132,6 +801,19 @@ int main(int argc, char* argv[])
     for (const auto& comment : comments) {
         std::cout << comment->getText() << std::endl;
     }
+    std::cout << std::endl;
+
+    std::cout << "Check the statistics, the resampling and the printing of the frame data:"
+              << std::endl;
+    if (!check_nan_value(argv[1], argv[2]) || !check_gap_kernels()
+        || !check_column_format(argv[1]) || !check_numeric_locale(argv[1])
+        || !check_orientation_kernels() || !check_quaternion_continuity(argv[1])
+        || !check_contacts(argv[1]) || !check_point_transform()
+        || !check_point_export(argv[1])) {
+        std::cerr << "Check failed" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "OK" << std::endl;
 
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef XSENSMVNFRAMEHISTORY_H
+#define XSENSMVNFRAMEHISTORY_H
+
+#include "XsensMVNFrameLayout.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace xsens {
+    class XsensMVNFrameHistory;
+} // namespace xsens
+
+// Bounded history of the last frames, each stored as a flat buffer described by
+// XsensMVNFrameLayout. When full, the oldest frame is overwritten. Storage is allocated by reset()
+// only. Not thread safe: the owner serialises push() and the queries.
+class xsens::XsensMVNFrameHistory
+{
+    std::vector<double> m_frames;
+    std::size_t m_frameSize;
+    std::size_t m_capacity;
+    // slot of the oldest frame and number of stored frames
+    std::size_t m_first;
+    std::size_t m_count;
+
+    double frameNumberAt(const std::size_t index) const
+    {
+        return frameAt(index)[XsensMVNFrameLayout::FrameNumberOffset];
+    }
+
+    double timeAt(const std::size_t index) const
+    {
+        return frameAt(index)[XsensMVNFrameLayout::TimeOffset];
+    }
+
+public:
+    XsensMVNFrameHistory()
+        : m_frameSize(0)
+        , m_capacity(0)
+        , m_first(0)
+        , m_count(0)
+    {}
+
+    void reset(const std::size_t frameSize, const std::size_t capacity)
+    {
+        m_frames.assign(frameSize * capacity, 0.0);
+        m_frameSize = frameSize;
+        m_capacity = capacity;
+        clear();
+    }
+
+    void clear()
+    {
+        m_first = 0;
+        m_count = 0;
+    }
+
+    std::size_t capacity() const { return m_capacity; }
+    std::size_t size() const { return m_count; }
+    std::size_t frameSize() const { return m_frameSize; }
+
+    // Frame at index, from 0 (the oldest) to size() - 1 (the newest)
+    const double* frameAt(const std::size_t index) const
+    {
+        return m_frames.data() + ((m_first + index) % m_capacity) * m_frameSize;
+    }
+
+    void push(const double* frame)
+    {
+        if (m_capacity == 0) {
+            return;
+        }
+        std::size_t slot;
+        if (m_count < m_capacity) {
+            slot = (m_first + m_count) % m_capacity;
+            ++m_count;
+        }
+        else {
+            slot = m_first;
+            m_first = (m_first + 1) % m_capacity;
+        }
+        std::copy(frame, frame + m_frameSize, m_frames.begin() + slot * m_frameSize);
+    }
+
+    // Copies the frames newer than lastFrameNumber, oldest first, one after the other in output
+    // and returns their number. output is resized to fit them (it allocates only if it grows).
+    // If the newest frame is older than lastFrameNumber the frame numbering restarted, and the
+    // whole history is returned.
+    std::size_t copyFramesSince(const int lastFrameNumber, std::vector<double>& output) const
+    {
+        std::size_t first = m_count;
+        if (m_count > 0 && frameNumberAt(m_count - 1) < lastFrameNumber) {
+            first = 0;
+        }
+        else {
+            while (first > 0 && frameNumberAt(first - 1) > lastFrameNumber) {
+                --first;
+            }
+        }
+
+        const std::size_t frameCount = m_count - first;
+        output.resize(frameCount * m_frameSize);
+        for (std::size_t i = 0; i < frameCount; ++i) {
+            const double* frame = frameAt(first + i);
+            std::copy(frame, frame + m_frameSize, output.begin() + i * m_frameSize);
+        }
+        return frameCount;
+    }
+
+    // Finds the frames around time, for frames pushed in time order: before is the newest frame
+    // not newer than time and after the following one, or before itself if it is the newest.
+    // Returns false if the history is empty or time is older than the oldest frame.
+    bool findFramesAround(const double time, const double*& before, const double*& after) const
+    {
+        if (m_count == 0 || time < timeAt(0)) {
+            return false;
+        }
+        // first frame newer than time
+        std::size_t low = 1;
+        std::size_t high = m_count;
+        while (low < high) {
+            const std::size_t middle = low + (high - low) / 2;
+            if (timeAt(middle) > time) {
+                high = middle;
+            }
+            else {
+                low = middle + 1;
+            }
+        }
+        before = frameAt(low - 1);
+        after = low < m_count ? frameAt(low) : before;
+        return true;
+    }
+};
+
+#endif // XSENSMVNFRAMEHISTORY_H
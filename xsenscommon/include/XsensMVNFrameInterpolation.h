@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef XSENSMVNFRAMEINTERPOLATION_H
+#define XSENSMVNFRAMEINTERPOLATION_H
+
+#include "XsensMVNFrameHistory.h"
+#include "XsensMVNPublishedFrame.h"
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// Interpolation of the segments between two frames of a history of published segments frames
+// (see XsensMVNPublishedFrame), as done by the remote for IFrameHistoryProvider. Vector is
+// yarp::sig::Vector in the remote: any vector with size(), resize(n, value) and operator[] works.
+namespace xsens {
+
+    // Block of one segment in the data of the published segments frames, as FrameBulkLayout of
+    // IFrameProviderBulk: pose (x, y, z, qw, qx, qy, qz), velocity (linear, angular) and
+    // acceleration (linear, angular)
+    enum SegmentBlockLayout
+    {
+        SegmentBlockPoseOffset = 0,
+        SegmentBlockVelocityOffset = 7,
+        SegmentBlockAccelerationOffset = 13,
+        SegmentBlockStride = 19
+    };
+
+    // Interpolation of the unit quaternions q0 and q1 (w, x, y, z) at weight, along the shortest
+    // arc
+    inline void slerp(const double* q0, const double* q1, const double weight, double* result)
+    {
+        double cosine = q0[0] * q1[0] + q0[1] * q1[1] + q0[2] * q1[2] + q0[3] * q1[3];
+        // q and -q are the same rotation
+        const double sign = cosine < 0 ? -1.0 : 1.0;
+        cosine *= sign;
+        double weight0 = 1.0 - weight;
+        double weight1 = weight;
+        // close quaternions: linear interpolation (normalised below) avoids dividing by ~0
+        if (cosine < 0.9995) {
+            const double angle = std::acos(cosine);
+            const double sine = std::sin(angle);
+            weight0 = std::sin(weight0 * angle) / sine;
+            weight1 = std::sin(weight1 * angle) / sine;
+        }
+        weight1 *= sign;
+        double norm = 0;
+        for (int k = 0; k < 4; ++k) {
+            result[k] = weight0 * q0[k] + weight1 * q1[k];
+            norm += result[k] * result[k];
+        }
+        norm = std::sqrt(norm);
+        for (int k = 0; k < 4; ++k) {
+            result[k] /= norm;
+        }
+    }
+
+    // Sizes values as exactly count vectors of width values each. Nothing is allocated if the
+    // caller reuses vectors of the right sizes
+    template <typename Vector>
+    void resizeBlocks(const std::size_t count, const std::size_t width, std::vector<Vector>& values)
+    {
+        if (values.size() != count) {
+            values.resize(count);
+        }
+        for (Vector& value : values) {
+            if (value.size() != width) {
+                value.resize(width, 0.0);
+            }
+        }
+    }
+
+    // Interpolate count segments blocks at weight between before and after, in one pass over the
+    // contiguous blocks: positions, velocities and accelerations linearly, orientations by slerp
+    template <typename Vector>
+    void interpolateSegments(const double* before,
+                             const double* after,
+                             const std::size_t count,
+                             const double weight,
+                             std::vector<Vector>& poses,
+                             std::vector<Vector>& velocities,
+                             std::vector<Vector>& accelerations)
+    {
+        resizeBlocks(count, 7, poses);
+        resizeBlocks(count, 6, velocities);
+        resizeBlocks(count, 6, accelerations);
+        double orientation[4];
+        for (std::size_t seg = 0; seg < count;
+             ++seg, before += SegmentBlockStride, after += SegmentBlockStride) {
+            Vector& pose = poses[seg];
+            Vector& velocity = velocities[seg];
+            Vector& acceleration = accelerations[seg];
+            const double* pose0 = before + SegmentBlockPoseOffset;
+            const double* pose1 = after + SegmentBlockPoseOffset;
+            for (int k = 0; k < 3; ++k) {
+                pose[k] = pose0[k] + weight * (pose1[k] - pose0[k]);
+            }
+            slerp(pose0 + 3, pose1 + 3, weight, orientation);
+            for (int k = 0; k < 4; ++k) {
+                pose[3 + k] = orientation[k];
+            }
+
+            const double* velocity0 = before + SegmentBlockVelocityOffset;
+            const double* velocity1 = after + SegmentBlockVelocityOffset;
+            const double* acceleration0 = before + SegmentBlockAccelerationOffset;
+            const double* acceleration1 = after + SegmentBlockAccelerationOffset;
+            for (int k = 0; k < 6; ++k) {
+                velocity[k] = velocity0[k] + weight * (velocity1[k] - velocity0[k]);
+                acceleration[k] = acceleration0[k] + weight * (acceleration1[k] - acceleration0[k]);
+            }
+        }
+    }
+
+    // Outcome of interpolateFrameAt
+    enum FrameAtResult
+    {
+        FrameAtFound = 0,
+        // the history is empty or does not reach back to the time
+        FrameAtBeforeHistory,
+        // the time is after the newest frame by more than the hold time
+        FrameAtAfterHistory
+    };
+
+    // Segments at time, from a history of published segments frames pushed in time order: the
+    // frames around time are interpolated. No extrapolation is done: after the newest frame the
+    // newest frame is held, but only up to holdTime seconds, as later it is no longer the
+    // current one. A negative holdTime holds it for one frame period, the interval between the
+    // two newest frames (not at all if the history has a single frame)
+    template <typename Vector>
+    FrameAtResult interpolateFrameAt(const XsensMVNFrameHistory& history,
+                                     const double time,
+                                     const double holdTime,
+                                     std::vector<Vector>& poses,
+                                     std::vector<Vector>& velocities,
+                                     std::vector<Vector>& accelerations)
+    {
+        const double* before = nullptr;
+        const double* after = nullptr;
+        if (!history.findFramesAround(time, before, after)) {
+            return FrameAtBeforeHistory;
+        }
+        const double time0 = before[XsensMVNPublishedFrame::StampTimeOffset];
+        const double time1 = after[XsensMVNPublishedFrame::StampTimeOffset];
+        if (before == after && time > time0) {
+            double hold = holdTime;
+            if (hold < 0) {
+                hold = 0;
+                if (history.size() > 1) {
+                    const double* previous = history.frameAt(history.size() - 2);
+                    hold = time0 - previous[XsensMVNPublishedFrame::StampTimeOffset];
+                }
+            }
+            if (time - time0 > hold) {
+                return FrameAtAfterHistory;
+            }
+        }
+        // after the newest frame before == after: hold it
+        const double weight = time1 > time0 ? (time - time0) / (time1 - time0) : 0.0;
+        const std::size_t count =
+            (history.frameSize() - XsensMVNPublishedFrame::DataOffset) / SegmentBlockStride;
+        interpolateSegments(before + XsensMVNPublishedFrame::DataOffset,
+                            after + XsensMVNPublishedFrame::DataOffset,
+                            count,
+                            weight,
+                            poses,
+                            velocities,
+                            accelerations);
+        return FrameAtFound;
+    }
+
+} // namespace xsens
+
+#endif // XSENSMVNFRAMEINTERPOLATION_H
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef XSENSMVNFRAMELAYOUT_H
+#define XSENSMVNFRAMELAYOUT_H
+
+#include <cstddef>
+
+namespace xsens {
+    class XsensMVNFrameLayout;
+} // namespace xsens
+
+// Layout of the flat buffer holding one frame of the driver:
+// [frame number, time | one block per channel, in the order of Channel]
+// Each block stores the values of all the segments (or sensors) contiguously, e.g. the segment
+// orientations block is [w0, x0, y0, z0, w1, x1, y1, z1, ...]. Quaternions are stored as
+// (w, x, y, z), all the other channels as (x, y, z).
+class xsens::XsensMVNFrameLayout
+{
+public:
+    enum Channel
+    {
+        SegmentPositions = 0,
+        SegmentOrientations,
+        SegmentLinearVelocities,
+        SegmentAngularVelocities,
+        SegmentLinearAccelerations,
+        SegmentAngularAccelerations,
+        SensorOrientations,
+        SensorAngularVelocities,
+        SensorLinearAccelerations,
+        SensorMagneticFields,
+        ChannelCount
+    };
+
+    enum HeaderOffset
+    {
+        FrameNumberOffset = 0,
+        TimeOffset = 1,
+        HeaderSize = 2
+    };
+
+    explicit XsensMVNFrameLayout(const unsigned segmentCount = 0, const unsigned sensorCount = 0)
+        : m_segmentCount(segmentCount)
+        , m_sensorCount(sensorCount)
+    {}
+
+    unsigned segmentCount() const { return m_segmentCount; }
+    unsigned sensorCount() const { return m_sensorCount; }
+
+    static bool isSegmentChannel(const Channel channel) { return channel < SensorOrientations; }
+
+    // Number of values stored for each segment (or sensor)
+    static std::size_t channelWidth(const Channel channel)
+    {
+        return channel == SegmentOrientations || channel == SensorOrientations ? 4 : 3;
+    }
+
+    std::size_t channelSize(const Channel channel) const
+    {
+        return channelWidth(channel) * (isSegmentChannel(channel) ? m_segmentCount : m_sensorCount);
+    }
+
+    std::size_t channelOffset(const Channel channel) const
+    {
+        std::size_t offset = HeaderSize;
+        for (int previous = 0; previous < channel; ++previous) {
+            offset += channelSize(static_cast<Channel>(previous));
+        }
+        return offset;
+    }
+
+    // Total number of values of a frame
+    std::size_t size() const { return channelOffset(ChannelCount); }
+
+private:
+    unsigned m_segmentCount;
+    unsigned m_sensorCount;
+};
+
+#endif // XSENSMVNFRAMELAYOUT_H
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef XSENSMVNFRAMESIGNAL_H
+#define XSENSMVNFRAMESIGNAL_H
+
+#include "XsensMVNPublishedFrame.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace xsens {
+    class XsensMVNFrameSignal;
+} // namespace xsens
+
+// Wakes the threads waiting for the next frame of an XsensMVNPublishedFrame (see IFrameNotifier).
+// The writer calls notify() after each frame it publishes. notify() takes m_mutex only to order
+// itself with the waiters (a waiter between its check and its wait would miss the notification):
+// it can wait for a waiter evaluating its predicate, a copy of the stamp, but never for a reader
+// of the data or for the decode
+class xsens::XsensMVNFrameSignal
+{
+    // only protects the waiters' check
+    std::mutex m_mutex;
+    std::condition_variable m_variable;
+    // incremented when a frame carries a status different from the previous one
+    std::atomic<unsigned> m_statusChanges;
+    // writer side
+    int m_lastStatus;
+
+public:
+    explicit XsensMVNFrameSignal(const int status)
+        : m_statusChanges(0)
+        , m_lastStatus(status)
+    {}
+
+    XsensMVNFrameSignal(const XsensMVNFrameSignal&) = delete;
+    XsensMVNFrameSignal& operator=(const XsensMVNFrameSignal&) = delete;
+
+    // Writer side, after a frame of the given status is published
+    void notify(const int status)
+    {
+        if (status != m_lastStatus) {
+            m_lastStatus = status;
+            ++m_statusChanges;
+        }
+        {
+            // a waiter checking the stamp has either seen the new frame or is already waiting
+            std::lock_guard<std::mutex> lock(m_mutex);
+        }
+        m_variable.notify_all();
+    }
+
+    // Block until a frame with a stamp other than (lastCount, lastTime) or with a different
+    // status is published in published, or timeout seconds elapsed
+    bool waitForNextFrame(const XsensMVNPublishedFrame& published,
+                          const double lastCount,
+                          const double lastTime,
+                          const double timeout)
+    {
+        const unsigned statusChanges = m_statusChanges;
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_variable.wait_for(
+            lock, std::chrono::duration<double>(timeout > 0 ? timeout : 0), [&]() {
+                bool newStamp = false;
+                published.read([&](const XsensMVNSeqLock& frame) {
+                    newStamp = frame.value(XsensMVNPublishedFrame::StampCountOffset) != lastCount
+                               || frame.value(XsensMVNPublishedFrame::StampTimeOffset) != lastTime;
+                });
+                return newStamp || m_statusChanges != statusChanges;
+            });
+    }
+};
+
+#endif // XSENSMVNFRAMESIGNAL_H
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef XSENSMVNPUBLISHEDFRAME_H
+#define XSENSMVNPUBLISHEDFRAME_H
+
+#include "XsensMVNSeqLock.h"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace xsens {
+    class XsensMVNPublishedFrame;
+} // namespace xsens
+
+// Last frame received from a stream, published by the thread that decodes it and read by any
+// number of threads without locks. A frame is a header (stamp and status) followed by the data.
+// The writer decodes each frame in a back buffer of its own and publishes it with a single
+// XsensMVNSeqLock write, so the readers never wait for the decode and the decode never waits for
+// the readers.
+// Single writer: resize(), beginWrite() and commitWrite() must all be called by the same thread
+// (or by threads ordered with it, e.g. before the writer thread starts). The data size changes
+// with resize(), which publishes a new XsensMVNSeqLock. A reader may still be copying from the
+// replaced one, so the writer frees it (at the next resize() or commitWrite()) only once it sees
+// no reader in flight: the readers count themselves in m_readers around each access.
+class xsens::XsensMVNPublishedFrame
+{
+public:
+    enum Layout
+    {
+        StampCountOffset = 0,
+        StampTimeOffset = 1,
+        StatusOffset = 2,
+        DataOffset = 3
+    };
+
+private:
+    std::atomic<XsensMVNSeqLock*> m_frame;
+    // readers between the load of m_frame and the end of their copy
+    mutable std::atomic<unsigned> m_readers;
+    // writer side: the published frame, the replaced ones not freed yet, and the frame being
+    // filled
+    std::unique_ptr<XsensMVNSeqLock> m_current;
+    std::vector<std::unique_ptr<XsensMVNSeqLock>> m_replaced;
+    std::vector<double> m_back;
+
+    void publish(const std::vector<double>& values)
+    {
+        std::unique_ptr<XsensMVNSeqLock> frame(new XsensMVNSeqLock(values.size()));
+        frame->write(values.data());
+        // sequentially consistent, as the load of m_readers in reclaim(): a reader counted after
+        // that load finds the new frame
+        m_frame.store(frame.get());
+        if (m_current) {
+            m_replaced.push_back(std::move(m_current));
+        }
+        m_current = std::move(frame);
+        reclaim();
+    }
+
+    // Frees the replaced frames if no reader is in flight. Any later reader loads the new frame
+    void reclaim()
+    {
+        if (!m_replaced.empty() && m_readers.load() == 0) {
+            m_replaced.clear();
+        }
+    }
+
+    // Counts a reader in m_readers for the lifetime of the guard
+    class ReaderGuard
+    {
+        std::atomic<unsigned>& m_readers;
+
+    public:
+        explicit ReaderGuard(std::atomic<unsigned>& readers)
+            : m_readers(readers)
+        {
+            m_readers.fetch_add(1);
+        }
+        ~ReaderGuard() { m_readers.fetch_sub(1, std::memory_order_release); }
+        ReaderGuard(const ReaderGuard&) = delete;
+        ReaderGuard& operator=(const ReaderGuard&) = delete;
+    };
+
+public:
+    explicit XsensMVNPublishedFrame(const int status)
+        : m_frame(nullptr)
+        , m_readers(0)
+        , m_back(DataOffset, 0.0)
+    {
+        m_back[StatusOffset] = status;
+        publish(m_back);
+    }
+
+    XsensMVNPublishedFrame(const XsensMVNPublishedFrame&) = delete;
+    XsensMVNPublishedFrame& operator=(const XsensMVNPublishedFrame&) = delete;
+
+    // Writer side. Publishes a frame of dataSize zeros, with the stamp and status of the last
+    // frame
+    void resize(const std::size_t dataSize)
+    {
+        std::vector<double> values(DataOffset + dataSize, 0.0);
+        m_current->read([&](const XsensMVNSeqLock& frame) {
+            for (std::size_t i = 0; i < DataOffset; ++i) {
+                values[i] = frame.value(i);
+            }
+        });
+        publish(values);
+    }
+
+    // Writer side. Returns the frame to fill, of DataOffset + writeDataSize() values. It still
+    // holds the last frame written, so that a frame carrying only the header can keep the data
+    double* beginWrite()
+    {
+        if (m_back.size() != m_current->size()) {
+            // resized: keep the header, reset the data
+            m_back.resize(DataOffset);
+            m_back.resize(m_current->size(), 0.0);
+        }
+        return m_back.data();
+    }
+
+    // Writer side. Number of data values of the frame returned by beginWrite()
+    std::size_t writeDataSize() const { return m_back.size() - DataOffset; }
+
+    // Writer side. Publishes the frame returned by beginWrite(), unless resize() was called in
+    // the meantime, and frees the replaced frames no reader uses anymore
+    void commitWrite()
+    {
+        if (m_back.size() == m_current->size()) {
+            m_current->write(m_back.data());
+        }
+        reclaim();
+    }
+
+    // Writer side. Number of replaced frames not freed yet
+    std::size_t replacedCount() const { return m_replaced.size(); }
+
+    // Reader side. Number of data values of the last published frame
+    std::size_t dataSize() const
+    {
+        ReaderGuard guard(m_readers);
+        return m_frame.load()->size() - DataOffset;
+    }
+
+    // Reader side. Calls copy(frame) on the last published frame, as XsensMVNSeqLock::read
+    template <typename CopyFunction>
+    void read(CopyFunction copy) const
+    {
+        ReaderGuard guard(m_readers);
+        m_frame.load()->read(copy);
+    }
+};
+
+#endif // XSENSMVNPUBLISHEDFRAME_H
@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef XSENSMVNREMOTEFRAMES_H
+#define XSENSMVNREMOTEFRAMES_H
+
+#include "XsensMVNFrameSignal.h"
+#include "XsensMVNPublishedFrame.h"
+
+#include <thrift/XsensSegmentsFrame.h>
+
+#include <yarp/dev/IFrameProvider.h>
+#include <yarp/dev/IFrameProviderBulk.h>
+#include <yarp/os/Stamp.h>
+#include <yarp/sig/Vector.h>
+
+#include <cstddef>
+#include <vector>
+
+// Decode of the segments frames streamed by the wrapper into an XsensMVNPublishedFrame, and the
+// copies of the getters, shared by XsensMVNRemote and XsensMVNRemoteLight. The published segments
+// data is laid out as in FrameBulkLayout.
+namespace xsens {
+    inline yarp::os::Stamp publishedFrameStamp(const XsensMVNSeqLock& frame)
+    {
+        return yarp::os::Stamp(
+            static_cast<int>(frame.value(XsensMVNPublishedFrame::StampCountOffset)),
+            frame.value(XsensMVNPublishedFrame::StampTimeOffset));
+    }
+
+    inline int publishedFrameStatus(const XsensMVNSeqLock& frame)
+    {
+        return static_cast<int>(frame.value(XsensMVNPublishedFrame::StatusOffset));
+    }
+
+    inline yarp::os::Stamp lastPublishedStamp(const XsensMVNPublishedFrame& published)
+    {
+        yarp::os::Stamp timestamp;
+        published.read(
+            [&](const XsensMVNSeqLock& frame) { timestamp = publishedFrameStamp(frame); });
+        return timestamp;
+    }
+
+    // Copy one quantity (width values at offset of each block of stride values) of a published
+    // frame into one vector per block. Called inside XsensMVNPublishedFrame::read, possibly more
+    // than once
+    inline void copyBlocks(const XsensMVNSeqLock& frame,
+                           const std::size_t stride,
+                           const std::size_t offset,
+                           const std::size_t width,
+                           std::vector<yarp::sig::Vector>& values)
+    {
+        const std::size_t count = (frame.size() - XsensMVNPublishedFrame::DataOffset) / stride;
+        if (values.size() != count) {
+            values.resize(count);
+        }
+        std::size_t block = XsensMVNPublishedFrame::DataOffset + offset;
+        for (std::size_t index = 0; index < count; ++index, block += stride) {
+            yarp::sig::Vector& value = values[index];
+            if (value.size() != width) {
+                value.resize(width);
+            }
+            for (std::size_t k = 0; k < width; ++k) {
+                value(k) = frame.value(block + k);
+            }
+        }
+    }
+
+    // Copy the stamp and the requested quantities (the non null vectors) of the last segments
+    // frame
+    inline yarp::experimental::dev::IFrameProviderStatus
+    copySegments(const XsensMVNPublishedFrame& segments,
+                 std::vector<yarp::sig::Vector>* poses,
+                 std::vector<yarp::sig::Vector>* velocities,
+                 std::vector<yarp::sig::Vector>* accelerations,
+                 yarp::os::Stamp& timestamp)
+    {
+        int status = yarp::experimental::dev::IFrameProviderStatusNoData;
+        segments.read([&](const XsensMVNSeqLock& frame) {
+            timestamp = publishedFrameStamp(frame);
+            status = publishedFrameStatus(frame);
+            const std::size_t stride = yarp::experimental::dev::FrameBulkStride;
+            if (poses)
+                copyBlocks(frame, stride, yarp::experimental::dev::FrameBulkPoseOffset, 7, *poses);
+            if (velocities)
+                copyBlocks(
+                    frame, stride, yarp::experimental::dev::FrameBulkVelocityOffset, 6, *velocities);
+            if (accelerations)
+                copyBlocks(frame,
+                           stride,
+                           yarp::experimental::dev::FrameBulkAccelerationOffset,
+                           6,
+                           *accelerations);
+        });
+        return static_cast<yarp::experimental::dev::IFrameProviderStatus>(status);
+    }
+
+    // Copy the data of a published frame in a buffer of the caller, if large enough
+    template <typename Status>
+    Status copyBulk(const XsensMVNPublishedFrame& published,
+                    double* buffer,
+                    const std::size_t bufferSize,
+                    yarp::os::Stamp& timestamp,
+                    const Status error)
+    {
+        Status status = error;
+        published.read([&](const XsensMVNSeqLock& frame) {
+            const std::size_t size = frame.size() - XsensMVNPublishedFrame::DataOffset;
+            if (bufferSize < size) {
+                status = error;
+                return;
+            }
+            for (std::size_t i = 0; i < size; ++i) {
+                buffer[i] = frame.value(XsensMVNPublishedFrame::DataOffset + i);
+            }
+            timestamp = publishedFrameStamp(frame);
+            status = static_cast<Status>(publishedFrameStatus(frame));
+        });
+        return status;
+    }
+
+    // Decode the segments frame, stamped with timestamp, in buffer: the back buffer of a
+    // published frame of segmentsCount blocks, holding the last frame decoded. A frame carrying
+    // only its status (republished without changes) keeps the last data, unless that data belongs
+    // to a previous model (currentModel false): it is then published as NoData, as the frames of
+    // a wrapper streaming no segment channel. Data that does not match segmentsCount is never
+    // published, and the frame is published as Error instead. Returns the status published
+    inline yarp::experimental::dev::IFrameProviderStatus
+    readSegments(const XsensSegmentsFrame& frame,
+                 const yarp::os::Stamp& timestamp,
+                 const bool currentModel,
+                 const unsigned segmentsCount,
+                 double* buffer)
+    {
+        buffer[XsensMVNPublishedFrame::StampCountOffset] = timestamp.getCount();
+        buffer[XsensMVNPublishedFrame::StampTimeOffset] = timestamp.getTime();
+
+        yarp::experimental::dev::IFrameProviderStatus status =
+            static_cast<yarp::experimental::dev::IFrameProviderStatus>(frame.status);
+        if (status == yarp::experimental::dev::IFrameProviderStatusOK) {
+            if (frame.channelsDisabled) {
+                status = yarp::experimental::dev::IFrameProviderStatusNoData;
+            }
+            else if (frame.segmentsData.empty()) {
+                if (!currentModel) {
+                    status = yarp::experimental::dev::IFrameProviderStatusNoData;
+                }
+            }
+            else if (frame.segmentsData.size() != segmentsCount) {
+                status = yarp::experimental::dev::IFrameProviderStatusError;
+            }
+        }
+        buffer[XsensMVNPublishedFrame::StatusOffset] = status;
+
+        // if status is != OK we should not have any data
+        if (status != yarp::experimental::dev::IFrameProviderStatusOK
+            || frame.segmentsData.empty())
+            return status;
+
+        double* block = buffer + XsensMVNPublishedFrame::DataOffset;
+        for (unsigned seg = 0; seg < segmentsCount;
+             ++seg, block += yarp::experimental::dev::FrameBulkStride) {
+            const Vector3& position = frame.segmentsData[seg].position;
+            const Quaternion& orientation = frame.segmentsData[seg].orientation;
+            const Vector3& linVelocity = frame.segmentsData[seg].velocity;
+            const Vector3& angVelocity = frame.segmentsData[seg].angularVelocity;
+            const Vector3& linAcceleration = frame.segmentsData[seg].acceleration;
+            const Vector3& angAcceleration = frame.segmentsData[seg].angularAcceleration;
+
+            double* newPose = block + yarp::experimental::dev::FrameBulkPoseOffset;
+            double* newVelocity = block + yarp::experimental::dev::FrameBulkVelocityOffset;
+            double* newAcceleration = block + yarp::experimental::dev::FrameBulkAccelerationOffset;
+
+            newPose[0] = position.x;
+            newPose[1] = position.y;
+            newPose[2] = position.z;
+            newPose[3] = orientation.w;
+            newPose[4] = orientation.imaginary.x;
+            newPose[5] = orientation.imaginary.y;
+            newPose[6] = orientation.imaginary.z;
+
+            newVelocity[0] = linVelocity.x;
+            newVelocity[1] = linVelocity.y;
+            newVelocity[2] = linVelocity.z;
+            newVelocity[3] = angVelocity.x;
+            newVelocity[4] = angVelocity.y;
+            newVelocity[5] = angVelocity.z;
+
+            newAcceleration[0] = linAcceleration.x;
+            newAcceleration[1] = linAcceleration.y;
+            newAcceleration[2] = linAcceleration.z;
+            newAcceleration[3] = angAcceleration.x;
+            newAcceleration[4] = angAcceleration.y;
+            newAcceleration[5] = angAcceleration.z;
+        }
+        return status;
+    }
+
+} // namespace xsens
+
+#endif // XSENSMVNREMOTEFRAMES_H
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef XSENSMVNSEQLOCK_H
+#define XSENSMVNSEQLOCK_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <thread>
+
+namespace xsens {
+    class XsensMVNSeqLock;
+} // namespace xsens
+
+// Latest-value publication of a flat buffer of doubles, for one writer and any number of readers.
+// The writer never waits for the readers. Readers never block the writer either: they copy the
+// buffer and retry if a write happened in the meantime, so they never see a torn buffer.
+// Values are stored as relaxed atomics so that the concurrent copies are well defined, in a buffer
+// aligned to a cache line so that a frame spans the minimum number of lines.
+class xsens::XsensMVNSeqLock
+{
+    static const std::size_t CacheLineSize = 64;
+
+    // odd while a write is in progress
+    std::atomic<unsigned long> m_sequence;
+    std::unique_ptr<unsigned char[]> m_storage;
+    std::atomic<double>* m_values;
+    std::size_t m_size;
+
+public:
+    explicit XsensMVNSeqLock(const std::size_t size = 0)
+        : m_sequence(0)
+        , m_values(nullptr)
+        , m_size(0)
+    {
+        resize(size);
+    }
+
+    XsensMVNSeqLock(const XsensMVNSeqLock&) = delete;
+    XsensMVNSeqLock& operator=(const XsensMVNSeqLock&) = delete;
+
+    // Not thread safe: call it only when there are no readers nor writers
+    void resize(const std::size_t size)
+    {
+        // std::atomic<double> is trivially destructible, the storage can be released as is
+        std::size_t bytes = size * sizeof(std::atomic<double>) + CacheLineSize;
+        m_storage.reset(new unsigned char[bytes]);
+        void* values = m_storage.get();
+        std::align(CacheLineSize, size * sizeof(std::atomic<double>), values, bytes);
+        m_values = static_cast<std::atomic<double>*>(values);
+        for (std::size_t i = 0; i < size; ++i) {
+            new (m_values + i) std::atomic<double>(0.0);
+        }
+        m_size = size;
+        m_sequence.store(0, std::memory_order_release);
+    }
+
+    std::size_t size() const { return m_size; }
+
+    // Writer side. Copies size() values
+    void write(const double* values)
+    {
+        const unsigned long sequence = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < m_size; ++i) {
+            m_values[i].store(values[i], std::memory_order_relaxed);
+        }
+        m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    // Reader side. Calls copy(*this) until it runs without a concurrent write. copy must read the
+    // values only through value() and must tolerate being called more than once.
+    template <typename CopyFunction>
+    void read(CopyFunction copy) const
+    {
+        while (true) {
+            const unsigned long before = m_sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+            copy(*this);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_sequence.load(std::memory_order_relaxed) == before) {
+                return;
+            }
+        }
+    }
+
+    // Reader side. Copies size() values into destination in a single pass
+    void read(double* destination) const
+    {
+        read([&](const XsensMVNSeqLock&) {
+            for (std::size_t i = 0; i < m_size; ++i) {
+                destination[i] = m_values[i].load(std::memory_order_relaxed);
+            }
+        });
+    }
+
+    double value(const std::size_t index) const
+    {
+        return m_values[index].load(std::memory_order_relaxed);
+    }
+};
+
+#endif // XSENSMVNSEQLOCK_H
@@ -12,8 +12,14 @@
 #include <yarp/os/Mutex.h>
 
 #include <yarp/dev/DeviceDriver.h>
+#include <yarp/dev/IFrameChannelSelection.h>
+#include <yarp/dev/IFrameDataProvider.h>
+#include <yarp/dev/IFrameListener.h>
+#include <yarp/dev/IFrameNotifier.h>
 #include <yarp/dev/IFrameProvider.h>
+#include <yarp/dev/IFrameProviderBulk.h>
 #include <yarp/dev/IIMUFrameProvider.h>
+#include <yarp/dev/IXsensMVNDiagnostics.h>
 #include <yarp/dev/IXsensMVNInterface.h>
 #include <yarp/dev/PreciselyTimed.h>
 
@@ -35,6 +41,13 @@ class yarp::dev::XsensMVN
     , public yarp::experimental::dev::IFrameProvider
     , public yarp::experimental::dev::IIMUFrameProvider
     , public yarp::experimental::dev::IXsensMVNInterface
+    , public yarp::experimental::dev::IXsensMVNDiagnostics
+    , public yarp::experimental::dev::IFrameNotifier
+    , public yarp::experimental::dev::IFrameChannelSelection
+    , public yarp::experimental::dev::IFrameProviderBulk
+    , public yarp::experimental::dev::IIMUFrameProviderBulk
+    , public yarp::experimental::dev::IFrameListenerRegistry
+    , public yarp::experimental::dev::IFrameDataProvider
 {
 private:
     // Prevent copy
@@ -60,6 +73,7 @@ public:
 
     // IFrameProvider interface
     virtual std::vector<yarp::experimental::dev::FrameReference> frames();
+    virtual unsigned frameListVersion();
 
     virtual yarp::experimental::dev::IFrameProviderStatus
     getFramePoses(std::vector<yarp::sig::Vector>& segmentPoses);
@@ -71,9 +85,15 @@ public:
     getFrameInformation(std::vector<yarp::sig::Vector>& segmentPoses,
                         std::vector<yarp::sig::Vector>& segmentVelocities,
                         std::vector<yarp::sig::Vector>& segmentAccelerations);
+    virtual yarp::experimental::dev::IFrameProviderStatus
+    getStampedFrameInformation(std::vector<yarp::sig::Vector>& segmentPoses,
+                               std::vector<yarp::sig::Vector>& segmentVelocities,
+                               std::vector<yarp::sig::Vector>& segmentAccelerations,
+                               yarp::os::Stamp& timestamp);
 
     // IIMUFrameProvider interface
     virtual std::vector<yarp::experimental::dev::IMUFrameReference> IMUFrames();
+    virtual unsigned IMUFrameListVersion();
 
     virtual yarp::experimental::dev::IIMUFrameProviderStatus
     getIMUFrameOrientations(std::vector<yarp::sig::Vector>& imuOrientations);
@@ -88,6 +108,12 @@ public:
                            std::vector<yarp::sig::Vector>& imuAngularVelocities,
                            std::vector<yarp::sig::Vector>& imuLinearAccelerations,
                            std::vector<yarp::sig::Vector>& imuMagneticFields);
+    virtual yarp::experimental::dev::IIMUFrameProviderStatus
+    getStampedIMUFrameInformation(std::vector<yarp::sig::Vector>& imuOrientations,
+                                  std::vector<yarp::sig::Vector>& imuAngularVelocities,
+                                  std::vector<yarp::sig::Vector>& imuLinearAccelerations,
+                                  std::vector<yarp::sig::Vector>& imuMagneticFields,
+                                  yarp::os::Stamp& timestamp);
 
     // IXsensMVNInterface interface
     virtual bool setBodyDimensions(const std::map<std::string, double>& dimensions);
@@ -99,6 +125,41 @@ public:
 
     virtual bool startAcquisition();
     virtual bool stopAcquisition();
+
+    // IFrameNotifier interface
+    virtual bool waitForNextFrame(const yarp::os::Stamp& lastStamp, const double timeout);
+
+    // IFrameListenerRegistry interface
+    virtual bool addFrameListener(yarp::experimental::dev::FrameListener& listener);
+    virtual bool removeFrameListener(yarp::experimental::dev::FrameListener& listener);
+
+    // IFrameChannelSelection interface
+    virtual bool setEnabledChannels(const unsigned channels);
+    virtual unsigned enabledChannels();
+
+    // IFrameProviderBulk interface
+    virtual std::size_t frameBulkSize();
+    virtual yarp::experimental::dev::IFrameProviderStatus
+    getFrameBulk(double* buffer, const std::size_t bufferSize, yarp::os::Stamp& timestamp);
+
+    // IIMUFrameProviderBulk interface
+    virtual std::size_t IMUFrameBulkSize();
+    virtual yarp::experimental::dev::IIMUFrameProviderStatus
+    getIMUFrameBulk(double* buffer, const std::size_t bufferSize, yarp::os::Stamp& timestamp);
+
+    // IXsensMVNDiagnostics interface
+    virtual std::vector<yarp::experimental::dev::LatencyStatistics> latencyStatistics();
+    virtual void resetLatencyStatistics();
+    virtual std::vector<yarp::experimental::dev::FrameContinuityStatistics>
+    frameContinuityStatistics();
+    virtual void resetFrameContinuityStatistics();
+
+    // IFrameDataProvider interface. The history keeps the frames of the last
+    // frame-history-duration seconds
+    virtual bool frameDataLayout(unsigned& segmentCount, unsigned& imuCount);
+    virtual yarp::experimental::dev::IFrameProviderStatus
+    getLastFrameData(yarp::os::Stamp& timestamp, std::vector<double>& frameData);
+    virtual std::size_t getFramesSince(const int lastFrameNumber, std::vector<double>& framesData);
 };
 
 #endif // YARP_XSENSMVN_H
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef XSENSMVNCHANNELCOPY_H
+#define XSENSMVNCHANNELCOPY_H
+
+#include "XsensMVNFrameLayout.h"
+#include "XsensMVNSeqLock.h"
+
+#include <cstddef>
+#include <vector>
+
+// Copies of the channels of a published frame (see XsensMVNFrameLayout) into one vector per
+// segment (or sensor), as returned by the getters of the frame providers. Vector is
+// yarp::sig::Vector in the driver: any vector with size(), resize(n, value) and operator[] works.
+namespace xsens {
+
+    // Sizes values as exactly count vectors of width values each, as the frame has count items.
+    // The values are written in place, so every inner vector must have exactly width values.
+    // Nothing is allocated if the caller reuses vectors of the right sizes
+    template <typename Vector>
+    void resizeChannelVectors(std::vector<Vector>& values,
+                              const unsigned count,
+                              const std::size_t width)
+    {
+        if (values.size() != count) {
+            values.resize(count);
+        }
+        for (Vector& value : values) {
+            if (value.size() != width) {
+                value.resize(width, 0.0);
+            }
+        }
+    }
+
+    // Copies channel into the vectors of output, from their value at position on. Call it inside
+    // XsensMVNSeqLock::read, on vectors sized by resizeChannelVectors
+    template <typename Vector>
+    void copyChannel(const XsensMVNSeqLock& frame,
+                     const XsensMVNFrameLayout& layout,
+                     const XsensMVNFrameLayout::Channel channel,
+                     std::vector<Vector>& output,
+                     const std::size_t position = 0)
+    {
+        const std::size_t width = XsensMVNFrameLayout::channelWidth(channel);
+        std::size_t offset = layout.channelOffset(channel);
+        const std::size_t end = offset + layout.channelSize(channel);
+        for (unsigned i = 0; offset < end; ++i, offset += width) {
+            Vector& values = output[i];
+            for (std::size_t k = 0; k < width; ++k) {
+                values[position + k] = frame.value(offset + k);
+            }
+        }
+    }
+
+} // namespace xsens
+
+#endif // XSENSMVNCHANNELCOPY_H
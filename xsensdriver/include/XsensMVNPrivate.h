@@ -11,15 +11,24 @@
 
 #include "XsensMVN.h"
 #include "XsensMVNCalibrator.h"
+#include "XsensMVNChannelCopy.h"
+#include "XsensMVNFrameLayout.h"
+#include "XsensMVNPublishedHistory.h"
+#include "XsensMVNRingBuffer.h"
+#include "XsensMVNSeqLock.h"
 
 #include <xsens/xmecallback.h>
 #include <xsens/xmelicense.h>
 #include <xsens/xmepose.h>
 #include <xsens/xmesensorsamplearray.h>
 
+#include <yarp/dev/IXsensMVNDiagnostics.h>
+#include <yarp/dev/ThreadScheduling.h>
 #include <yarp/os/Stamp.h>
 #include <yarp/sig/Vector.h>
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <mutex>
@@ -64,22 +73,58 @@ class yarp::dev::XsensMVN::XsensMVNPrivate
     {
         XmePose pose;
         XmeSensorSampleArray sensorsData;
+        // steady time of the SDK callback, to measure the processing latency
+        std::chrono::steady_clock::time_point callbackTime;
     };
 
+    // latency of the acquisition stages: SDK pose time to callback, callback to published frame
+    yarp::experimental::dev::LatencyHistogram m_poseToCallbackLatency;
+    yarp::experimental::dev::LatencyHistogram m_callbackToProcessedLatency;
+    // spacing of the processed frames against the spacing of their pose times
+    yarp::experimental::dev::LatencyHistogram m_processingJitter;
+    std::chrono::steady_clock::time_point m_lastProcessedTime;
+    double m_lastProcessedPoseTime;
+    int m_lastProcessedFrameNumber;
+
+    // Watchdog of the frame arrivals, run by the processor thread: while acquiring, the status
+    // becomes Timeout when no frame arrives for frame-timeout-periods frame periods
+    double m_configuredFramePeriod; // 0 to estimate it from the frames
+    double m_estimatedFramePeriod;
+    double m_timeoutPeriods;
+    // steady clock time (in clock ticks) by which the next frame must arrive
+    std::atomic<std::chrono::steady_clock::rep> m_frameDeadline;
+    // incremented at each change of m_driverStatus made by the acquisition
+    std::atomic<unsigned> m_statusChanges;
+    // continuity of the frame numbers processed, and frames dropped by m_frameBuffer
+    yarp::experimental::dev::FrameContinuityMonitor m_frameContinuity;
+
+    // Latest frame, published by the processor thread as a flat buffer (see XsensMVNFrameLayout)
+    // and read by the getters without locks.
+    // m_dataMutex only serialises the writers (the processor and the calibrator callback), which
+    // share m_lastFrameRead as the content of the last published frame.
     mutable std::mutex m_dataMutex;
-    // segment data
-    std::vector<yarp::sig::Vector> m_lastSegmentPosesRead;
-    std::vector<yarp::sig::Vector> m_lastSegmentVelocitiesRead;
-    std::vector<yarp::sig::Vector> m_lastSegmentAccelerationRead;
-
-    std::vector<yarp::sig::Vector> m_lastSensorOrientationsRead;
-    std::vector<yarp::sig::Vector> m_lastSensorVelocitiesRead;
-    std::vector<yarp::sig::Vector> m_lastSensorAccelerationsRead;
-    std::vector<yarp::sig::Vector> m_lastSensorMagneticFieldsRead;
-
-    yarp::os::Stamp m_lastTimestamp;
-
-    bool m_acquiring;
+    xsens::XsensMVNFrameLayout m_layout;
+    std::vector<double> m_lastFrameRead;
+    xsens::XsensMVNSeqLock m_publishedFrame;
+    // frame number of the calibration poses, each published with its own stamp
+    int m_calibrationPoseCount;
+
+    // Signalled after each frame is published. The mutex only protects the waiters' check
+    std::mutex m_newFrameMutex;
+    std::condition_variable m_newFrameVariable;
+    // Called after each frame is published and at each status change, on the same thread (the
+    // calibrator's for the calibration poses)
+    yarp::experimental::dev::FrameListenerList m_frameListeners;
+
+    // Frames processed in the last seconds, for the consumers slower than the suit. Pushed by the
+    // processor thread and copied by the readers without locks
+    xsens::XsensMVNPublishedHistory m_frameHistory;
+
+    std::atomic<bool> m_acquiring;
+    // mask of yarp::experimental::dev::FrameChannel, read by the processor and the getters
+    std::atomic<unsigned> m_enabledChannels;
+    // incremented whenever segmentNames() or sensorIDs() may change (never 0 once initialized)
+    std::atomic<unsigned> m_modelVersion;
 
     // std::vector<yarp::sig::Vector> m_lastIMUsRead;
     // yarp::os::Stamp m_lastIMUsTimestamp;
@@ -89,23 +134,35 @@ class yarp::dev::XsensMVN::XsensMVNPrivate
     bool m_stopProcessor;
     std::mutex m_processorGuard;
     std::condition_variable m_processorVariable;
-    FrameData m_lastFrameData;
-    bool m_lastFrameDataWritten;
+    // set while the processor checks the frame buffer and waits: the SDK thread notifies only
+    // then, and without m_processorGuard
+    std::atomic<bool> m_processorSleeping;
+    yarp::experimental::dev::ThreadScheduling m_processorScheduling;
+    // frames written by the SDK callback thread and read by the processor thread
+    xsens::XsensMVNRingBuffer<FrameData> m_frameBuffer;
+    unsigned long long m_countedOverruns;
+    unsigned long long m_reportedOverruns;
+    double m_lastOverrunReportTime;
 
     void processNewFrame();
+    void processFrame(const FrameData& frame);
+    void checkFrameDeadline();
+    // Call them without m_objectMutex locked: they call the frame listeners
+    void notifyNewFrame();
+    void notifyStatusChange();
+    void notifyFrameListeners();
+    void notifyModelChange();
+    // Call it with m_dataMutex locked
+    void publishCalibrationPose(const std::vector<yarp::sig::Vector>& newPose);
 
     // hardware scan
     bool m_hardwareFound;
 
-    yarp::experimental::dev::IFrameProviderStatus m_driverStatus;
+    std::atomic<yarp::experimental::dev::IFrameProviderStatus> m_driverStatus;
 
     XsensMVNPrivate(const XsensMVNPrivate&) = delete;
     XsensMVNPrivate& operator=(const XsensMVNPrivate&) = delete;
 
-    void resizeVectorToOuterAndInnerSize(std::vector<yarp::sig::Vector>& vector,
-                                         unsigned outerSize,
-                                         unsigned innerSize);
-
 public:
     XsensMVNPrivate();
     virtual ~XsensMVNPrivate();
@@ -116,6 +173,7 @@ public:
     // Information on the available hardware/model/etc
     std::vector<yarp::experimental::dev::FrameReference> segmentNames() const;
     std::vector<yarp::experimental::dev::IMUFrameReference> sensorIDs() const; // to be implemented
+    unsigned modelVersion() const;
 
     bool startAcquisition();
     bool stopAcquisition();
@@ -134,6 +192,37 @@ public:
                               std::vector<yarp::sig::Vector>& lastPoses,
                               std::vector<yarp::sig::Vector>& lastVelocities,
                               std::vector<yarp::sig::Vector>& lastAccelerations);
+    // Single channel (a yarp::experimental::dev::FrameChannel of the segments): only the requested
+    // quantity is copied, and nothing is allocated once the vectors have the right size
+    yarp::experimental::dev::IFrameProviderStatus
+    getLastSegmentChannel(const unsigned channel, std::vector<yarp::sig::Vector>& lastValues);
+
+    // Segments (or sensors) in a buffer laid out as in yarp::experimental::dev::FrameBulkLayout
+    // (or IMUFrameBulkLayout)
+    yarp::experimental::dev::IFrameProviderStatus
+    getLastSegmentBulk(double* buffer, const std::size_t bufferSize, yarp::os::Stamp& timestamp);
+    yarp::experimental::dev::IIMUFrameProviderStatus
+    getLastSensorBulk(double* buffer, const std::size_t bufferSize, yarp::os::Stamp& timestamp);
+
+    // Whole frame in a single copy
+    xsens::XsensMVNFrameLayout frameLayout() const;
+    yarp::experimental::dev::IFrameProviderStatus
+    getLastFrameData(yarp::os::Stamp& timestamp, std::vector<double>& frameData);
+    std::size_t getFramesSince(const int lastFrameNumber, std::vector<double>& framesData);
+    bool waitForNextFrame(const yarp::os::Stamp& lastStamp, const double timeout);
+    bool addFrameListener(yarp::experimental::dev::FrameListener& listener);
+    bool removeFrameListener(yarp::experimental::dev::FrameListener& listener);
+
+    // Channel selection
+    bool setEnabledChannels(const unsigned channels);
+    unsigned enabledChannels() const;
+
+    // Diagnostics
+    std::vector<yarp::experimental::dev::LatencyStatistics> latencyStatistics() const;
+    void resetLatencyStatistics();
+    std::vector<yarp::experimental::dev::FrameContinuityStatistics>
+    frameContinuityStatistics() const;
+    void resetFrameContinuityStatistics();
 
     yarp::experimental::dev::IIMUFrameProviderStatus
     getLastSensorReadTimestamp(yarp::os::Stamp& timestamp);
@@ -143,6 +232,9 @@ public:
                              std::vector<yarp::sig::Vector>& lastVelocities,
                              std::vector<yarp::sig::Vector>& lastAccelerations,
                              std::vector<yarp::sig::Vector>& lastMagneticFields);
+    // Single channel (a yarp::experimental::dev::FrameChannel of the IMUs), as above
+    yarp::experimental::dev::IIMUFrameProviderStatus
+    getLastSensorChannel(const unsigned channel, std::vector<yarp::sig::Vector>& lastValues);
 
     // callbacks
     virtual void onHardwareReady(XmeControl* dev);
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef XSENSMVNPUBLISHEDHISTORY_H
+#define XSENSMVNPUBLISHEDHISTORY_H
+
+#include "XsensMVNFrameLayout.h"
+#include "XsensMVNSeqLock.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace xsens {
+    class XsensMVNPublishedHistory;
+} // namespace xsens
+
+// Bounded history of the last frames (see XsensMVNFrameLayout), pushed by a single writer and
+// copied by any number of readers without locks, so that a slow reader never delays the writer.
+// Each slot is an XsensMVNSeqLock holding the push index of its frame followed by the frame: a
+// reader finding another index in a slot knows that the frame was overwritten while it was
+// copying the history. When full, the oldest frame is overwritten.
+class xsens::XsensMVNPublishedHistory
+{
+    std::vector<std::unique_ptr<XsensMVNSeqLock>> m_slots;
+    std::size_t m_frameSize;
+    // frames pushed since reset(), and push index of the oldest frame not cleared
+    std::atomic<std::uint64_t> m_pushCount;
+    std::atomic<std::uint64_t> m_firstValid;
+    // writer side: the push index followed by the frame being pushed
+    std::vector<double> m_slotValues;
+
+    const XsensMVNSeqLock& slotOf(const std::uint64_t index) const
+    {
+        return *m_slots[static_cast<std::size_t>(index % m_slots.size())];
+    }
+
+public:
+    XsensMVNPublishedHistory()
+        : m_frameSize(0)
+        , m_pushCount(0)
+        , m_firstValid(0)
+    {}
+
+    XsensMVNPublishedHistory(const XsensMVNPublishedHistory&) = delete;
+    XsensMVNPublishedHistory& operator=(const XsensMVNPublishedHistory&) = delete;
+
+    // Not thread safe: call it before the writer and the readers start
+    void reset(const std::size_t frameSize, const std::size_t capacity)
+    {
+        m_slots.clear();
+        for (std::size_t slot = 0; slot < capacity; ++slot) {
+            m_slots.emplace_back(new XsensMVNSeqLock(1 + frameSize));
+        }
+        m_frameSize = frameSize;
+        m_slotValues.assign(1 + frameSize, 0.0);
+        m_pushCount = 0;
+        m_firstValid = 0;
+    }
+
+    // Any thread. The frames pushed so far are not returned anymore
+    void clear() { m_firstValid.store(m_pushCount.load(std::memory_order_acquire)); }
+
+    std::size_t capacity() const { return m_slots.size(); }
+    std::size_t frameSize() const { return m_frameSize; }
+
+    // Writer side
+    void push(const double* frame)
+    {
+        if (m_slots.empty()) {
+            return;
+        }
+        const std::uint64_t index = m_pushCount.load(std::memory_order_relaxed);
+        // push indices are exact as doubles up to 2^53
+        m_slotValues[0] = static_cast<double>(index);
+        std::copy(frame, frame + m_frameSize, m_slotValues.begin() + 1);
+        m_slots[static_cast<std::size_t>(index % m_slots.size())]->write(m_slotValues.data());
+        m_pushCount.store(index + 1, std::memory_order_release);
+    }
+
+    // Reader side. Copies the frames newer than lastFrameNumber, oldest first, one after the other
+    // in output and returns their number. output is resized to fit them (it allocates only if it
+    // grows). If the newest frame is older than lastFrameNumber the frame numbering restarted,
+    // and the whole history is returned. Frames overwritten during the copy are left out together
+    // with the older ones, so that the frames returned are always consecutive.
+    std::size_t copyFramesSince(const int lastFrameNumber, std::vector<double>& output) const
+    {
+        const std::uint64_t end = m_pushCount.load(std::memory_order_acquire);
+        const std::uint64_t capacity = m_slots.size();
+        const std::uint64_t begin =
+            std::max(m_firstValid.load(std::memory_order_acquire),
+                     end > capacity ? end - capacity : static_cast<std::uint64_t>(0));
+
+        // walk back from the newest frame, reading only the frame numbers
+        std::uint64_t first = end;
+        bool restarted = false;
+        while (first > begin) {
+            bool overwritten = false;
+            double frameNumber = 0;
+            slotOf(first - 1).read([&](const XsensMVNSeqLock& slot) {
+                overwritten = slot.value(0) != static_cast<double>(first - 1);
+                frameNumber = slot.value(1 + XsensMVNFrameLayout::FrameNumberOffset);
+            });
+            if (overwritten) {
+                break;
+            }
+            if (first == end && frameNumber < lastFrameNumber) {
+                restarted = true;
+            }
+            if (!restarted && frameNumber <= lastFrameNumber) {
+                break;
+            }
+            --first;
+        }
+
+        output.resize(static_cast<std::size_t>(end - first) * m_frameSize);
+        std::size_t frameCount = 0;
+        for (std::uint64_t index = first; index < end; ++index) {
+            bool overwritten = false;
+            double* frame = output.data() + frameCount * m_frameSize;
+            slotOf(index).read([&](const XsensMVNSeqLock& slot) {
+                overwritten = slot.value(0) != static_cast<double>(index);
+                for (std::size_t i = 0; !overwritten && i < m_frameSize; ++i) {
+                    frame[i] = slot.value(1 + i);
+                }
+            });
+            // the frames copied so far are older than the overwritten one: drop them as well
+            frameCount = overwritten ? 0 : frameCount + 1;
+        }
+        output.resize(frameCount * m_frameSize);
+        return frameCount;
+    }
+};
+
+#endif // XSENSMVNPUBLISHEDHISTORY_H
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef XSENSMVNRINGBUFFER_H
+#define XSENSMVNRINGBUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace xsens {
+    template <typename T>
+    class XsensMVNRingBuffer;
+} // namespace xsens
+
+// Lock-free ring of preallocated slots for exactly one producer and one consumer thread.
+// The producer fills the slot returned by beginWrite() and publishes it with commitWrite(); the
+// consumer reads front() and releases it with popFront(). Slots are reused, so their content (and
+// their memory) survives between writes. When the ring is full new items are dropped and counted,
+// items already queued are never overwritten.
+template <typename T>
+class xsens::XsensMVNRingBuffer
+{
+    // one slot is always left empty to tell a full ring from an empty one
+    std::vector<T> m_slots;
+    // next slot to write, modified only by the producer
+    std::atomic<std::size_t> m_head;
+    // next slot to read, modified only by the consumer
+    std::atomic<std::size_t> m_tail;
+    std::atomic<unsigned long long> m_overruns;
+
+    std::size_t next(const std::size_t index) const
+    {
+        return index + 1 == m_slots.size() ? 0 : index + 1;
+    }
+
+public:
+    explicit XsensMVNRingBuffer(const std::size_t capacity = 1)
+        : m_slots(capacity + 1)
+        , m_head(0)
+        , m_tail(0)
+        , m_overruns(0)
+    {}
+
+    XsensMVNRingBuffer(const XsensMVNRingBuffer&) = delete;
+    XsensMVNRingBuffer& operator=(const XsensMVNRingBuffer&) = delete;
+
+    // Not thread safe: call it only when neither the producer nor the consumer are running
+    void reset(const std::size_t capacity)
+    {
+        m_slots.clear();
+        m_slots.resize(capacity + 1);
+        m_head.store(0, std::memory_order_relaxed);
+        m_tail.store(0, std::memory_order_relaxed);
+        m_overruns.store(0, std::memory_order_relaxed);
+    }
+
+    std::size_t capacity() const { return m_slots.size() - 1; }
+
+    std::size_t size() const
+    {
+        const std::size_t head = m_head.load(std::memory_order_acquire);
+        const std::size_t tail = m_tail.load(std::memory_order_acquire);
+        return head >= tail ? head - tail : head + m_slots.size() - tail;
+    }
+
+    bool empty() const
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+    unsigned long long overrunCount() const { return m_overruns.load(std::memory_order_relaxed); }
+
+    // Producer side. Returns the slot to fill, or nullptr (counting an overrun) if the ring is full
+    T* beginWrite()
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (next(head) == m_tail.load(std::memory_order_acquire)) {
+            m_overruns.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        return &m_slots[head];
+    }
+
+    // Producer side. Makes the slot returned by the last beginWrite() visible to the consumer
+    void commitWrite()
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        m_head.store(next(head), std::memory_order_release);
+    }
+
+    // Consumer side. Returns the oldest item, or nullptr if the ring is empty
+    T* front()
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &m_slots[tail];
+    }
+
+    // Consumer side. Gives the slot returned by front() back to the producer
+    void popFront()
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        m_tail.store(next(tail), std::memory_order_release);
+    }
+};
+
+#endif // XSENSMVNRINGBUFFER_H
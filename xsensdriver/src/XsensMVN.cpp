@@ -68,12 +68,24 @@ std::vector<yarp::experimental::dev::FrameReference> yarp::dev::XsensMVN::frames
     return m_pimpl->segmentNames();
 }
 
+unsigned yarp::dev::XsensMVN::frameListVersion()
+{
+    assert(m_pimpl);
+    return m_pimpl->modelVersion();
+}
+
 std::vector<yarp::experimental::dev::IMUFrameReference> yarp::dev::XsensMVN::IMUFrames()
 {
     assert(m_pimpl);
     return m_pimpl->sensorIDs();
 }
 
+unsigned yarp::dev::XsensMVN::IMUFrameListVersion()
+{
+    assert(m_pimpl);
+    return m_pimpl->modelVersion();
+}
+
 bool yarp::dev::XsensMVN::setBodyDimensions(const std::map<std::string, double>& dimensions)
 {
     assert(m_pimpl);
@@ -117,28 +129,83 @@ bool yarp::dev::XsensMVN::stopAcquisition()
     return m_pimpl->stopAcquisition();
 }
 
+bool yarp::dev::XsensMVN::waitForNextFrame(const yarp::os::Stamp& lastStamp, const double timeout)
+{
+    assert(m_pimpl);
+    return m_pimpl->waitForNextFrame(lastStamp, timeout);
+}
+
+bool yarp::dev::XsensMVN::addFrameListener(yarp::experimental::dev::FrameListener& listener)
+{
+    assert(m_pimpl);
+    return m_pimpl->addFrameListener(listener);
+}
+
+bool yarp::dev::XsensMVN::removeFrameListener(yarp::experimental::dev::FrameListener& listener)
+{
+    assert(m_pimpl);
+    return m_pimpl->removeFrameListener(listener);
+}
+
+bool yarp::dev::XsensMVN::setEnabledChannels(const unsigned channels)
+{
+    assert(m_pimpl);
+    return m_pimpl->setEnabledChannels(channels);
+}
+
+unsigned yarp::dev::XsensMVN::enabledChannels()
+{
+    assert(m_pimpl);
+    return m_pimpl->enabledChannels();
+}
+
+std::vector<yarp::experimental::dev::LatencyStatistics> yarp::dev::XsensMVN::latencyStatistics()
+{
+    assert(m_pimpl);
+    return m_pimpl->latencyStatistics();
+}
+
+void yarp::dev::XsensMVN::resetLatencyStatistics()
+{
+    assert(m_pimpl);
+    m_pimpl->resetLatencyStatistics();
+}
+
+std::vector<yarp::experimental::dev::FrameContinuityStatistics>
+yarp::dev::XsensMVN::frameContinuityStatistics()
+{
+    assert(m_pimpl);
+    return m_pimpl->frameContinuityStatistics();
+}
+
+void yarp::dev::XsensMVN::resetFrameContinuityStatistics()
+{
+    assert(m_pimpl);
+    m_pimpl->resetFrameContinuityStatistics();
+}
+
 yarp::experimental::dev::IFrameProviderStatus
 yarp::dev::XsensMVN::getFramePoses(std::vector<yarp::sig::Vector>& segmentPoses)
 {
-    // create dummy vectors
-    std::vector<yarp::sig::Vector> dummyVelocities, dummyAccelerations;
-    return getFrameInformation(segmentPoses, dummyVelocities, dummyAccelerations);
+    assert(m_pimpl);
+    return m_pimpl->getLastSegmentChannel(yarp::experimental::dev::FrameChannelPose,
+                                          segmentPoses);
 }
 
 yarp::experimental::dev::IFrameProviderStatus
 yarp::dev::XsensMVN::getFrameVelocities(std::vector<yarp::sig::Vector>& segmentVelocities)
 {
-    // create dummy vectors
-    std::vector<yarp::sig::Vector> dummyPoses, dummyAccelerations;
-    return getFrameInformation(dummyPoses, segmentVelocities, dummyAccelerations);
+    assert(m_pimpl);
+    return m_pimpl->getLastSegmentChannel(yarp::experimental::dev::FrameChannelVelocity,
+                                          segmentVelocities);
 }
 
 yarp::experimental::dev::IFrameProviderStatus
 yarp::dev::XsensMVN::getFrameAccelerations(std::vector<yarp::sig::Vector>& segmentAccelerations)
 {
-    // create dummy vectors
-    std::vector<yarp::sig::Vector> dummyPoses, dummyVelocities;
-    return getFrameInformation(dummyPoses, dummyVelocities, segmentAccelerations);
+    assert(m_pimpl);
+    return m_pimpl->getLastSegmentChannel(yarp::experimental::dev::FrameChannelAcceleration,
+                                          segmentAccelerations);
 }
 
 yarp::experimental::dev::IFrameProviderStatus
@@ -152,41 +219,48 @@ yarp::dev::XsensMVN::getFrameInformation(std::vector<yarp::sig::Vector>& segment
         dummy, segmentPoses, segmentVelocities, segmentAccelerations);
 }
 
+yarp::experimental::dev::IFrameProviderStatus yarp::dev::XsensMVN::getStampedFrameInformation(
+    std::vector<yarp::sig::Vector>& segmentPoses,
+    std::vector<yarp::sig::Vector>& segmentVelocities,
+    std::vector<yarp::sig::Vector>& segmentAccelerations,
+    yarp::os::Stamp& timestamp)
+{
+    assert(m_pimpl);
+    return m_pimpl->getLastSegmentInformation(
+        timestamp, segmentPoses, segmentVelocities, segmentAccelerations);
+}
+
 yarp::experimental::dev::IIMUFrameProviderStatus
 yarp::dev::XsensMVN::getIMUFrameOrientations(std::vector<yarp::sig::Vector>& imuOrientations)
 {
-    // create dummy vectors
-    std::vector<yarp::sig::Vector> dummyVelocities, dummyAccelerations, dummyMagneticFields;
-    return getIMUFrameInformation(
-        imuOrientations, dummyVelocities, dummyAccelerations, dummyMagneticFields);
+    assert(m_pimpl);
+    return m_pimpl->getLastSensorChannel(yarp::experimental::dev::FrameChannelIMUOrientation,
+                                         imuOrientations);
 }
 
 yarp::experimental::dev::IIMUFrameProviderStatus yarp::dev::XsensMVN::getIMUFrameAngularVelocities(
     std::vector<yarp::sig::Vector>& imuAngularVelocities)
 {
-    // create dummy vectors
-    std::vector<yarp::sig::Vector> dummyOrientations, dummyAccelerations, dummyMagneticFields;
-    return getIMUFrameInformation(
-        dummyOrientations, imuAngularVelocities, dummyAccelerations, dummyMagneticFields);
+    assert(m_pimpl);
+    return m_pimpl->getLastSensorChannel(yarp::experimental::dev::FrameChannelIMUAngularVelocity,
+                                         imuAngularVelocities);
 }
 
 yarp::experimental::dev::IIMUFrameProviderStatus
 yarp::dev::XsensMVN::getIMUFrameLinearAccelerations(
     std::vector<yarp::sig::Vector>& imuLinearAccelerations)
 {
-    // create dummy vectors
-    std::vector<yarp::sig::Vector> dummyOrientations, dummyVelocities, dummyMagneticFields;
-    return getIMUFrameInformation(
-        dummyOrientations, dummyVelocities, imuLinearAccelerations, dummyMagneticFields);
+    assert(m_pimpl);
+    return m_pimpl->getLastSensorChannel(
+        yarp::experimental::dev::FrameChannelIMULinearAcceleration, imuLinearAccelerations);
 }
 
 yarp::experimental::dev::IIMUFrameProviderStatus
 yarp::dev::XsensMVN::getIMUFrameMagneticFields(std::vector<yarp::sig::Vector>& imuMagneticFields)
 {
-    // create dummy vectors
-    std::vector<yarp::sig::Vector> dummyOrientations, dummyVelocities, dummyAccelerations;
-    return getIMUFrameInformation(
-        dummyOrientations, dummyVelocities, dummyAccelerations, imuMagneticFields);
+    assert(m_pimpl);
+    return m_pimpl->getLastSensorChannel(yarp::experimental::dev::FrameChannelIMUMagneticField,
+                                         imuMagneticFields);
 }
 
 yarp::experimental::dev::IIMUFrameProviderStatus
@@ -200,3 +274,71 @@ yarp::dev::XsensMVN::getIMUFrameInformation(std::vector<yarp::sig::Vector>& imuO
     return m_pimpl->getLastSensorInformation(
         dummy, imuOrientations, imuAngularVelocities, imuLinearAccelerations, imuMagneticFields);
 }
+
+yarp::experimental::dev::IIMUFrameProviderStatus yarp::dev::XsensMVN::getStampedIMUFrameInformation(
+    std::vector<yarp::sig::Vector>& imuOrientations,
+    std::vector<yarp::sig::Vector>& imuAngularVelocities,
+    std::vector<yarp::sig::Vector>& imuLinearAccelerations,
+    std::vector<yarp::sig::Vector>& imuMagneticFields,
+    yarp::os::Stamp& timestamp)
+{
+    assert(m_pimpl);
+    return m_pimpl->getLastSensorInformation(timestamp,
+                                             imuOrientations,
+                                             imuAngularVelocities,
+                                             imuLinearAccelerations,
+                                             imuMagneticFields);
+}
+
+std::size_t yarp::dev::XsensMVN::frameBulkSize()
+{
+    assert(m_pimpl);
+    return m_pimpl->frameLayout().segmentCount() * yarp::experimental::dev::FrameBulkStride;
+}
+
+yarp::experimental::dev::IFrameProviderStatus yarp::dev::XsensMVN::getFrameBulk(
+    double* buffer,
+    const std::size_t bufferSize,
+    yarp::os::Stamp& timestamp)
+{
+    assert(m_pimpl);
+    return m_pimpl->getLastSegmentBulk(buffer, bufferSize, timestamp);
+}
+
+std::size_t yarp::dev::XsensMVN::IMUFrameBulkSize()
+{
+    assert(m_pimpl);
+    return m_pimpl->frameLayout().sensorCount() * yarp::experimental::dev::IMUFrameBulkStride;
+}
+
+yarp::experimental::dev::IIMUFrameProviderStatus yarp::dev::XsensMVN::getIMUFrameBulk(
+    double* buffer,
+    const std::size_t bufferSize,
+    yarp::os::Stamp& timestamp)
+{
+    assert(m_pimpl);
+    return m_pimpl->getLastSensorBulk(buffer, bufferSize, timestamp);
+}
+
+bool yarp::dev::XsensMVN::frameDataLayout(unsigned& segmentCount, unsigned& imuCount)
+{
+    assert(m_pimpl);
+    const xsens::XsensMVNFrameLayout layout = m_pimpl->frameLayout();
+    segmentCount = layout.segmentCount();
+    imuCount = layout.sensorCount();
+    return layout.size() > xsens::XsensMVNFrameLayout::HeaderSize;
+}
+
+yarp::experimental::dev::IFrameProviderStatus
+yarp::dev::XsensMVN::getLastFrameData(yarp::os::Stamp& timestamp, std::vector<double>& frameData)
+{
+    assert(m_pimpl);
+    return m_pimpl->getLastFrameData(timestamp, frameData);
+}
+
+std::size_t yarp::dev::XsensMVN::getFramesSince(const int lastFrameNumber,
+                                                std::vector<double>& framesData)
+{
+    assert(m_pimpl);
+    return m_pimpl->getFramesSince(lastFrameNumber, framesData);
+}
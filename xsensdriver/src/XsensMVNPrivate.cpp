@@ -10,32 +10,119 @@
 
 #include "XsensMVNCalibrator.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <string>
 #include <xme.h>
 #include <yarp/os/LogStream.h>
 #include <yarp/os/Searchable.h>
 #include <yarp/os/Time.h>
 
-void yarp::dev::XsensMVN::XsensMVNPrivate::resizeVectorToOuterAndInnerSize(
-    std::vector<yarp::sig::Vector>& vector,
-    unsigned outerSize,
-    unsigned innerSize)
-{
-    size_t oldSize = vector.size();
-    vector.resize(outerSize);
-    for (unsigned i = oldSize; i < outerSize; ++i) {
-        vector[i].resize(innerSize, 0.0);
+namespace {
+    typedef xsens::XsensMVNFrameLayout Layout;
+
+    // Highest frame rate of the MVN suits, used to size the frame history
+    const double MaximumFrameRate = 240.0;
+    // Time allowed for the first frame of an acquisition, before the frame period is known [s]
+    const double FirstFrameTimeout = 1.0;
+    // Longest sleep of the processor while acquiring and while idle [s]. The SDK thread notifies
+    // without the processor mutex: a notification sent just before the processor blocks is lost,
+    // and the frame waits for the next wake up
+    const double AcquiringWakeupBackstop = 0.002;
+    const double IdleWakeupBackstop = 0.1;
+
+    std::chrono::steady_clock::rep deadlineAfter(const std::chrono::steady_clock::time_point time,
+                                                 const double seconds)
+    {
+        return (time
+                + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                      std::chrono::duration<double>(seconds)))
+            .time_since_epoch()
+            .count();
+    }
+
+    // Interface channel (yarp::experimental::dev::FrameChannel) carrying a channel of the layout
+    unsigned frameChannel(const Layout::Channel channel)
+    {
+        switch (channel) {
+            case Layout::SegmentPositions:
+            case Layout::SegmentOrientations:
+                return yarp::experimental::dev::FrameChannelPose;
+            case Layout::SegmentLinearVelocities:
+            case Layout::SegmentAngularVelocities:
+                return yarp::experimental::dev::FrameChannelVelocity;
+            case Layout::SegmentLinearAccelerations:
+            case Layout::SegmentAngularAccelerations:
+                return yarp::experimental::dev::FrameChannelAcceleration;
+            case Layout::SensorOrientations:
+                return yarp::experimental::dev::FrameChannelIMUOrientation;
+            case Layout::SensorAngularVelocities:
+                return yarp::experimental::dev::FrameChannelIMUAngularVelocity;
+            case Layout::SensorLinearAccelerations:
+                return yarp::experimental::dev::FrameChannelIMULinearAcceleration;
+            case Layout::SensorMagneticFields:
+                return yarp::experimental::dev::FrameChannelIMUMagneticField;
+            default:
+                return 0;
+        }
     }
-}
+
+    // Channels of the layout holding a FrameChannel: segment channels are made of a linear and
+    // an angular (or orientation) part, IMU channels of the first part only
+    bool layoutChannels(const unsigned channel, Layout::Channel& first, Layout::Channel& second)
+    {
+        switch (channel) {
+            case yarp::experimental::dev::FrameChannelPose:
+                first = Layout::SegmentPositions;
+                second = Layout::SegmentOrientations;
+                return true;
+            case yarp::experimental::dev::FrameChannelVelocity:
+                first = Layout::SegmentLinearVelocities;
+                second = Layout::SegmentAngularVelocities;
+                return true;
+            case yarp::experimental::dev::FrameChannelAcceleration:
+                first = Layout::SegmentLinearAccelerations;
+                second = Layout::SegmentAngularAccelerations;
+                return true;
+            case yarp::experimental::dev::FrameChannelIMUOrientation:
+                first = second = Layout::SensorOrientations;
+                return true;
+            case yarp::experimental::dev::FrameChannelIMUAngularVelocity:
+                first = second = Layout::SensorAngularVelocities;
+                return true;
+            case yarp::experimental::dev::FrameChannelIMULinearAcceleration:
+                first = second = Layout::SensorLinearAccelerations;
+                return true;
+            case yarp::experimental::dev::FrameChannelIMUMagneticField:
+                first = second = Layout::SensorMagneticFields;
+                return true;
+            default:
+                return false;
+        }
+    }
+} // namespace
 
 yarp::dev::XsensMVN::XsensMVNPrivate::XsensMVNPrivate()
     : m_license(0)
     , m_connection(0)
     , m_calibrator(0)
+    , m_lastProcessedPoseTime(0)
+    , m_lastProcessedFrameNumber(0)
+    , m_configuredFramePeriod(0)
+    , m_estimatedFramePeriod(0)
+    , m_timeoutPeriods(1.5)
+    , m_frameDeadline(0)
+    , m_statusChanges(0)
+    , m_calibrationPoseCount(0)
     , m_acquiring(false)
+    , m_enabledChannels(yarp::experimental::dev::FrameChannelAll)
+    , m_modelVersion(0)
     , m_stopProcessor(false)
-    , m_lastFrameDataWritten(false)
+    , m_processorSleeping(false)
+    , m_countedOverruns(0)
+    , m_reportedOverruns(0)
+    , m_lastOverrunReportTime(0)
     , m_hardwareFound(false)
     , m_driverStatus(yarp::experimental::dev::IFrameProviderStatusNoData)
 {}
@@ -85,6 +172,73 @@ bool yarp::dev::XsensMVN::XsensMVNPrivate::init(yarp::os::Searchable& config)
         return false;
     }
 
+    // frames queued between the SDK callbacks and the processor thread
+    int frameBufferSize =
+        config.check("frame-buffer-size", yarp::os::Value(16), "number of frames to buffer")
+            .asInt();
+    if (frameBufferSize < 1) {
+        yWarning("Invalid frame-buffer-size %d. Using 1", frameBufferSize);
+        frameBufferSize = 1;
+    }
+    m_frameBuffer.reset(static_cast<size_t>(frameBufferSize));
+    m_countedOverruns = 0;
+    m_reportedOverruns = 0;
+
+    // channels no consumer uses are skipped, from the processing of the frames onwards
+    unsigned segmentChannels = 0;
+    yarp::os::ConstString segmentChannelNames =
+        config
+            .check("segment-channels",
+                   yarp::os::Value("all"),
+                   "Checking segment channels (all, none, or a list of pose,velocity,acceleration)")
+            .asString();
+    if (!yarp::experimental::dev::parseSegmentChannels(segmentChannelNames, segmentChannels)) {
+        yError("Invalid segment-channels '%s'", segmentChannelNames.c_str());
+        fini();
+        return false;
+    }
+    unsigned imuChannels = 0;
+    yarp::os::ConstString imuChannelNames =
+        config
+            .check("sensor-channels",
+                   yarp::os::Value("all"),
+                   "Checking sensor channels (all, none, or a list of "
+                   "orientation,angular-velocity,linear-acceleration,magnetic-field)")
+            .asString();
+    if (!yarp::experimental::dev::parseIMUChannels(imuChannelNames, imuChannels)) {
+        yError("Invalid sensor-channels '%s'", imuChannelNames.c_str());
+        fini();
+        return false;
+    }
+    m_enabledChannels = segmentChannels | imuChannels;
+
+    if (!yarp::experimental::dev::parseThreadScheduling(
+            config, "processor-thread", m_processorScheduling)) {
+        fini();
+        return false;
+    }
+
+    double frameRate =
+        config
+            .check("frame-rate",
+                   yarp::os::Value(0.0),
+                   "Checking expected frame rate [Hz] (0 to estimate it from the frames)")
+            .asDouble();
+    m_configuredFramePeriod = frameRate > 0 ? 1.0 / frameRate : 0;
+    m_estimatedFramePeriod = 0;
+    m_timeoutPeriods = config
+                           .check("frame-timeout-periods",
+                                  yarp::os::Value(1.5),
+                                  "Checking frame periods without frames before the timeout")
+                           .asDouble();
+    if (m_timeoutPeriods < 1) {
+        yWarning("Invalid frame-timeout-periods %lf. Using 1", m_timeoutPeriods);
+        m_timeoutPeriods = 1;
+    }
+    yInfo("Enabled segment channels: %s. Enabled sensor channels: %s",
+          yarp::experimental::dev::segmentChannelsToString(m_enabledChannels).c_str(),
+          yarp::experimental::dev::imuChannelsToString(m_enabledChannels).c_str());
+
     m_connection->addCallbackHandler(this);
 
     yInfo("--- Available configurations ---");
@@ -217,15 +371,31 @@ bool yarp::dev::XsensMVN::XsensMVNPrivate::init(yarp::os::Searchable& config)
         }
     }
 
-    // Initialize size of vectors (model is set before calibration)
-    resizeVectorToOuterAndInnerSize(m_lastSegmentPosesRead, m_connection->segmentCount(), 7);
-    resizeVectorToOuterAndInnerSize(m_lastSegmentVelocitiesRead, m_connection->segmentCount(), 6);
-    resizeVectorToOuterAndInnerSize(m_lastSegmentAccelerationRead, m_connection->segmentCount(), 6);
-
-    resizeVectorToOuterAndInnerSize(m_lastSensorVelocitiesRead, m_connection->sensorCount(), 3);
-    resizeVectorToOuterAndInnerSize(m_lastSensorAccelerationsRead, m_connection->sensorCount(), 3);
-    resizeVectorToOuterAndInnerSize(m_lastSensorMagneticFieldsRead, m_connection->sensorCount(), 3);
-    resizeVectorToOuterAndInnerSize(m_lastSensorOrientationsRead, m_connection->sensorCount(), 4);
+    // Initialize size of the published frame (model is set before calibration)
+    {
+        std::lock_guard<std::mutex> writeLock(m_dataMutex);
+        m_layout = xsens::XsensMVNFrameLayout(
+            static_cast<unsigned>(std::max(0, m_connection->segmentCount())),
+            static_cast<unsigned>(std::max(0, m_connection->sensorCount())));
+        m_lastFrameRead.assign(m_layout.size(), 0.0);
+        m_publishedFrame.resize(m_lastFrameRead.size());
+    }
+    notifyModelChange();
+
+    // history of the processed frames
+    double historyDuration = config
+                                 .check("frame-history-duration",
+                                        yarp::os::Value(1.0),
+                                        "seconds of processed frames to keep")
+                                 .asDouble();
+    if (historyDuration < 0) {
+        yWarning("Invalid frame-history-duration %lf. Disabling the history", historyDuration);
+        historyDuration = 0;
+    }
+    const std::size_t historyLength =
+        static_cast<std::size_t>(std::ceil(historyDuration * MaximumFrameRate));
+    // the processor pushes frames only while acquiring, which cannot start before the end of init
+    m_frameHistory.reset(m_layout.size(), historyLength);
 
     yInfo("--- Body model Segments ---");
     std::vector<yarp::experimental::dev::FrameReference> segments = segmentNames();
@@ -312,6 +482,7 @@ bool yarp::dev::XsensMVN::XsensMVNPrivate::fini()
 
         m_connection->destruct();
         m_connection = 0;
+        notifyModelChange();
     }
 
     // Xsens now should not provide anymore callbacks
@@ -325,6 +496,10 @@ bool yarp::dev::XsensMVN::XsensMVNPrivate::fini()
     }
     if (m_processor.joinable())
         m_processor.join();
+    if (m_frameBuffer.overrunCount() > 0) {
+        yWarning("%llu frames have been dropped because the frame buffer was full",
+                 m_frameBuffer.overrunCount());
+    }
     if (m_license) {
         delete m_license;
         m_license = 0;
@@ -382,31 +557,63 @@ yarp::dev::XsensMVN::XsensMVNPrivate::sensorIDs() const
     return sensors;
 }
 
-bool yarp::dev::XsensMVN::XsensMVNPrivate::startAcquisition()
+unsigned yarp::dev::XsensMVN::XsensMVNPrivate::modelVersion() const
 {
-    std::lock_guard<std::recursive_mutex> globalGuard(m_objectMutex);
-    if (!m_connection || !m_connection->status().isConnected())
-        return false;
-    if (m_calibrator && m_calibrator->isCalibrationInProgress())
-        return false;
-    // TODO: do some checks also on the status of the device
-    m_acquiring = true;
+    return m_modelVersion;
+}
 
-    yInfo("Starting acquiring data");
-    m_driverStatus = yarp::experimental::dev::IFrameProviderStatusOK;
-    m_connection->setRealTimePoseMode(true);
+void yarp::dev::XsensMVN::XsensMVNPrivate::notifyModelChange()
+{
+    // skip 0, which tells the frame tables not to cache
+    if (++m_modelVersion == 0) {
+        ++m_modelVersion;
+    }
+}
+
+bool yarp::dev::XsensMVN::XsensMVNPrivate::startAcquisition()
+{
+    {
+        std::lock_guard<std::recursive_mutex> globalGuard(m_objectMutex);
+        if (!m_connection || !m_connection->status().isConnected())
+            return false;
+        if (m_calibrator && m_calibrator->isCalibrationInProgress())
+            return false;
+        // TODO: do some checks also on the status of the device
+        // armed before m_acquiring, so that the watchdog never sees the deadline of a past
+        // acquisition
+        m_frameDeadline = deadlineAfter(std::chrono::steady_clock::now(), FirstFrameTimeout);
+        m_acquiring = true;
+        // frames of a previous acquisition are not returned anymore
+        m_frameHistory.clear();
+        // nor compared with the new ones, whose numbering may restart
+        m_frameContinuity.reset();
+
+        yInfo("Starting acquiring data");
+        m_driverStatus = yarp::experimental::dev::IFrameProviderStatusOK;
+        {
+            // the processor waits for the deadline only while acquiring
+            std::lock_guard<std::mutex> processorLock(m_processorGuard);
+        }
+        m_processorVariable.notify_one();
+        m_connection->setRealTimePoseMode(true);
+    }
+    // the listeners are called without m_objectMutex, which they may need to call the driver
+    notifyStatusChange();
     return true;
 }
 
 bool yarp::dev::XsensMVN::XsensMVNPrivate::stopAcquisition()
 {
-    std::lock_guard<std::recursive_mutex> globalGuard(m_objectMutex);
-    if (!m_connection)
-        return false;
-    m_acquiring = false;
-    m_connection->setRealTimePoseMode(false);
-    yInfo("Stopping acquiring data");
-    m_driverStatus = yarp::experimental::dev::IFrameProviderStatusNoData;
+    {
+        std::lock_guard<std::recursive_mutex> globalGuard(m_objectMutex);
+        if (!m_connection)
+            return false;
+        m_acquiring = false;
+        m_connection->setRealTimePoseMode(false);
+        yInfo("Stopping acquiring data");
+        m_driverStatus = yarp::experimental::dev::IFrameProviderStatusNoData;
+    }
+    notifyStatusChange();
     return true;
 }
 
@@ -469,109 +676,343 @@ bool yarp::dev::XsensMVN::XsensMVNPrivate::abortCalibration()
 void yarp::dev::XsensMVN::XsensMVNPrivate::processNewFrame()
 {
     yDebug("Entering thread");
+    if (!yarp::experimental::dev::applyThreadScheduling(m_processorScheduling)) {
+        yWarning("Processor thread running without some of the processor-thread options");
+    }
     while (true) {
-        std::unique_lock<std::mutex> lock(m_processorGuard);
-        // while no data
-        m_processorVariable.wait(lock, [&]() { return m_stopProcessor || m_lastFrameDataWritten; });
-        // last chance to check if we have to return
-        // before starting processing stuff
-        if (m_stopProcessor) {
-            // we should return
-            break;
-        }
-        // get the copied data
-        FrameData lastFrame = std::move(m_lastFrameData);
-        m_lastFrameDataWritten = false;
-        // release lock
-        lock.unlock();
-
         {
-            std::lock_guard<std::recursive_mutex> globalGuard(m_objectMutex);
-            if (!m_acquiring) {
+            std::unique_lock<std::mutex> lock(m_processorGuard);
+            // The SDK thread commits its frame, then notifies if it sees m_processorSleeping. With
+            // the fences either it sees the flag or hasWork sees the frame. Only a notification
+            // sent between hasWork and the wait is lost, and the backstop bounds its delay
+            m_processorSleeping.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto hasWork = [&]() { return m_stopProcessor || !m_frameBuffer.empty(); };
+            // the watchdog deadline is armed while the frames are expected
+            const bool watching =
+                m_acquiring && m_driverStatus == yarp::experimental::dev::IFrameProviderStatusOK;
+            const std::chrono::steady_clock::rep backstop =
+                deadlineAfter(std::chrono::steady_clock::now(),
+                              watching ? AcquiringWakeupBackstop : IdleWakeupBackstop);
+            const std::chrono::steady_clock::rep deadline =
+                watching ? std::min(backstop, m_frameDeadline.load()) : backstop;
+            const bool woken = m_processorVariable.wait_until(
+                lock,
+                std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(deadline)),
+                hasWork);
+            m_processorSleeping.store(false, std::memory_order_relaxed);
+            if (!woken && deadline == backstop) {
+                // nothing to do before the watchdog deadline
                 continue;
             }
+            // last chance to check if we have to return
+            // before starting processing stuff
+            if (m_stopProcessor) {
+                // we should return
+                break;
+            }
         }
-        // process incoming pose to obtain information
 
-        {
-            // Unique lock for all data?
-            std::lock_guard<std::mutex> readLock(m_dataMutex);
+        // overruns are counted by the SDK thread but reported here, at most once per second
+        const unsigned long long overruns = m_frameBuffer.overrunCount();
+        m_frameContinuity.recordDropped(overruns - m_countedOverruns);
+        m_countedOverruns = overruns;
+        m_frameContinuity.advance(yarp::os::Time::now());
+        if (overruns != m_reportedOverruns
+            && yarp::os::Time::now() - m_lastOverrunReportTime > 1.0) {
+            yWarning("Frame buffer full, %llu frames dropped (%llu in total). Consider increasing "
+                     "frame-buffer-size",
+                     overruns - m_reportedOverruns,
+                     overruns);
+            m_reportedOverruns = overruns;
+            m_lastOverrunReportTime = yarp::os::Time::now();
+        }
+
+        // process all the queued frames in order
+        while (FrameData* frame = m_frameBuffer.front()) {
+            processFrame(*frame);
+            m_frameBuffer.popFront();
+        }
+
+        checkFrameDeadline();
+    }
+    yDebug("Exiting thread");
+}
+
+void yarp::dev::XsensMVN::XsensMVNPrivate::checkFrameDeadline()
+{
+    if (!m_acquiring
+        || std::chrono::steady_clock::now().time_since_epoch().count() < m_frameDeadline) {
+        return;
+    }
+    // only OK turns into Timeout: errors and stopped acquisitions keep their status
+    yarp::experimental::dev::IFrameProviderStatus expected =
+        yarp::experimental::dev::IFrameProviderStatusOK;
+    if (m_driverStatus.compare_exchange_strong(
+            expected, yarp::experimental::dev::IFrameProviderStatusTimeout)) {
+        yWarning("No frames received in the last %.1lf ms",
+                 1e3 * m_timeoutPeriods
+                     * (m_configuredFramePeriod > 0 ? m_configuredFramePeriod
+                                                    : m_estimatedFramePeriod));
+        notifyStatusChange();
+    }
+}
 
-            if (m_lastSegmentPosesRead.size() != lastFrame.pose.m_segmentStates.size()
-                || m_lastSensorOrientationsRead.size() != lastFrame.sensorsData.size()) {
-                m_driverStatus = yarp::experimental::dev::IFrameProviderStatusError;
-                continue; // error
+void yarp::dev::XsensMVN::XsensMVNPrivate::notifyNewFrame()
+{
+    {
+        // a waiter checking the stamp has either seen the new frame or is already waiting
+        std::lock_guard<std::mutex> newFrameLock(m_newFrameMutex);
+    }
+    m_newFrameVariable.notify_all();
+    notifyFrameListeners();
+}
+
+void yarp::dev::XsensMVN::XsensMVNPrivate::notifyStatusChange()
+{
+    ++m_statusChanges;
+    {
+        // as for the new frames, a waiter has either seen the change or is already waiting
+        std::lock_guard<std::mutex> newFrameLock(m_newFrameMutex);
+    }
+    m_newFrameVariable.notify_all();
+    notifyFrameListeners();
+}
+
+void yarp::dev::XsensMVN::XsensMVNPrivate::notifyFrameListeners()
+{
+    yarp::os::Stamp timestamp;
+    const yarp::experimental::dev::IFrameProviderStatus status =
+        getLastSegmentReadTimestamp(timestamp);
+    m_frameListeners.notify(timestamp, status);
+}
+
+void yarp::dev::XsensMVN::XsensMVNPrivate::processFrame(const FrameData& lastFrame)
+{
+    {
+        std::lock_guard<std::recursive_mutex> globalGuard(m_objectMutex);
+        if (!m_acquiring) {
+            return;
+        }
+    }
+    // process incoming pose to obtain information
+    {
+        // only serialises the writers, readers never take this lock
+        std::unique_lock<std::mutex> writeLock(m_dataMutex);
+
+        if (m_layout.segmentCount() != lastFrame.pose.m_segmentStates.size()
+            || m_layout.sensorCount() != lastFrame.sensorsData.size()) {
+            writeLock.unlock();
+            // as for the timeouts, a stopped acquisition keeps its status
+            yarp::experimental::dev::IFrameProviderStatus status = m_driverStatus;
+            bool changed = false;
+            while (!changed
+                   && (status == yarp::experimental::dev::IFrameProviderStatusOK
+                       || status == yarp::experimental::dev::IFrameProviderStatusTimeout)) {
+                changed = m_driverStatus.compare_exchange_weak(
+                    status, yarp::experimental::dev::IFrameProviderStatusError);
+            }
+            if (changed) {
+                yError("Received a frame of %u segments and %u sensors, expected %u and %u",
+                       static_cast<unsigned>(lastFrame.pose.m_segmentStates.size()),
+                       static_cast<unsigned>(lastFrame.sensorsData.size()),
+                       m_layout.segmentCount(),
+                       m_layout.sensorCount());
+                notifyStatusChange();
             }
+            return;
+        }
+
+        m_frameContinuity.recordFrame(lastFrame.pose.m_frameNumber);
+
+        // HP: absoluteTime = ms from epoch (as Unix Epoch)
+        // TODO: add option to use xsens time instead of receiver time
+        int64_t unixTime = lastFrame.pose.m_absoluteTime;
+        double time = unixTime / 1000.0;
+        // double time = yarp::os::Time::now();// / 1000.0;
+        double* frame = m_lastFrameRead.data();
+        frame[Layout::FrameNumberOffset] = lastFrame.pose.m_frameNumber;
+        frame[Layout::TimeOffset] = time;
 
-            // HP: absoluteTime = ms from epoch (as Unix Epoch)
-            // TODO: add option to use xsens time instead of receiver time
-            int64_t unixTime = lastFrame.pose.m_absoluteTime;
-            double time = unixTime / 1000.0;
-            // double time = yarp::os::Time::now();// / 1000.0;
-            m_lastTimestamp = yarp::os::Stamp(lastFrame.pose.m_frameNumber, time);
+        // yInfo("Frame received at %lf - YARP Time %lf", time, yarp::os::Time::now());
 
-            // yInfo("Frame received at %lf - YARP Time %lf", time, yarp::os::Time::now());
+        // disabled channels keep the zeros written by setEnabledChannels
+        const unsigned channels = m_enabledChannels;
 
+        if (channels & yarp::experimental::dev::FrameChannelPose) {
+            double* positions = frame + m_layout.channelOffset(Layout::SegmentPositions);
+            double* orientations = frame + m_layout.channelOffset(Layout::SegmentOrientations);
             for (unsigned index = 0; index < lastFrame.pose.m_segmentStates.size(); ++index) {
                 const XmeSegmentState& segmentData = lastFrame.pose.m_segmentStates[index];
-                yarp::sig::Vector& segmentPosition = m_lastSegmentPosesRead[index];
-                yarp::sig::Vector& segmentVelocity = m_lastSegmentVelocitiesRead[index];
-                yarp::sig::Vector& segmentAcceleration = m_lastSegmentAccelerationRead[index];
-
                 for (unsigned i = 0; i < 3; ++i) {
-                    // linear part
-                    segmentPosition(i) = segmentData.m_position[i];
-                    segmentVelocity(i) = segmentData.m_velocity[i];
-                    segmentAcceleration(i) = segmentData.m_acceleration[i];
-                    // angular part for velocity and acceleration
-                    segmentVelocity(3 + i) = segmentData.m_angularVelocity[i];
-                    segmentAcceleration(3 + i) = segmentData.m_angularAcceleration[i];
+                    positions[3 * index + i] = segmentData.m_position[i];
                 }
                 // Do the quaternion explicitly to avoid issues in format
-                segmentPosition(3) = segmentData.m_orientation.w();
-                segmentPosition(4) = segmentData.m_orientation.x();
-                segmentPosition(5) = segmentData.m_orientation.y();
-                segmentPosition(6) = segmentData.m_orientation.z();
+                orientations[4 * index + 0] = segmentData.m_orientation.w();
+                orientations[4 * index + 1] = segmentData.m_orientation.x();
+                orientations[4 * index + 2] = segmentData.m_orientation.y();
+                orientations[4 * index + 3] = segmentData.m_orientation.z();
+            }
+        }
+
+        if (channels & yarp::experimental::dev::FrameChannelVelocity) {
+            double* linearVelocities =
+                frame + m_layout.channelOffset(Layout::SegmentLinearVelocities);
+            double* angularVelocities =
+                frame + m_layout.channelOffset(Layout::SegmentAngularVelocities);
+            for (unsigned index = 0; index < lastFrame.pose.m_segmentStates.size(); ++index) {
+                const XmeSegmentState& segmentData = lastFrame.pose.m_segmentStates[index];
+                for (unsigned i = 0; i < 3; ++i) {
+                    linearVelocities[3 * index + i] = segmentData.m_velocity[i];
+                    angularVelocities[3 * index + i] = segmentData.m_angularVelocity[i];
+                }
             }
+        }
+
+        if (channels & yarp::experimental::dev::FrameChannelAcceleration) {
+            double* linearAccelerations =
+                frame + m_layout.channelOffset(Layout::SegmentLinearAccelerations);
+            double* angularAccelerations =
+                frame + m_layout.channelOffset(Layout::SegmentAngularAccelerations);
+            for (unsigned index = 0; index < lastFrame.pose.m_segmentStates.size(); ++index) {
+                const XmeSegmentState& segmentData = lastFrame.pose.m_segmentStates[index];
+                for (unsigned i = 0; i < 3; ++i) {
+                    linearAccelerations[3 * index + i] = segmentData.m_acceleration[i];
+                    angularAccelerations[3 * index + i] = segmentData.m_angularAcceleration[i];
+                }
+            }
+        }
+
+        if (channels & yarp::experimental::dev::FrameChannelIMUs) {
+            double* sensorOrientations = frame + m_layout.channelOffset(Layout::SensorOrientations);
+            double* sensorVelocities =
+                frame + m_layout.channelOffset(Layout::SensorAngularVelocities);
+            double* sensorAccelerations =
+                frame + m_layout.channelOffset(Layout::SensorLinearAccelerations);
+            double* sensorMagneticFields =
+                frame + m_layout.channelOffset(Layout::SensorMagneticFields);
+            const bool orientation = channels & yarp::experimental::dev::FrameChannelIMUOrientation;
+            const bool angularVelocity =
+                channels & yarp::experimental::dev::FrameChannelIMUAngularVelocity;
+            const bool linearAcceleration =
+                channels & yarp::experimental::dev::FrameChannelIMULinearAcceleration;
+            const bool magneticField =
+                channels & yarp::experimental::dev::FrameChannelIMUMagneticField;
 
             for (unsigned index = 0; index < lastFrame.sensorsData.size(); ++index) {
                 const XmeSensorSample& sensorData = lastFrame.sensorsData[index];
-                yarp::sig::Vector& sensorOrientation = m_lastSensorOrientationsRead[index];
-                yarp::sig::Vector& sensorVelocity = m_lastSensorVelocitiesRead[index];
-                yarp::sig::Vector& sensorAcceleration = m_lastSensorAccelerationsRead[index];
-                yarp::sig::Vector& sensorMagneticField = m_lastSensorMagneticFieldsRead[index];
 
                 for (unsigned i = 0; i < 3; ++i) {
-                    sensorVelocity(i) = sensorData.m_gyr[i];
-                    sensorAcceleration(i) = sensorData.m_acc[i];
-                    sensorMagneticField(i) = sensorData.m_mag[i];
+                    if (angularVelocity) {
+                        sensorVelocities[3 * index + i] = sensorData.m_gyr[i];
+                    }
+                    if (linearAcceleration) {
+                        sensorAccelerations[3 * index + i] = sensorData.m_acc[i];
+                    }
+                    if (magneticField) {
+                        sensorMagneticFields[3 * index + i] = sensorData.m_mag[i];
+                    }
+                }
+                if (orientation) {
+                    sensorOrientations[4 * index + 0] = sensorData.m_q.w();
+                    sensorOrientations[4 * index + 1] = sensorData.m_q.x();
+                    sensorOrientations[4 * index + 2] = sensorData.m_q.y();
+                    sensorOrientations[4 * index + 3] = sensorData.m_q.z();
                 }
-                sensorOrientation(0) = sensorData.m_q.w();
-                sensorOrientation(1) = sensorData.m_q.x();
-                sensorOrientation(2) = sensorData.m_q.y();
-                sensorOrientation(3) = sensorData.m_q.z();
             }
+        }
 
-            m_driverStatus = yarp::experimental::dev::IFrameProviderStatusOK;
+        m_publishedFrame.write(m_lastFrameRead.data());
+        // only a Timeout turns back into OK: stopAcquisition() may have set NoData since the check
+        // of m_acquiring, and the frame must not override it
+        yarp::experimental::dev::IFrameProviderStatus expected =
+            yarp::experimental::dev::IFrameProviderStatusTimeout;
+        if (m_driverStatus.compare_exchange_strong(
+                expected, yarp::experimental::dev::IFrameProviderStatusOK)) {
+            yInfo("Receiving frames again");
+            ++m_statusChanges;
+        }
+        const std::chrono::steady_clock::time_point processedTime =
+            std::chrono::steady_clock::now();
+        m_callbackToProcessedLatency.record(
+            std::chrono::duration<double>(processedTime - lastFrame.callbackTime).count());
+        const int frameNumber = lastFrame.pose.m_frameNumber;
+        if (m_lastProcessedPoseTime > 0) {
+            const double processedInterval =
+                std::chrono::duration<double>(processedTime - m_lastProcessedTime).count();
+            m_processingJitter.record(
+                std::abs(processedInterval - (time - m_lastProcessedPoseTime)));
+
+            // frame period estimated over the consecutive frames, pauses excluded
+            const int elapsedFrames = frameNumber - m_lastProcessedFrameNumber;
+            const double interval = time - m_lastProcessedPoseTime;
+            if (elapsedFrames > 0 && interval > 0 && interval < FirstFrameTimeout) {
+                const double period = interval / elapsedFrames;
+                m_estimatedFramePeriod = m_estimatedFramePeriod > 0
+                                             ? 0.9 * m_estimatedFramePeriod + 0.1 * period
+                                             : period;
+            }
         }
+        m_lastProcessedTime = processedTime;
+        m_lastProcessedPoseTime = time;
+        m_lastProcessedFrameNumber = frameNumber;
+
+        // next arrival deadline, measured from the arrival of this frame
+        const double framePeriod =
+            m_configuredFramePeriod > 0 ? m_configuredFramePeriod : m_estimatedFramePeriod;
+        m_frameDeadline =
+            deadlineAfter(lastFrame.callbackTime,
+                          framePeriod > 0 ? m_timeoutPeriods * framePeriod : FirstFrameTimeout);
+
+        // lock-free: the readers of the history never delay the processing
+        m_frameHistory.push(m_lastFrameRead.data());
     }
-    yDebug("Exiting thread");
+    // the listeners run on the processor thread, before the next frame is processed
+    notifyNewFrame();
 }
 
+namespace {
+    yarp::os::Stamp frameStamp(const xsens::XsensMVNSeqLock& frame)
+    {
+        return yarp::os::Stamp(static_cast<int>(frame.value(Layout::FrameNumberOffset)),
+                               frame.value(Layout::TimeOffset));
+    }
+
+    // Copy the values of a channel at bulkOffset of the blocks of a bulk buffer
+    void copyChannelToBulk(const xsens::XsensMVNSeqLock& frame,
+                           const xsens::XsensMVNFrameLayout& layout,
+                           const xsens::XsensMVNFrameLayout::Channel channel,
+                           double* buffer,
+                           const std::size_t bulkStride,
+                           const std::size_t bulkOffset)
+    {
+        const std::size_t width = Layout::channelWidth(channel);
+        std::size_t offset = layout.channelOffset(channel);
+        const std::size_t end = offset + layout.channelSize(channel);
+        for (double* block = buffer + bulkOffset; offset < end;
+             block += bulkStride, offset += width) {
+            for (unsigned k = 0; k < width; ++k) {
+                block[k] = frame.value(offset + k);
+            }
+        }
+    }
+} // namespace
+
 yarp::experimental::dev::IFrameProviderStatus
 yarp::dev::XsensMVN::XsensMVNPrivate::getLastSegmentReadTimestamp(yarp::os::Stamp& timestamp)
 {
-    std::lock_guard<std::mutex> readLock(m_dataMutex);
-    timestamp = m_lastTimestamp;
+    m_publishedFrame.read(
+        [&](const xsens::XsensMVNSeqLock& frame) { timestamp = frameStamp(frame); });
     return m_driverStatus;
 }
 
 yarp::experimental::dev::IIMUFrameProviderStatus
 yarp::dev::XsensMVN::XsensMVNPrivate::getLastSensorReadTimestamp(yarp::os::Stamp& timestamp)
 {
-    std::lock_guard<std::mutex> readLock(m_dataMutex);
-    timestamp = m_lastTimestamp;
-    return yarp::experimental::dev::IIMUFrameProviderStatus(static_cast<int>(m_driverStatus));
+    m_publishedFrame.read(
+        [&](const xsens::XsensMVNSeqLock& frame) { timestamp = frameStamp(frame); });
+    return yarp::experimental::dev::IIMUFrameProviderStatus(
+        static_cast<int>(m_driverStatus.load()));
 }
 
 yarp::experimental::dev::IFrameProviderStatus
@@ -581,43 +1022,42 @@ yarp::dev::XsensMVN::XsensMVNPrivate::getLastSegmentInformation(
     std::vector<yarp::sig::Vector>& lastVelocities,
     std::vector<yarp::sig::Vector>& lastAccelerations)
 {
+    const unsigned segmentCount = m_layout.segmentCount();
+    // the vectors of the disabled channels are left untouched
+    const unsigned channels = m_enabledChannels;
+    const bool pose = channels & yarp::experimental::dev::FrameChannelPose;
+    const bool velocity = channels & yarp::experimental::dev::FrameChannelVelocity;
+    const bool acceleration = channels & yarp::experimental::dev::FrameChannelAcceleration;
     // These also ensure all the sizes are the same
-    if (lastPoses.size() < m_lastSegmentPosesRead.size()) {
-        // This will cause an allocation
-        resizeVectorToOuterAndInnerSize(lastPoses, m_lastSegmentPosesRead.size(), 7);
+    if (pose) {
+        xsens::resizeChannelVectors(lastPoses, segmentCount, 7);
     }
-    if (lastVelocities.size() < m_lastSegmentPosesRead.size()) {
-        // This will cause an allocation
-        resizeVectorToOuterAndInnerSize(lastVelocities, m_lastSegmentPosesRead.size(), 6);
+    if (velocity) {
+        xsens::resizeChannelVectors(lastVelocities, segmentCount, 6);
     }
-    if (lastAccelerations.size() < m_lastSegmentPosesRead.size()) {
-        // This will cause an allocation
-        resizeVectorToOuterAndInnerSize(lastAccelerations, m_lastSegmentPosesRead.size(), 6);
+    if (acceleration) {
+        xsens::resizeChannelVectors(lastAccelerations, segmentCount, 6);
     }
 
-    {
-        std::lock_guard<std::mutex> readLock(m_dataMutex);
-
-        if (m_acquiring) {
-            // we should receive data
-            double now = yarp::os::Time::now();
-            if ((now - m_lastTimestamp.getTime()) > 1.0) {
-                m_driverStatus = yarp::experimental::dev::IFrameProviderStatusTimeout;
-            }
-            // yInfo("Reading data with time %lf at YARP Time %lf",
-            // m_lastSegmentTimestamp.getTime(), now);
-            /*else {
-                m_driverStatus = yarp::experimental::dev::IFrameProviderStatusOK;
-            }*/
+    // get anyway data out, without blocking the processor thread
+    m_publishedFrame.read([&](const xsens::XsensMVNSeqLock& frame) {
+        timestamp = frameStamp(frame);
+        if (pose) {
+            xsens::copyChannel(frame, m_layout, Layout::SegmentPositions, lastPoses);
+            xsens::copyChannel(frame, m_layout, Layout::SegmentOrientations, lastPoses, 3);
         }
-        // get anyway data out
-        timestamp = m_lastTimestamp;
-        for (unsigned i = 0; i < m_lastSegmentPosesRead.size(); ++i) {
-            lastPoses[i] = m_lastSegmentPosesRead[i];
-            lastVelocities[i] = m_lastSegmentVelocitiesRead[i];
-            lastAccelerations[i] = m_lastSegmentAccelerationRead[i];
+        if (velocity) {
+            xsens::copyChannel(frame, m_layout, Layout::SegmentLinearVelocities, lastVelocities);
+            xsens::copyChannel(
+                frame, m_layout, Layout::SegmentAngularVelocities, lastVelocities, 3);
         }
-    }
+        if (acceleration) {
+            xsens::copyChannel(
+                frame, m_layout, Layout::SegmentLinearAccelerations, lastAccelerations);
+            xsens::copyChannel(
+                frame, m_layout, Layout::SegmentAngularAccelerations, lastAccelerations, 3);
+        }
+    });
 
     return m_driverStatus;
 }
@@ -630,56 +1070,327 @@ yarp::dev::XsensMVN::XsensMVNPrivate::getLastSensorInformation(
     std::vector<yarp::sig::Vector>& lastAccelerations,
     std::vector<yarp::sig::Vector>& lastMagneticFields)
 {
+    const unsigned sensorCount = m_layout.sensorCount();
+    // the vectors of the disabled channels are left untouched
+    const unsigned channels = m_enabledChannels;
+    const bool orientation = channels & yarp::experimental::dev::FrameChannelIMUOrientation;
+    const bool velocity = channels & yarp::experimental::dev::FrameChannelIMUAngularVelocity;
+    const bool acceleration = channels & yarp::experimental::dev::FrameChannelIMULinearAcceleration;
+    const bool magneticField = channels & yarp::experimental::dev::FrameChannelIMUMagneticField;
     // These also ensure all the sizes are the same
-    if (lastOrientations.size() < m_lastSensorOrientationsRead.size()) {
-        // This will cause an allocation
-        resizeVectorToOuterAndInnerSize(lastOrientations, m_lastSensorOrientationsRead.size(), 4);
+    if (orientation) {
+        xsens::resizeChannelVectors(lastOrientations, sensorCount, 4);
     }
-    if (lastVelocities.size() < m_lastSensorVelocitiesRead.size()) {
-        // This will cause an allocation
-        resizeVectorToOuterAndInnerSize(lastVelocities, m_lastSensorVelocitiesRead.size(), 3);
+    if (velocity) {
+        xsens::resizeChannelVectors(lastVelocities, sensorCount, 3);
     }
-    if (lastAccelerations.size() < m_lastSensorAccelerationsRead.size()) {
-        // This will cause an allocation
-        resizeVectorToOuterAndInnerSize(lastAccelerations, m_lastSensorAccelerationsRead.size(), 3);
+    if (acceleration) {
+        xsens::resizeChannelVectors(lastAccelerations, sensorCount, 3);
     }
-    if (lastMagneticFields.size() < m_lastSensorMagneticFieldsRead.size()) {
-        // This will cause an allocation
-        resizeVectorToOuterAndInnerSize(
-            lastMagneticFields, m_lastSensorMagneticFieldsRead.size(), 3);
+    if (magneticField) {
+        xsens::resizeChannelVectors(lastMagneticFields, sensorCount, 3);
     }
 
-    {
-        std::lock_guard<std::mutex> readLock(m_dataMutex);
+    // get anyway data out, without blocking the processor thread
+    m_publishedFrame.read([&](const xsens::XsensMVNSeqLock& frame) {
+        timestamp = frameStamp(frame);
+        if (orientation) {
+            xsens::copyChannel(frame, m_layout, Layout::SensorOrientations, lastOrientations);
+        }
+        if (velocity) {
+            xsens::copyChannel(frame, m_layout, Layout::SensorAngularVelocities, lastVelocities);
+        }
+        if (acceleration) {
+            xsens::copyChannel(
+                frame, m_layout, Layout::SensorLinearAccelerations, lastAccelerations);
+        }
+        if (magneticField) {
+            xsens::copyChannel(frame, m_layout, Layout::SensorMagneticFields, lastMagneticFields);
+        }
+    });
 
-        if (m_acquiring) {
-            // we should receive data
-            double now = yarp::os::Time::now();
-            if ((now - m_lastTimestamp.getTime()) > 1.0) {
-                m_driverStatus = yarp::experimental::dev::IFrameProviderStatusTimeout;
-            }
-            // yInfo("Reading data with time %lf at YARP Time %lf",
-            // m_lastSegmentTimestamp.getTime(), now);
-            /*else {
-            m_driverStatus = yarp::experimental::dev::IFrameProviderStatusOK;
-            }*/
+    return yarp::experimental::dev::IIMUFrameProviderStatus(
+        static_cast<int>(m_driverStatus.load()));
+}
+
+yarp::experimental::dev::IFrameProviderStatus
+yarp::dev::XsensMVN::XsensMVNPrivate::getLastSegmentChannel(
+    const unsigned channel,
+    std::vector<yarp::sig::Vector>& lastValues)
+{
+    Layout::Channel linear;
+    Layout::Channel angular;
+    if (!(channel & yarp::experimental::dev::FrameChannelSegments)
+        || !layoutChannels(channel, linear, angular)) {
+        return yarp::experimental::dev::IFrameProviderStatusError;
+    }
+    if (!(m_enabledChannels & channel)) {
+        // the vectors of the disabled channels are left untouched
+        return m_driverStatus;
+    }
+
+    const std::size_t linearWidth = Layout::channelWidth(linear);
+    xsens::resizeChannelVectors(
+        lastValues, m_layout.segmentCount(), linearWidth + Layout::channelWidth(angular));
+    m_publishedFrame.read([&](const xsens::XsensMVNSeqLock& frame) {
+        xsens::copyChannel(frame, m_layout, linear, lastValues);
+        xsens::copyChannel(frame, m_layout, angular, lastValues, linearWidth);
+    });
+
+    return m_driverStatus;
+}
+
+yarp::experimental::dev::IIMUFrameProviderStatus
+yarp::dev::XsensMVN::XsensMVNPrivate::getLastSensorChannel(
+    const unsigned channel,
+    std::vector<yarp::sig::Vector>& lastValues)
+{
+    Layout::Channel layoutChannel;
+    Layout::Channel unused;
+    if (!(channel & yarp::experimental::dev::FrameChannelIMUs)
+        || !layoutChannels(channel, layoutChannel, unused)) {
+        return yarp::experimental::dev::IIMUFrameProviderStatusError;
+    }
+    // the vectors of the disabled channels are left untouched
+    if (m_enabledChannels & channel) {
+        xsens::resizeChannelVectors(
+            lastValues, m_layout.sensorCount(), Layout::channelWidth(layoutChannel));
+        m_publishedFrame.read([&](const xsens::XsensMVNSeqLock& frame) {
+            xsens::copyChannel(frame, m_layout, layoutChannel, lastValues);
+        });
+    }
+    return yarp::experimental::dev::IIMUFrameProviderStatus(
+        static_cast<int>(m_driverStatus.load()));
+}
+
+yarp::experimental::dev::IFrameProviderStatus
+yarp::dev::XsensMVN::XsensMVNPrivate::getLastSegmentBulk(double* buffer,
+                                                         const std::size_t bufferSize,
+                                                         yarp::os::Stamp& timestamp)
+{
+    using namespace yarp::experimental::dev;
+    if (bufferSize < m_layout.segmentCount() * FrameBulkStride) {
+        return IFrameProviderStatusError;
+    }
+    // the values of the disabled channels are left untouched
+    const unsigned channels = m_enabledChannels;
+    m_publishedFrame.read([&](const xsens::XsensMVNSeqLock& frame) {
+        timestamp = frameStamp(frame);
+        if (channels & FrameChannelPose) {
+            copyChannelToBulk(frame,
+                              m_layout,
+                              Layout::SegmentPositions,
+                              buffer,
+                              FrameBulkStride,
+                              FrameBulkPoseOffset);
+            copyChannelToBulk(frame,
+                              m_layout,
+                              Layout::SegmentOrientations,
+                              buffer,
+                              FrameBulkStride,
+                              FrameBulkPoseOffset + 3);
         }
-        // get anyway data out
-        timestamp = m_lastTimestamp;
-        for (unsigned i = 0; i < m_lastSensorOrientationsRead.size(); ++i) {
-            lastOrientations[i] = m_lastSensorOrientationsRead[i];
-            lastVelocities[i] = m_lastSensorVelocitiesRead[i];
-            lastAccelerations[i] = m_lastSensorAccelerationsRead[i];
-            lastMagneticFields[i] = m_lastSensorMagneticFieldsRead[i];
+        if (channels & FrameChannelVelocity) {
+            copyChannelToBulk(frame,
+                              m_layout,
+                              Layout::SegmentLinearVelocities,
+                              buffer,
+                              FrameBulkStride,
+                              FrameBulkVelocityOffset);
+            copyChannelToBulk(frame,
+                              m_layout,
+                              Layout::SegmentAngularVelocities,
+                              buffer,
+                              FrameBulkStride,
+                              FrameBulkVelocityOffset + 3);
         }
+        if (channels & FrameChannelAcceleration) {
+            copyChannelToBulk(frame,
+                              m_layout,
+                              Layout::SegmentLinearAccelerations,
+                              buffer,
+                              FrameBulkStride,
+                              FrameBulkAccelerationOffset);
+            copyChannelToBulk(frame,
+                              m_layout,
+                              Layout::SegmentAngularAccelerations,
+                              buffer,
+                              FrameBulkStride,
+                              FrameBulkAccelerationOffset + 3);
+        }
+    });
+    return m_driverStatus;
+}
+
+yarp::experimental::dev::IIMUFrameProviderStatus
+yarp::dev::XsensMVN::XsensMVNPrivate::getLastSensorBulk(double* buffer,
+                                                        const std::size_t bufferSize,
+                                                        yarp::os::Stamp& timestamp)
+{
+    using namespace yarp::experimental::dev;
+    if (bufferSize < m_layout.sensorCount() * IMUFrameBulkStride) {
+        return IIMUFrameProviderStatusError;
     }
-    return yarp::experimental::dev::IIMUFrameProviderStatus(static_cast<int>(m_driverStatus));
+    // the values of the disabled channels are left untouched
+    const unsigned channels = m_enabledChannels;
+    m_publishedFrame.read([&](const xsens::XsensMVNSeqLock& frame) {
+        timestamp = frameStamp(frame);
+        if (channels & FrameChannelIMUOrientation) {
+            copyChannelToBulk(frame,
+                              m_layout,
+                              Layout::SensorOrientations,
+                              buffer,
+                              IMUFrameBulkStride,
+                              IMUFrameBulkOrientationOffset);
+        }
+        if (channels & FrameChannelIMUAngularVelocity) {
+            copyChannelToBulk(frame,
+                              m_layout,
+                              Layout::SensorAngularVelocities,
+                              buffer,
+                              IMUFrameBulkStride,
+                              IMUFrameBulkAngularVelocityOffset);
+        }
+        if (channels & FrameChannelIMULinearAcceleration) {
+            copyChannelToBulk(frame,
+                              m_layout,
+                              Layout::SensorLinearAccelerations,
+                              buffer,
+                              IMUFrameBulkStride,
+                              IMUFrameBulkLinearAccelerationOffset);
+        }
+        if (channels & FrameChannelIMUMagneticField) {
+            copyChannelToBulk(frame,
+                              m_layout,
+                              Layout::SensorMagneticFields,
+                              buffer,
+                              IMUFrameBulkStride,
+                              IMUFrameBulkMagneticFieldOffset);
+        }
+    });
+    return IIMUFrameProviderStatus(static_cast<int>(m_driverStatus.load()));
+}
+
+xsens::XsensMVNFrameLayout yarp::dev::XsensMVN::XsensMVNPrivate::frameLayout() const
+{
+    return m_layout;
+}
+
+yarp::experimental::dev::IFrameProviderStatus
+yarp::dev::XsensMVN::XsensMVNPrivate::getLastFrameData(yarp::os::Stamp& timestamp,
+                                                       std::vector<double>& frameData)
+{
+    if (frameData.size() != m_publishedFrame.size()) {
+        // This will cause an allocation the first time
+        frameData.resize(m_publishedFrame.size());
+    }
+    // the whole frame is copied at once, header included
+    m_publishedFrame.read(frameData.data());
+    timestamp = yarp::os::Stamp(static_cast<int>(frameData[Layout::FrameNumberOffset]),
+                                frameData[Layout::TimeOffset]);
+    return m_driverStatus;
+}
+
+std::size_t
+yarp::dev::XsensMVN::XsensMVNPrivate::getFramesSince(const int lastFrameNumber,
+                                                     std::vector<double>& framesData)
+{
+    return m_frameHistory.copyFramesSince(lastFrameNumber, framesData);
+}
+
+bool yarp::dev::XsensMVN::XsensMVNPrivate::waitForNextFrame(const yarp::os::Stamp& lastStamp,
+                                                            const double timeout)
+{
+    const unsigned statusChanges = m_statusChanges;
+    std::unique_lock<std::mutex> newFrameLock(m_newFrameMutex);
+    return m_newFrameVariable.wait_for(
+        newFrameLock, std::chrono::duration<double>(timeout > 0 ? timeout : 0), [&]() {
+            yarp::os::Stamp timestamp;
+            getLastSegmentReadTimestamp(timestamp);
+            return timestamp.getCount() != lastStamp.getCount()
+                   || timestamp.getTime() != lastStamp.getTime()
+                   || m_statusChanges != statusChanges;
+        });
+}
+
+bool yarp::dev::XsensMVN::XsensMVNPrivate::addFrameListener(
+    yarp::experimental::dev::FrameListener& listener)
+{
+    return m_frameListeners.add(listener);
+}
+
+bool yarp::dev::XsensMVN::XsensMVNPrivate::removeFrameListener(
+    yarp::experimental::dev::FrameListener& listener)
+{
+    return m_frameListeners.remove(listener);
+}
+
+bool yarp::dev::XsensMVN::XsensMVNPrivate::setEnabledChannels(const unsigned channels)
+{
+    if ((channels & ~static_cast<unsigned>(yarp::experimental::dev::FrameChannelAll)) != 0) {
+        yError("Invalid channel mask 0x%x", channels);
+        return false;
+    }
+    std::lock_guard<std::mutex> writeLock(m_dataMutex);
+    m_enabledChannels = channels;
+    if (m_lastFrameRead.size() != m_layout.size()) {
+        // model not loaded yet, nothing published
+        return true;
+    }
+    // the disabled channels are not updated anymore: clear them instead of leaving stale values
+    double* frame = m_lastFrameRead.data();
+    for (int channel = 0; channel < Layout::ChannelCount; ++channel) {
+        const Layout::Channel layoutChannel = static_cast<Layout::Channel>(channel);
+        if (!(channels & frameChannel(layoutChannel))) {
+            double* begin = frame + m_layout.channelOffset(layoutChannel);
+            std::fill(begin, begin + m_layout.channelSize(layoutChannel), 0.0);
+        }
+    }
+    m_publishedFrame.write(m_lastFrameRead.data());
+    return true;
+}
+
+unsigned yarp::dev::XsensMVN::XsensMVNPrivate::enabledChannels() const
+{
+    return m_enabledChannels;
+}
+
+std::vector<yarp::experimental::dev::LatencyStatistics>
+yarp::dev::XsensMVN::XsensMVNPrivate::latencyStatistics() const
+{
+    std::vector<yarp::experimental::dev::LatencyStatistics> statistics;
+    statistics.push_back(m_poseToCallbackLatency.statistics("driver/pose-to-callback"));
+    statistics.push_back(m_callbackToProcessedLatency.statistics("driver/callback-to-processed"));
+    statistics.push_back(m_processingJitter.statistics("driver/processing-jitter"));
+    return statistics;
+}
+
+void yarp::dev::XsensMVN::XsensMVNPrivate::resetLatencyStatistics()
+{
+    m_poseToCallbackLatency.reset();
+    m_callbackToProcessedLatency.reset();
+    m_processingJitter.reset();
+}
+
+std::vector<yarp::experimental::dev::FrameContinuityStatistics>
+yarp::dev::XsensMVN::XsensMVNPrivate::frameContinuityStatistics() const
+{
+    std::vector<yarp::experimental::dev::FrameContinuityStatistics> statistics;
+    statistics.push_back(m_frameContinuity.statistics("driver"));
+    return statistics;
+}
+
+void yarp::dev::XsensMVN::XsensMVNPrivate::resetFrameContinuityStatistics()
+{
+    m_frameContinuity.reset();
 }
 
 // Callback functions
 void yarp::dev::XsensMVN::XsensMVNPrivate::onHardwareReady(XmeControl* dev)
 {
     yInfo("Ready");
+    // the sensors reported by the suit status may have changed
+    notifyModelChange();
     std::unique_lock<std::mutex> lock(m_initializationMutex);
     m_hardwareFound = true;
     m_initializationVariable.notify_one();
@@ -695,21 +1406,31 @@ void yarp::dev::XsensMVN::XsensMVNPrivate::onHardwareError(XmeControl* dev)
 
 void yarp::dev::XsensMVN::XsensMVNPrivate::onPoseReady(XmeControl* dev)
 {
-    FrameData newFrame;
-    newFrame.pose = dev->pose(XME_LAST_AVAILABLE_FRAME);
-    newFrame.sensorsData = dev->sampleData(XME_LAST_AVAILABLE_FRAME);
+    // This runs on the SDK thread: data are copied without locks directly into a preallocated slot
+    FrameData* newFrame = m_frameBuffer.beginWrite();
+    if (!newFrame) {
+        // buffer full, the overrun is counted by the buffer and reported by the processor
+        return;
+    }
+    newFrame->callbackTime = std::chrono::steady_clock::now();
+    newFrame->pose = dev->pose(XME_LAST_AVAILABLE_FRAME);
+    newFrame->sensorsData = dev->sampleData(XME_LAST_AVAILABLE_FRAME);
+    // the SDK time is the system time (ms from epoch), as yarp::os::Time
+    m_poseToCallbackLatency.record(yarp::os::Time::now()
+                                   - newFrame->pose.m_absoluteTime / 1000.0);
     // or suitSample (int frameNumber)??
-
-    std::unique_lock<std::mutex> lock(m_processorGuard);
-    // copy data into processor queue
-    m_lastFrameData = std::move(newFrame);
-    m_lastFrameDataWritten = true;
-    m_processorVariable.notify_one();
+    m_frameBuffer.commitWrite();
+    // pairs with the fence of the processor (see processNewFrame): no lock is taken here
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_processorSleeping.load(std::memory_order_relaxed)) {
+        m_processorVariable.notify_one();
+    }
 }
 
 void yarp::dev::XsensMVN::XsensMVNPrivate::onHardwareDisconnected(XmeControl*)
 {
     yInfo("Suit disconnected");
+    notifyModelChange();
     std::unique_lock<std::mutex> lock(m_initializationMutex);
     m_hardwareFound = false;
     m_initializationVariable.notify_one();
@@ -722,11 +1443,38 @@ void yarp::dev::XsensMVN::XsensMVNPrivate::calibratorHasReceivedNewCalibrationPo
     // only manage my own calibrator
     if (sender != m_calibrator)
         return;
-    std::lock_guard<std::mutex> readLock(m_dataMutex);
+    {
+        std::lock_guard<std::mutex> writeLock(m_dataMutex);
+        publishCalibrationPose(newPose);
+    }
+    // each pose is a new frame for the waiters, the listeners and the wrapper
+    notifyNewFrame();
+}
 
-    for (unsigned index = 0; index < newPose.size(); ++index) {
-        m_lastSegmentPosesRead[index] = newPose[index];
-        m_lastSegmentVelocitiesRead[index].zero();
-        m_lastSegmentAccelerationRead[index].zero();
+void yarp::dev::XsensMVN::XsensMVNPrivate::publishCalibrationPose(
+    const std::vector<yarp::sig::Vector>& newPose)
+{
+    double* frame = m_lastFrameRead.data();
+    // the poses carry no SDK stamp: a count of their own and the time of their arrival, so that
+    // they are not taken for an unchanged frame
+    frame[Layout::FrameNumberOffset] = ++m_calibrationPoseCount;
+    frame[Layout::TimeOffset] = yarp::os::Time::now();
+    double* positions = frame + m_layout.channelOffset(Layout::SegmentPositions);
+    double* orientations = frame + m_layout.channelOffset(Layout::SegmentOrientations);
+    for (unsigned index = 0; index < newPose.size() && index < m_layout.segmentCount(); ++index) {
+        if (newPose[index].size() < 7) {
+            continue;
+        }
+        for (unsigned k = 0; k < 3; ++k) {
+            positions[3 * index + k] = newPose[index](k);
+        }
+        for (unsigned k = 0; k < 4; ++k) {
+            orientations[4 * index + k] = newPose[index](3 + k);
+        }
     }
+    // velocities and accelerations are zero
+    std::fill(frame + m_layout.channelOffset(Layout::SegmentLinearVelocities),
+              frame + m_layout.channelOffset(Layout::SensorOrientations),
+              0.0);
+    m_publishedFrame.write(m_lastFrameRead.data());
 }
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "XsensMVNChannelCopy.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <thread>
+#include <vector>
+
+// Single-channel getters of the driver on a simulated suit, which publishes frames at 240 Hz:
+// the per-channel copy into reused vectors, against the former path that built dummy vectors for
+// the other channels and copied all of them. std::vector<double> stands for yarp::sig::Vector,
+// which allocates its values on the heap in the same way.
+
+namespace {
+    std::atomic<unsigned long> allocationCount(0);
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+typedef xsens::XsensMVNFrameLayout Layout;
+typedef std::vector<double> Vector;
+
+namespace {
+    // former getFramePoses: the combined getter on two dummy vectors
+    void readPosesWithDummies(const xsens::XsensMVNSeqLock& frame,
+                              const Layout& layout,
+                              std::vector<Vector>& poses)
+    {
+        std::vector<Vector> dummyVelocities;
+        std::vector<Vector> dummyAccelerations;
+        xsens::resizeChannelVectors(poses, layout.segmentCount(), 7);
+        xsens::resizeChannelVectors(dummyVelocities, layout.segmentCount(), 6);
+        xsens::resizeChannelVectors(dummyAccelerations, layout.segmentCount(), 6);
+        frame.read([&](const xsens::XsensMVNSeqLock& values) {
+            xsens::copyChannel(values, layout, Layout::SegmentPositions, poses);
+            xsens::copyChannel(values, layout, Layout::SegmentOrientations, poses, 3);
+            xsens::copyChannel(values, layout, Layout::SegmentLinearVelocities, dummyVelocities);
+            xsens::copyChannel(
+                values, layout, Layout::SegmentAngularVelocities, dummyVelocities, 3);
+            xsens::copyChannel(
+                values, layout, Layout::SegmentLinearAccelerations, dummyAccelerations);
+            xsens::copyChannel(
+                values, layout, Layout::SegmentAngularAccelerations, dummyAccelerations, 3);
+        });
+    }
+
+    // getLastSegmentChannel(FrameChannelPose)
+    void readPoses(const xsens::XsensMVNSeqLock& frame,
+                   const Layout& layout,
+                   std::vector<Vector>& poses)
+    {
+        xsens::resizeChannelVectors(poses, layout.segmentCount(), 7);
+        frame.read([&](const xsens::XsensMVNSeqLock& values) {
+            xsens::copyChannel(values, layout, Layout::SegmentPositions, poses);
+            xsens::copyChannel(values, layout, Layout::SegmentOrientations, poses, 3);
+        });
+    }
+
+    struct Result
+    {
+        double nanosecondsPerCall;
+        double allocationsPerCall;
+    };
+
+    template <typename Read>
+    Result measure(Read read, const unsigned long calls)
+    {
+        // first call out of the measure: it sizes the vectors of the caller
+        read();
+        const unsigned long allocations = allocationCount.load();
+        const auto start = std::chrono::steady_clock::now();
+        for (unsigned long call = 0; call < calls; ++call) {
+            read();
+        }
+        const auto end = std::chrono::steady_clock::now();
+        Result result;
+        result.nanosecondsPerCall =
+            std::chrono::duration<double, std::nano>(end - start).count() / calls;
+        result.allocationsPerCall =
+            static_cast<double>(allocationCount.load() - allocations) / calls;
+        return result;
+    }
+} // namespace
+
+int main()
+{
+    const Layout layout(23, 17);
+    const unsigned long calls = 200000;
+
+    // simulated suit: every value of a frame is its frame number
+    xsens::XsensMVNSeqLock frame(layout.size());
+    std::atomic<bool> stop(false);
+    std::thread suit([&]() {
+        std::vector<double> values(layout.size());
+        const std::chrono::microseconds period(1000000 / 240);
+        auto next = std::chrono::steady_clock::now();
+        for (double frameNumber = 0; !stop.load(); ++frameNumber) {
+            for (double& value : values) {
+                value = frameNumber;
+            }
+            frame.write(values.data());
+            next += period;
+            std::this_thread::sleep_until(next);
+        }
+    });
+
+    // vectors reused from a larger model are shrunk to the segments of the frame
+    std::vector<Vector> poses(30, Vector(3));
+    readPoses(frame, layout, poses);
+    if (poses.size() != layout.segmentCount() || poses.back().size() != 7) {
+        std::cerr << "The poses are not sized as the segments of the frame" << std::endl;
+        stop = true;
+        suit.join();
+        return EXIT_FAILURE;
+    }
+
+    const Result withDummies =
+        measure([&]() { readPosesWithDummies(frame, layout, poses); }, calls);
+    const Result perChannel = measure([&]() { readPoses(frame, layout, poses); }, calls);
+    stop = true;
+    suit.join();
+
+    std::cout << "poses of 23 segments, " << calls << " calls" << std::endl;
+    std::cout << "  with dummy vectors: " << withDummies.nanosecondsPerCall << " ns, "
+              << withDummies.allocationsPerCall << " allocations per call" << std::endl;
+    std::cout << "  single channel:     " << perChannel.nanosecondsPerCall << " ns, "
+              << perChannel.allocationsPerCall << " allocations per call" << std::endl;
+
+    if (perChannel.allocationsPerCall != 0) {
+        std::cerr << "The single channel read allocates on reused vectors" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "OK" << std::endl;
+    return EXIT_SUCCESS;
+}
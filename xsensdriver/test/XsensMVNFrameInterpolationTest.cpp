@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "XsensMVNFrameInterpolation.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+typedef std::vector<double> Vector;
+typedef xsens::XsensMVNPublishedFrame Published;
+
+namespace {
+    const double Tolerance = 1e-9;
+    // hold the newest frame for one frame period
+    const double OnePeriod = -1;
+
+    bool near(const double value, const double expected)
+    {
+        return std::abs(value - expected) < Tolerance;
+    }
+
+    bool nearQuaternion(
+        const double* q, const double w, const double x, const double y, const double z)
+    {
+        return near(q[0], w) && near(q[1], x) && near(q[2], y) && near(q[3], z);
+    }
+
+    // Published segments frame of segmentCount segments at time: segment s has position
+    // (value + s, 0, 0), orientation angle * (s + 1) about z, and velocities and accelerations all
+    // equal to value
+    std::vector<double> segmentsFrame(const unsigned segmentCount,
+                                      const double time,
+                                      const double value,
+                                      const double angle)
+    {
+        const std::size_t size = Published::DataOffset + segmentCount * xsens::SegmentBlockStride;
+        std::vector<double> frame(size, value);
+        frame[Published::StampCountOffset] = time;
+        frame[Published::StampTimeOffset] = time;
+        frame[Published::StatusOffset] = 0;
+        for (unsigned s = 0; s < segmentCount; ++s) {
+            double* pose = frame.data() + Published::DataOffset + s * xsens::SegmentBlockStride
+                           + xsens::SegmentBlockPoseOffset;
+            pose[0] = value + s;
+            pose[1] = 0;
+            pose[2] = 0;
+            pose[3] = std::cos(angle * (s + 1) / 2);
+            pose[4] = 0;
+            pose[5] = 0;
+            pose[6] = std::sin(angle * (s + 1) / 2);
+        }
+        return frame;
+    }
+} // namespace
+
+// Endpoints, midpoint, shortest arc and close quaternions
+bool check_slerp()
+{
+    const double pi = std::acos(-1.0);
+    const double identity[4] = {1, 0, 0, 0};
+    // 90 degrees about z
+    const double quarter[4] = {std::cos(pi / 4), 0, 0, std::sin(pi / 4)};
+    const double minusQuarter[4] = {-quarter[0], 0, 0, -quarter[3]};
+    double result[4];
+
+    xsens::slerp(identity, quarter, 0.0, result);
+    if (!nearQuaternion(result, 1, 0, 0, 0)) {
+        std::cerr << "slerp at 0 is not the first quaternion" << std::endl;
+        return false;
+    }
+    xsens::slerp(identity, quarter, 1.0, result);
+    if (!nearQuaternion(result, quarter[0], 0, 0, quarter[3])) {
+        std::cerr << "slerp at 1 is not the second quaternion" << std::endl;
+        return false;
+    }
+    // 45 degrees about z
+    xsens::slerp(identity, quarter, 0.5, result);
+    if (!nearQuaternion(result, std::cos(pi / 8), 0, 0, std::sin(pi / 8))) {
+        std::cerr << "slerp at 0.5 is not the half rotation" << std::endl;
+        return false;
+    }
+    // -q is the same rotation as q: the shortest arc gives the same half rotation
+    xsens::slerp(identity, minusQuarter, 0.5, result);
+    if (!nearQuaternion(result, std::cos(pi / 8), 0, 0, std::sin(pi / 8))) {
+        std::cerr << "slerp does not follow the shortest arc" << std::endl;
+        return false;
+    }
+    // close quaternions: the normalised linear interpolation stays unit
+    const double close[4] = {std::cos(1e-4), 0, 0, std::sin(1e-4)};
+    xsens::slerp(identity, close, 0.5, result);
+    if (!nearQuaternion(result, std::cos(0.5e-4), 0, 0, std::sin(0.5e-4))) {
+        std::cerr << "slerp of close quaternions is wrong" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// The frames around a time are found in the history and interpolated, and times older than the
+// history have no data
+bool check_interpolate_frame_at()
+{
+    const double pi = std::acos(-1.0);
+    const unsigned segmentCount = 2;
+    xsens::XsensMVNFrameHistory history;
+    std::vector<Vector> poses;
+    std::vector<Vector> velocities;
+    std::vector<Vector> accelerations;
+
+    history.reset(Published::DataOffset + segmentCount * xsens::SegmentBlockStride, 4);
+    if (xsens::interpolateFrameAt(history, 1.0, OnePeriod, poses, velocities, accelerations)
+        != xsens::FrameAtBeforeHistory) {
+        std::cerr << "An empty history returned a frame" << std::endl;
+        return false;
+    }
+
+    // frames at 1, 2 and 4 s, turning by 90 degrees per frame
+    history.push(segmentsFrame(segmentCount, 1.0, 10, 0).data());
+    history.push(segmentsFrame(segmentCount, 2.0, 20, pi / 2).data());
+    history.push(segmentsFrame(segmentCount, 4.0, 40, pi).data());
+
+    if (xsens::interpolateFrameAt(history, 0.5, OnePeriod, poses, velocities, accelerations)
+        != xsens::FrameAtBeforeHistory) {
+        std::cerr << "A time older than the history returned a frame" << std::endl;
+        return false;
+    }
+
+    // a quarter of the way from the frame at 2 s to the frame at 4 s
+    // output vectors of other sizes are resized to the segments of the history
+    poses.assign(5, Vector(3));
+    if (xsens::interpolateFrameAt(history, 2.5, OnePeriod, poses, velocities, accelerations)
+            != xsens::FrameAtFound
+        || poses.size() != segmentCount || velocities.size() != segmentCount
+        || accelerations.size() != segmentCount || poses[1].size() != 7
+        || velocities[1].size() != 6 || accelerations[1].size() != 6) {
+        std::cerr << "The interpolated frame does not have the segments of the history"
+                  << std::endl;
+        return false;
+    }
+    for (unsigned s = 0; s < segmentCount; ++s) {
+        // orientations from angle (s + 1) * pi / 2 to (s + 1) * pi about z
+        const double angle = (s + 1) * (pi / 2 + 0.25 * pi / 2);
+        const double w = std::cos(angle / 2);
+        const double z = std::sin(angle / 2);
+        // q and -q are the same rotation
+        const double* orientation = poses[s].data() + 3;
+        const bool sameRotation = nearQuaternion(orientation, w, 0, 0, z)
+                                  || nearQuaternion(orientation, -w, 0, 0, -z);
+        if (!near(poses[s][0], 25 + s) || !near(poses[s][1], 0) || !sameRotation) {
+            std::cerr << "Wrong interpolated pose of segment " << s << std::endl;
+            return false;
+        }
+        for (unsigned k = 0; k < 6; ++k) {
+            if (!near(velocities[s][k], 25) || !near(accelerations[s][k], 25)) {
+                std::cerr << "Wrong interpolated velocity or acceleration of segment " << s
+                          << std::endl;
+                return false;
+            }
+        }
+    }
+
+    // exactly on a frame
+    if (xsens::interpolateFrameAt(history, 2.0, OnePeriod, poses, velocities, accelerations)
+            != xsens::FrameAtFound
+        || !near(poses[0][0], 20) || !near(velocities[1][5], 20)) {
+        std::cerr << "A time on a frame does not return the frame" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// After the newest frame the newest frame is held, not extrapolated, for the hold time only
+bool check_hold_newest_frame()
+{
+    const unsigned segmentCount = 2;
+    xsens::XsensMVNFrameHistory history;
+    std::vector<Vector> poses;
+    std::vector<Vector> velocities;
+    std::vector<Vector> accelerations;
+    history.reset(Published::DataOffset + segmentCount * xsens::SegmentBlockStride, 4);
+
+    // a single frame: no frame period, only its own time
+    history.push(segmentsFrame(segmentCount, 2.0, 20, 0).data());
+    if (xsens::interpolateFrameAt(history, 2.0, OnePeriod, poses, velocities, accelerations)
+            != xsens::FrameAtFound
+        || xsens::interpolateFrameAt(history, 2.001, OnePeriod, poses, velocities, accelerations)
+               != xsens::FrameAtAfterHistory) {
+        std::cerr << "A single frame is held after it" << std::endl;
+        return false;
+    }
+
+    // frames at 2 and 4 s: held for 2 s, the last frame period
+    history.push(segmentsFrame(segmentCount, 4.0, 40, 0).data());
+    if (xsens::interpolateFrameAt(history, 5.5, OnePeriod, poses, velocities, accelerations)
+            != xsens::FrameAtFound
+        || !near(poses[0][0], 40) || !near(poses[1][0], 41) || !near(accelerations[0][0], 40)) {
+        std::cerr << "The newest frame is not held within a frame period" << std::endl;
+        return false;
+    }
+    if (xsens::interpolateFrameAt(history, 6.5, OnePeriod, poses, velocities, accelerations)
+        != xsens::FrameAtAfterHistory) {
+        std::cerr << "The newest frame is held after a frame period" << std::endl;
+        return false;
+    }
+    // a stalled stream: the newest frame is not current anymore
+    if (xsens::interpolateFrameAt(history, 10.0, OnePeriod, poses, velocities, accelerations)
+        != xsens::FrameAtAfterHistory) {
+        std::cerr << "The newest frame is held forever" << std::endl;
+        return false;
+    }
+
+    // a given hold time
+    if (xsens::interpolateFrameAt(history, 4.05, 0.1, poses, velocities, accelerations)
+            != xsens::FrameAtFound
+        || xsens::interpolateFrameAt(history, 4.2, 0.1, poses, velocities, accelerations)
+               != xsens::FrameAtAfterHistory
+        || xsens::interpolateFrameAt(history, 4.0, 0, poses, velocities, accelerations)
+               != xsens::FrameAtFound
+        || xsens::interpolateFrameAt(history, 4.001, 0, poses, velocities, accelerations)
+               != xsens::FrameAtAfterHistory) {
+        std::cerr << "The newest frame is not held for the given hold time" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main()
+{
+    if (!check_slerp() || !check_interpolate_frame_at() || !check_hold_newest_frame()) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "OK" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "XsensMVNFrameSignal.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+typedef xsens::XsensMVNPublishedFrame PublishedFrame;
+
+namespace {
+    const int StatusOK = 0;
+    const int StatusTimeout = 4;
+    // long enough not to expire in the tests that must wake up
+    const double LongTimeout = 10.0;
+
+    // Publish a frame of the given stamp and status, and notify it
+    void publish(PublishedFrame& published,
+                 xsens::XsensMVNFrameSignal& signal,
+                 const double count,
+                 const double time,
+                 const int status)
+    {
+        double* buffer = published.beginWrite();
+        buffer[PublishedFrame::StampCountOffset] = count;
+        buffer[PublishedFrame::StampTimeOffset] = time;
+        buffer[PublishedFrame::StatusOffset] = status;
+        published.commitWrite();
+        signal.notify(status);
+    }
+
+    // Runs waitForNextFrame(lastCount, lastTime, timeout) in a thread while the main thread calls
+    // write() once the waiter started. Returns the result of the wait, and its duration in
+    // seconds in elapsed
+    template <typename WriteFunction>
+    bool waitWhile(PublishedFrame& published,
+                   xsens::XsensMVNFrameSignal& signal,
+                   const double lastCount,
+                   const double lastTime,
+                   const double timeout,
+                   WriteFunction write,
+                   double& elapsed)
+    {
+        std::atomic<bool> started(false);
+        bool woken = false;
+        std::thread waiter([&]() {
+            const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            started = true;
+            woken = signal.waitForNextFrame(published, lastCount, lastTime, timeout);
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+                          .count();
+        });
+        while (!started) {
+            std::this_thread::yield();
+        }
+        // let the waiter reach the wait: waking it earlier must work too, through the check
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        write();
+        waiter.join();
+        return woken;
+    }
+} // namespace
+
+// A frame with a new stamp wakes the waiter, a stamp already newer returns at once
+bool check_new_stamp()
+{
+    PublishedFrame published(StatusOK);
+    xsens::XsensMVNFrameSignal signal(StatusOK);
+    publish(published, signal, 1, 0.01, StatusOK);
+
+    double elapsed = 0;
+    const bool woken = waitWhile(
+        published,
+        signal,
+        1,
+        0.01,
+        LongTimeout,
+        [&]() { publish(published, signal, 2, 0.02, StatusOK); },
+        elapsed);
+    if (!woken || elapsed >= LongTimeout / 2) {
+        std::cerr << "A new stamp woke the waiter: " << woken << " after " << elapsed << " s"
+                  << std::endl;
+        return false;
+    }
+
+    // same count, other time: also a new frame
+    publish(published, signal, 2, 0.03, StatusOK);
+    if (!signal.waitForNextFrame(published, 2, 0.02, 0)) {
+        std::cerr << "A frame of a new time is not seen" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// A status change wakes the waiter even if the stamp is the same
+bool check_status_change()
+{
+    PublishedFrame published(StatusOK);
+    xsens::XsensMVNFrameSignal signal(StatusOK);
+    publish(published, signal, 1, 0.01, StatusOK);
+
+    double elapsed = 0;
+    const bool woken = waitWhile(
+        published,
+        signal,
+        1,
+        0.01,
+        LongTimeout,
+        [&]() { publish(published, signal, 1, 0.01, StatusTimeout); },
+        elapsed);
+    if (!woken || elapsed >= LongTimeout / 2) {
+        std::cerr << "A status change woke the waiter: " << woken << " after " << elapsed << " s"
+                  << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Without a new stamp or status the wait lasts the timeout, and notifications of the same frame
+// do not end it
+bool check_timeout()
+{
+    PublishedFrame published(StatusOK);
+    xsens::XsensMVNFrameSignal signal(StatusOK);
+    publish(published, signal, 1, 0.01, StatusOK);
+
+    const double timeout = 0.3;
+    double elapsed = 0;
+    const bool woken = waitWhile(
+        published,
+        signal,
+        1,
+        0.01,
+        timeout,
+        [&]() { publish(published, signal, 1, 0.01, StatusOK); },
+        elapsed);
+    if (woken || elapsed < timeout * 0.9) {
+        std::cerr << "An unchanged frame woke the waiter: " << woken << " after " << elapsed
+                  << " s" << std::endl;
+        return false;
+    }
+
+    // a zero or negative timeout only checks
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (signal.waitForNextFrame(published, 1, 0.01, 0)
+        || signal.waitForNextFrame(published, 1, 0.01, -1)) {
+        std::cerr << "An unchanged frame is seen as new" << std::endl;
+        return false;
+    }
+    elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (elapsed > 0.1) {
+        std::cerr << "A wait of no timeout lasted " << elapsed << " s" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main()
+{
+    if (!check_new_stamp() || !check_status_change() || !check_timeout()) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "OK" << std::endl;
+    return EXIT_SUCCESS;
+}
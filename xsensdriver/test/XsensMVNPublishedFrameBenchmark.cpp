@@ -0,0 +1,305 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "XsensMVNPublishedFrame.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Port thread of a remote against the getters, the published frame against the former scheme,
+// where the decode and the copies took the same mutex. Two runs:
+// - latency: the writer publishes a frame every millisecond (above the rate of the suit) while
+//   slow readers copy the last frame in a loop, and each write is timed. This is what the
+//   published frame is for: a slow reader must not delay the port thread. The published frame
+//   must keep the 99th percentile of its writes below the time a slow reader holds a frame,
+//   which the mutex cannot;
+// - saturation: the writer decodes frames as fast as it can and resizes them now and then (a
+//   model change). Reported only: there the published frame writes each frame twice (in the
+//   back buffer, then in the seqlock) and its readers retry the copies a write overlaps, so it
+//   is expected to be slower than the mutex, which lets its holder take it again.
+// Every frame copied must be whole: all its values equal its frame number.
+
+typedef xsens::XsensMVNPublishedFrame Published;
+
+namespace {
+    // full-body frames of 23 and 17 segments, in the layout of the remotes
+    const std::size_t DataSizes[] = {23 * 19, 17 * 19};
+    const unsigned long FramesPerModel = 1000;
+    // latency run: write period, frames written, and the time a slow reader spends in a copy
+    const std::chrono::microseconds WritePeriod(1000);
+    const unsigned LatencyFrames = 2000;
+    const std::chrono::microseconds SlowCopy(300);
+
+    struct Result
+    {
+        double writesPerSecond;
+        double readsPerSecond;
+        unsigned long tornCount;
+    };
+
+    struct Latency
+    {
+        double median;
+        double percentile99;
+        double max;
+        unsigned long tornCount;
+    };
+
+    // Keeps a reader busy for duration, as a consumer converting each value or preempted in its
+    // copy
+    void spin(const std::chrono::microseconds duration)
+    {
+        const auto end = std::chrono::steady_clock::now() + duration;
+        while (std::chrono::steady_clock::now() < end) {
+        }
+    }
+
+    // A resize publishes zeros with the header of the last frame
+    bool isWhole(const std::vector<double>& frame)
+    {
+        const double number = frame[Published::StampCountOffset];
+        const double data = frame.size() > Published::DataOffset && frame.back() == 0 ? 0 : number;
+        const bool sizeKnown = std::any_of(
+            std::begin(DataSizes), std::end(DataSizes), [&](const std::size_t size) {
+                return frame.size() == Published::DataOffset + size;
+            });
+        return sizeKnown && frame[Published::StampTimeOffset] == number
+               && std::all_of(frame.begin() + Published::DataOffset,
+                              frame.end(),
+                              [&](const double value) { return value == data; });
+    }
+
+    // Decode and publish under the mutex of the readers, as the remotes did
+    class LockedFrame
+    {
+        mutable std::mutex m_mutex;
+        std::vector<double> m_frame;
+
+    public:
+        void resize(const std::size_t dataSize)
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            m_frame.resize(Published::DataOffset);
+            m_frame.resize(Published::DataOffset + dataSize, 0.0);
+        }
+
+        void write(const double frameNumber)
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            std::fill(m_frame.begin(), m_frame.end(), frameNumber);
+        }
+
+        void copy(std::vector<double>& frame,
+                  const std::chrono::microseconds slowness = std::chrono::microseconds(0)) const
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            frame = m_frame;
+            spin(slowness);
+        }
+    };
+
+    class PublishedFrame
+    {
+        Published m_published;
+
+    public:
+        PublishedFrame()
+            : m_published(0)
+        {}
+
+        void resize(const std::size_t dataSize) { m_published.resize(dataSize); }
+
+        void write(const double frameNumber)
+        {
+            double* frame = m_published.beginWrite();
+            const std::size_t size = Published::DataOffset + m_published.writeDataSize();
+            std::fill(frame, frame + size, frameNumber);
+            m_published.commitWrite();
+        }
+
+        void copy(std::vector<double>& frame,
+                  const std::chrono::microseconds slowness = std::chrono::microseconds(0)) const
+        {
+            m_published.read([&](const xsens::XsensMVNSeqLock& published) {
+                frame.resize(published.size());
+                for (std::size_t i = 0; i < published.size(); ++i) {
+                    frame[i] = published.value(i);
+                }
+                spin(slowness);
+            });
+        }
+
+        std::size_t replacedCount() const { return m_published.replacedCount(); }
+    };
+
+    template <typename Frame>
+    Result measure(Frame& frame, const unsigned readerCount, const std::chrono::seconds duration)
+    {
+        frame.resize(DataSizes[0]);
+        frame.write(0);
+        std::atomic<bool> stop(false);
+        std::atomic<unsigned long> readCount(0);
+        std::atomic<unsigned long> tornCount(0);
+
+        std::vector<std::thread> readers;
+        for (unsigned r = 0; r < readerCount; ++r) {
+            readers.emplace_back([&]() {
+                std::vector<double> copy;
+                unsigned long reads = 0;
+                unsigned long torn = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    frame.copy(copy);
+                    if (!isWhole(copy)) {
+                        ++torn;
+                    }
+                    ++reads;
+                }
+                readCount.fetch_add(reads);
+                tornCount.fetch_add(torn);
+            });
+        }
+
+        unsigned long writes = 0;
+        const auto start = std::chrono::steady_clock::now();
+        const auto end = start + duration;
+        while (std::chrono::steady_clock::now() < end) {
+            for (unsigned long i = 0; i < FramesPerModel; ++i) {
+                frame.write(static_cast<double>(++writes));
+            }
+            frame.resize(DataSizes[(writes / FramesPerModel) % 2]);
+        }
+        const double elapsed =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        stop = true;
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        // the writer frees the replaced frames once no reader is in flight
+        frame.write(static_cast<double>(++writes));
+
+        Result result;
+        result.writesPerSecond = writes / elapsed;
+        result.readsPerSecond = readCount / elapsed;
+        result.tornCount = tornCount;
+        return result;
+    }
+
+    // Writes LatencyFrames frames, one every WritePeriod, while readerCount slow readers copy
+    // them, and returns the distribution of the write times in microseconds
+    template <typename Frame>
+    Latency measureLatency(Frame& frame, const unsigned readerCount)
+    {
+        frame.resize(DataSizes[0]);
+        frame.write(0);
+        std::atomic<bool> stop(false);
+        std::atomic<unsigned long> tornCount(0);
+
+        std::vector<std::thread> readers;
+        for (unsigned r = 0; r < readerCount; ++r) {
+            readers.emplace_back([&]() {
+                std::vector<double> copy;
+                unsigned long torn = 0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    frame.copy(copy, SlowCopy);
+                    if (!isWhole(copy)) {
+                        ++torn;
+                    }
+                    // the next call of the consumer
+                    std::this_thread::sleep_for(SlowCopy / 3);
+                }
+                tornCount.fetch_add(torn);
+            });
+        }
+
+        std::vector<double> writeTimes;
+        writeTimes.reserve(LatencyFrames);
+        auto next = std::chrono::steady_clock::now();
+        for (unsigned long i = 1; i <= LatencyFrames; ++i) {
+            next += WritePeriod;
+            std::this_thread::sleep_until(next);
+            const auto start = std::chrono::steady_clock::now();
+            frame.write(static_cast<double>(i));
+            writeTimes.push_back(std::chrono::duration<double, std::micro>(
+                                     std::chrono::steady_clock::now() - start)
+                                     .count());
+        }
+        stop = true;
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        frame.write(static_cast<double>(LatencyFrames + 1));
+
+        std::sort(writeTimes.begin(), writeTimes.end());
+        Latency latency;
+        latency.median = writeTimes[writeTimes.size() / 2];
+        latency.percentile99 = writeTimes[writeTimes.size() * 99 / 100];
+        latency.max = writeTimes.back();
+        latency.tornCount = tornCount;
+        return latency;
+    }
+
+    void print(const char* name, const Latency& latency)
+    {
+        std::cout << "  " << name << "write " << latency.median << " us median, "
+                  << latency.percentile99 << " us 99th percentile, " << latency.max << " us max, "
+                  << latency.tornCount << " torn frames" << std::endl;
+    }
+
+    void print(const char* name, const Result& result)
+    {
+        std::cout << "  " << name << result.writesPerSecond << " frames/s written, "
+                  << result.readsPerSecond << " frames/s read, " << result.tornCount
+                  << " torn frames" << std::endl;
+    }
+} // namespace
+
+int main()
+{
+    const unsigned readerCount = std::max(3u, std::thread::hardware_concurrency() - 1);
+    const std::chrono::seconds duration(2);
+
+    LockedFrame locked;
+    const Latency mutexLatency = measureLatency(locked, readerCount);
+    PublishedFrame published;
+    const Latency seqLockLatency = measureLatency(published, readerCount);
+
+    std::cout << "Latency: 1 writer, a frame every " << WritePeriod.count() << " us, "
+              << readerCount << " readers spending " << SlowCopy.count() << " us in each copy"
+              << std::endl;
+    print("mutex:           ", mutexLatency);
+    print("published frame: ", seqLockLatency);
+
+    const Result withMutex = measure(locked, readerCount, duration);
+    const Result withSeqLock = measure(published, readerCount, duration);
+
+    std::cout << "Saturation (reported only): 1 writer, " << readerCount
+              << " readers, a resize every " << FramesPerModel << " frames" << std::endl;
+    print("mutex:           ", withMutex);
+    print("published frame: ", withSeqLock);
+
+    if (seqLockLatency.tornCount != 0 || withSeqLock.tornCount != 0) {
+        std::cerr << "The readers copied torn frames" << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (seqLockLatency.percentile99 >= SlowCopy.count()) {
+        std::cerr << "The slow readers delayed the writes of the published frame" << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (published.replacedCount() != 0) {
+        std::cerr << published.replacedCount() << " replaced frames are not freed" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "OK" << std::endl;
+    return EXIT_SUCCESS;
+}
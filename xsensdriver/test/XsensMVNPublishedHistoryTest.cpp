@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "XsensMVNPublishedHistory.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+typedef xsens::XsensMVNFrameLayout Layout;
+
+namespace {
+    // frame whose values are all equal to its frame number
+    void fillFrame(std::vector<double>& frame, const int frameNumber)
+    {
+        std::fill(frame.begin(), frame.end(), static_cast<double>(frameNumber));
+    }
+
+    // Frame numbers of the frames copied by copyFramesSince, or -2 for a torn frame
+    std::vector<int> frameNumbers(const std::vector<double>& frames, const std::size_t frameSize)
+    {
+        std::vector<int> numbers;
+        for (std::size_t offset = 0; offset < frames.size(); offset += frameSize) {
+            const double number = frames[offset + Layout::FrameNumberOffset];
+            const bool torn = std::any_of(frames.begin() + offset,
+                                          frames.begin() + offset + frameSize,
+                                          [&](const double value) { return value != number; });
+            numbers.push_back(torn ? -2 : static_cast<int>(number));
+        }
+        return numbers;
+    }
+} // namespace
+
+// Frames newer than the last one seen, a restarted numbering, a full history and clear()
+bool check_single_thread()
+{
+    const std::size_t frameSize = 8;
+    xsens::XsensMVNPublishedHistory history;
+    history.reset(frameSize, 4);
+    std::vector<double> frame(frameSize);
+    std::vector<double> frames;
+
+    if (history.copyFramesSince(-1, frames) != 0 || !frames.empty()) {
+        std::cerr << "A new history is not empty" << std::endl;
+        return false;
+    }
+
+    for (int number = 10; number < 13; ++number) {
+        fillFrame(frame, number);
+        history.push(frame.data());
+    }
+    if (history.copyFramesSince(10, frames) != 2
+        || frameNumbers(frames, frameSize) != std::vector<int>({11, 12})) {
+        std::cerr << "Frames since 10 are not 11, 12" << std::endl;
+        return false;
+    }
+    if (history.copyFramesSince(12, frames) != 0 || !frames.empty()) {
+        std::cerr << "Frames returned after the newest one" << std::endl;
+        return false;
+    }
+    // the numbering restarted: everything is newer than the last frame seen
+    if (history.copyFramesSince(100, frames) != 3
+        || frameNumbers(frames, frameSize) != std::vector<int>({10, 11, 12})) {
+        std::cerr << "The whole history is not returned after a restart" << std::endl;
+        return false;
+    }
+
+    // full: the oldest frames are overwritten
+    for (int number = 13; number < 16; ++number) {
+        fillFrame(frame, number);
+        history.push(frame.data());
+    }
+    if (history.copyFramesSince(-1, frames) != 4
+        || frameNumbers(frames, frameSize) != std::vector<int>({12, 13, 14, 15})) {
+        std::cerr << "The full history does not hold the newest frames" << std::endl;
+        return false;
+    }
+
+    history.clear();
+    if (history.copyFramesSince(-1, frames) != 0) {
+        std::cerr << "Frames returned after clear()" << std::endl;
+        return false;
+    }
+    fillFrame(frame, 0);
+    history.push(frame.data());
+    if (history.copyFramesSince(-1, frames) != 1
+        || frameNumbers(frames, frameSize) != std::vector<int>({0})) {
+        std::cerr << "Frames pushed before clear() are returned" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// One writer pushes numbered frames as fast as it can while some readers follow it with
+// copyFramesSince: the frames copied are never torn and always consecutive, and each call starts
+// after the last frame of the previous one.
+bool check_concurrent_readers()
+{
+    // a full-body frame with the sensors
+    const std::size_t frameSize = Layout(23, 17).size();
+    const std::chrono::seconds duration(2);
+    const unsigned readerCount = std::max(3u, std::thread::hardware_concurrency() - 1);
+
+    xsens::XsensMVNPublishedHistory history;
+    history.reset(frameSize, 16);
+    std::atomic<bool> stop(false);
+    std::atomic<unsigned long> errorCount(0);
+    std::atomic<unsigned long> copiedCount(0);
+
+    std::vector<std::thread> readers;
+    for (unsigned r = 0; r < readerCount; ++r) {
+        readers.emplace_back([&]() {
+            std::vector<double> frames;
+            int lastFrameNumber = -1;
+            unsigned long copied = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                history.copyFramesSince(lastFrameNumber, frames);
+                const std::vector<int> numbers = frameNumbers(frames, frameSize);
+                for (std::size_t i = 0; i < numbers.size(); ++i) {
+                    const bool consecutive = i == 0 ? numbers[i] > lastFrameNumber
+                                                    : numbers[i] == numbers[i - 1] + 1;
+                    if (numbers[i] < 0 || !consecutive) {
+                        errorCount.fetch_add(1, std::memory_order_relaxed);
+                        break;
+                    }
+                }
+                if (!numbers.empty()) {
+                    lastFrameNumber = numbers.back();
+                }
+                copied += numbers.size();
+            }
+            copiedCount.fetch_add(copied, std::memory_order_relaxed);
+        });
+    }
+
+    std::vector<double> frame(frameSize);
+    int frameNumber = 0;
+    const auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+        fillFrame(frame, frameNumber++);
+        history.push(frame.data());
+    }
+    stop = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    std::cout << frameNumber << " frames pushed, " << copiedCount << " frames copied by "
+              << readerCount << " readers, " << errorCount << " errors" << std::endl;
+    return errorCount == 0 && copiedCount > 0;
+}
+
+int main()
+{
+    if (!check_single_thread() || !check_concurrent_readers()) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "OK" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "XsensMVNRingBuffer.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+typedef xsens::XsensMVNRingBuffer<std::vector<unsigned long>> RingBuffer;
+
+// Items come out in order, a full ring drops and counts the new items, slots keep their memory
+bool check_single_thread()
+{
+    RingBuffer buffer(3);
+    if (buffer.capacity() != 3 || !buffer.empty() || buffer.front()) {
+        std::cerr << "A new ring is not empty" << std::endl;
+        return false;
+    }
+
+    for (unsigned long i = 0; i < 4; ++i) {
+        std::vector<unsigned long>* slot = buffer.beginWrite();
+        if (!slot) {
+            if (i == 3) {
+                break;
+            }
+            std::cerr << "Ring full after " << i << " items" << std::endl;
+            return false;
+        }
+        slot->assign(100, i);
+        buffer.commitWrite();
+    }
+    if (buffer.size() != 3 || buffer.overrunCount() != 1) {
+        std::cerr << "Full ring: " << buffer.size() << " items, " << buffer.overrunCount()
+                  << " overruns" << std::endl;
+        return false;
+    }
+
+    for (unsigned long i = 0; i < 3; ++i) {
+        const std::vector<unsigned long>* item = buffer.front();
+        if (!item || item->front() != i) {
+            std::cerr << "Item " << i << " not in order" << std::endl;
+            return false;
+        }
+        buffer.popFront();
+    }
+    if (!buffer.empty() || buffer.front()) {
+        std::cerr << "The ring is not empty after reading all the items" << std::endl;
+        return false;
+    }
+
+    // one more item in the slot left empty, the next one is the first slot again
+    buffer.beginWrite();
+    buffer.commitWrite();
+    buffer.popFront();
+    std::vector<unsigned long>* slot = buffer.beginWrite();
+    if (!slot || slot->capacity() < 100) {
+        std::cerr << "The slots are not reused" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// A producer and a consumer thread: every item written is read once, in order and complete.
+// The producer retries the items dropped while the ring is full
+bool check_two_threads()
+{
+    const unsigned long itemCount = 1000000;
+    const std::size_t itemSize = 16;
+    RingBuffer buffer(8);
+    for (std::size_t i = 0; i < buffer.capacity(); ++i) {
+        buffer.beginWrite()->resize(itemSize);
+        buffer.commitWrite();
+        buffer.popFront();
+    }
+
+    std::thread producer([&]() {
+        for (unsigned long i = 0; i < itemCount;) {
+            std::vector<unsigned long>* slot = buffer.beginWrite();
+            if (!slot) {
+                std::this_thread::yield();
+                continue;
+            }
+            for (auto& value : *slot) {
+                value = i;
+            }
+            buffer.commitWrite();
+            ++i;
+        }
+    });
+
+    bool ok = true;
+    for (unsigned long i = 0; i < itemCount && ok;) {
+        const std::vector<unsigned long>* item = buffer.front();
+        if (!item) {
+            std::this_thread::yield();
+            continue;
+        }
+        for (const auto value : *item) {
+            if (value != i) {
+                std::cerr << "Item " << i << " read as " << value << std::endl;
+                ok = false;
+                break;
+            }
+        }
+        buffer.popFront();
+        ++i;
+    }
+    producer.join();
+
+    if (ok && !buffer.empty()) {
+        std::cerr << buffer.size() << " items left after the transfer" << std::endl;
+        ok = false;
+    }
+    return ok;
+}
+
+int main()
+{
+    if (!check_single_thread() || !check_two_threads()) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "OK" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "XsensMVNSeqLock.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// One writer publishes frames whose values are all equal to the frame number, while some readers
+// copy them. A torn copy would mix the values of two frames.
+int main()
+{
+    // a full-body frame with the sensors: 23 segments * 19 values + 17 sensors * 13 values
+    const std::size_t frameSize = 23 * 19 + 17 * 13;
+    const std::chrono::seconds duration(2);
+    const unsigned readerCount = std::max(3u, std::thread::hardware_concurrency() - 1);
+
+    xsens::XsensMVNSeqLock frame(frameSize);
+    std::atomic<bool> stop(false);
+    std::atomic<unsigned long> tornCount(0);
+    std::atomic<unsigned long> readCount(0);
+    unsigned long writeCount = 0;
+
+    std::vector<std::thread> readers;
+    for (unsigned r = 0; r < readerCount; ++r) {
+        readers.emplace_back([&, r]() {
+            std::vector<double> copy(frameSize);
+            double lastFrame = 0;
+            unsigned long reads = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                // half the readers copy the whole buffer, the others read single values
+                if (r % 2 == 0) {
+                    frame.read(copy.data());
+                }
+                else {
+                    frame.read([&](const xsens::XsensMVNSeqLock& values) {
+                        for (std::size_t i = 0; i < frameSize; ++i) {
+                            copy[i] = values.value(i);
+                        }
+                    });
+                }
+                for (std::size_t i = 1; i < frameSize; ++i) {
+                    if (copy[i] != copy[0]) {
+                        tornCount.fetch_add(1, std::memory_order_relaxed);
+                        break;
+                    }
+                }
+                // frames never go back in time
+                if (copy[0] < lastFrame) {
+                    tornCount.fetch_add(1, std::memory_order_relaxed);
+                }
+                lastFrame = copy[0];
+                ++reads;
+            }
+            readCount.fetch_add(reads, std::memory_order_relaxed);
+        });
+    }
+
+    std::vector<double> values(frameSize);
+    const auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+        ++writeCount;
+        for (auto& value : values) {
+            value = static_cast<double>(writeCount);
+        }
+        frame.write(values.data());
+    }
+    stop = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    std::cout << writeCount << " frames written, " << readCount << " frames read by "
+              << readerCount << " readers, " << tornCount << " torn" << std::endl;
+    return tornCount == 0 && readCount > 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -10,7 +10,11 @@
 #define YARP_XSENSMVNREMOTE_H
 
 #include <yarp/dev/DeviceDriver.h>
+#include <yarp/dev/IFrameHistoryProvider.h>
+#include <yarp/dev/IFrameListener.h>
+#include <yarp/dev/IFrameNotifier.h>
 #include <yarp/dev/IFrameProvider.h>
+#include <yarp/dev/IFrameProviderBulk.h>
 #include <yarp/dev/IIMUFrameProvider.h>
 #include <yarp/dev/IXsensMVNInterface.h>
 #include <yarp/dev/PreciselyTimed.h>
@@ -27,6 +31,11 @@ class yarp::dev::XsensMVNRemote
     , public yarp::experimental::dev::IFrameProvider
     , public yarp::experimental::dev::IIMUFrameProvider
     , public yarp::experimental::dev::IXsensMVNInterface
+    , public yarp::experimental::dev::IFrameProviderBulk
+    , public yarp::experimental::dev::IIMUFrameProviderBulk
+    , public yarp::experimental::dev::IFrameNotifier
+    , public yarp::experimental::dev::IFrameListenerRegistry
+    , public yarp::experimental::dev::IFrameHistoryProvider
 {
     class XsensMVNRemotePrivate;
     XsensMVNRemotePrivate* m_pimpl;
@@ -44,6 +53,7 @@ public:
 
     // IFrameProvider interface
     virtual std::vector<yarp::experimental::dev::FrameReference> frames();
+    virtual unsigned frameListVersion();
 
     virtual yarp::experimental::dev::IFrameProviderStatus
     getFramePoses(std::vector<yarp::sig::Vector>& segmentPoses);
@@ -55,9 +65,15 @@ public:
     getFrameInformation(std::vector<yarp::sig::Vector>& segmentPoses,
                         std::vector<yarp::sig::Vector>& segmentVelocities,
                         std::vector<yarp::sig::Vector>& segmentAccelerations);
+    virtual yarp::experimental::dev::IFrameProviderStatus
+    getStampedFrameInformation(std::vector<yarp::sig::Vector>& segmentPoses,
+                               std::vector<yarp::sig::Vector>& segmentVelocities,
+                               std::vector<yarp::sig::Vector>& segmentAccelerations,
+                               yarp::os::Stamp& timestamp);
 
     // IIMUFrameProvider interface
     virtual std::vector<yarp::experimental::dev::IMUFrameReference> IMUFrames();
+    virtual unsigned IMUFrameListVersion();
 
     virtual yarp::experimental::dev::IIMUFrameProviderStatus
     getIMUFrameOrientations(std::vector<yarp::sig::Vector>& imuOrientations);
@@ -72,6 +88,29 @@ public:
                            std::vector<yarp::sig::Vector>& imuAngularVelocities,
                            std::vector<yarp::sig::Vector>& imuLinearAccelerations,
                            std::vector<yarp::sig::Vector>& imuMagneticFields);
+    virtual yarp::experimental::dev::IIMUFrameProviderStatus
+    getStampedIMUFrameInformation(std::vector<yarp::sig::Vector>& imuOrientations,
+                                  std::vector<yarp::sig::Vector>& imuAngularVelocities,
+                                  std::vector<yarp::sig::Vector>& imuLinearAccelerations,
+                                  std::vector<yarp::sig::Vector>& imuMagneticFields,
+                                  yarp::os::Stamp& timestamp);
+
+    // IFrameNotifier interface
+    virtual bool waitForNextFrame(const yarp::os::Stamp& lastStamp, const double timeout);
+
+    // IFrameListenerRegistry interface
+    virtual bool addFrameListener(yarp::experimental::dev::FrameListener& listener);
+    virtual bool removeFrameListener(yarp::experimental::dev::FrameListener& listener);
+
+    // IFrameProviderBulk interface
+    virtual std::size_t frameBulkSize();
+    virtual yarp::experimental::dev::IFrameProviderStatus
+    getFrameBulk(double* buffer, const std::size_t bufferSize, yarp::os::Stamp& timestamp);
+
+    // IIMUFrameProviderBulk interface
+    virtual std::size_t IMUFrameBulkSize();
+    virtual yarp::experimental::dev::IIMUFrameProviderStatus
+    getIMUFrameBulk(double* buffer, const std::size_t bufferSize, yarp::os::Stamp& timestamp);
 
     // IXsensMVNInterface interface
     virtual bool setBodyDimensions(const std::map<std::string, double>& dimensions);
@@ -83,6 +122,15 @@ public:
 
     virtual bool startAcquisition();
     virtual bool stopAcquisition();
+
+    // IFrameHistoryProvider interface. The history is sized by frame-history-duration, and the
+    // newest frame is returned up to frame-hold-time seconds after it (one frame period if not
+    // given)
+    virtual yarp::experimental::dev::IFrameProviderStatus
+    getFrameAt(const double time,
+               std::vector<yarp::sig::Vector>& segmentPoses,
+               std::vector<yarp::sig::Vector>& segmentVelocities,
+               std::vector<yarp::sig::Vector>& segmentAccelerations);
 };
 
 #endif /* end of include guard: YARP_XSENSMVNREMOTE_H */
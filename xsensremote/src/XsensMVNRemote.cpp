@@ -7,6 +7,10 @@
  */
 
 #include "XsensMVNRemote.h"
+#include "XsensMVNFrameHistory.h"
+#include "XsensMVNFrameInterpolation.h"
+#include "XsensMVNPublishedFrame.h"
+#include "XsensMVNRemoteFrames.h"
 
 #include <thrift/XsensDriverService.h>
 #include <thrift/XsensSegmentsFrame.h>
@@ -22,9 +26,37 @@
 #include <yarp/sig/Vector.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
 #include <vector>
 
+namespace {
+    // Highest frame rate of the MVN suits, used to size the frame history
+    const double MaximumFrameRate = 240.0;
+
+    // the history looks for the stamps of the published frames where the driver puts them
+    static_assert(static_cast<int>(xsens::XsensMVNPublishedFrame::StampCountOffset)
+                          == static_cast<int>(xsens::XsensMVNFrameLayout::FrameNumberOffset)
+                      && static_cast<int>(xsens::XsensMVNPublishedFrame::StampTimeOffset)
+                             == static_cast<int>(xsens::XsensMVNFrameLayout::TimeOffset),
+                  "XsensMVNFrameHistory needs the stamp at the start of the frames");
+
+    // the history interpolates the segments blocks where the bulk getters put them
+    static_assert(static_cast<int>(xsens::SegmentBlockPoseOffset)
+                          == static_cast<int>(yarp::experimental::dev::FrameBulkPoseOffset)
+                      && static_cast<int>(xsens::SegmentBlockVelocityOffset)
+                             == static_cast<int>(yarp::experimental::dev::FrameBulkVelocityOffset)
+                      && static_cast<int>(xsens::SegmentBlockAccelerationOffset)
+                             == static_cast<int>(
+                                    yarp::experimental::dev::FrameBulkAccelerationOffset)
+                      && static_cast<int>(xsens::SegmentBlockStride)
+                             == static_cast<int>(yarp::experimental::dev::FrameBulkStride),
+                  "xsens::interpolateSegments needs the segments blocks of FrameBulkLayout");
+} // namespace
+
 namespace yarp {
     namespace dev {
 
@@ -42,126 +74,365 @@ namespace yarp {
             yarp::os::ConstString m_remoteSensorsStreamingPortName;
             yarp::os::ConstString m_remoteCommandPortName;
 
-            // Buffers for read & associated mutex
-            yarp::os::Mutex m_mutex;
-            yarp::os::Stamp m_segmentsTimestamp;
-            yarp::os::Stamp m_sensorsTimestamp;
-
-            // Buffers for segments data and status
-            std::vector<yarp::sig::Vector> m_poses;
-            std::vector<yarp::sig::Vector> m_velocities;
-            std::vector<yarp::sig::Vector> m_accelerations;
-            yarp::experimental::dev::IFrameProviderStatus m_segmentsStatus;
-            unsigned m_segmentsCount;
-
-            //  Buffers for sensors data and status
-            std::vector<yarp::sig::Vector> m_imuOrientations;
-            std::vector<yarp::sig::Vector> m_imuAngularVelocities;
-            std::vector<yarp::sig::Vector> m_imuLinearAccelerations;
-            std::vector<yarp::sig::Vector> m_imuMagneticFields;
-            yarp::experimental::dev::IIMUFrameProviderStatus m_sensorsStatus;
-            unsigned m_sensorsCount;
+            // Last frames decoded by the port threads: the segments data laid out as in
+            // FrameBulkLayout, the sensors data as in IMUFrameBulkLayout. The getters read them
+            // without blocking the port threads
+            xsens::XsensMVNPublishedFrame m_segments;
+            xsens::XsensMVNPublishedFrame m_sensors;
+
+            // Frame lists, fetched at open and again only when the model version written by the
+            // wrapper in the frames changes
+            yarp::os::Mutex m_framesMutex;
+            std::vector<yarp::experimental::dev::FrameReference> m_frames;
+            std::vector<yarp::experimental::dev::IMUFrameReference> m_imuFrames;
+            // remote versions of the cached lists
+            std::int32_t m_framesModelVersion;
+            std::int32_t m_imuFramesModelVersion;
+            // remote versions last read from the streams
+            std::atomic<std::int32_t> m_streamFramesModelVersion;
+            std::atomic<std::int32_t> m_streamIMUFramesModelVersion;
+            // Remote versions of the models m_segments and m_sensors are sized for. Only the port
+            // threads use them, after open
+            std::int32_t m_segmentsModelVersion;
+            std::int32_t m_sensorsModelVersion;
+            // local versions, incremented at each fetch (see IFrameProvider::frameListVersion)
+            unsigned m_frameListVersion;
+            unsigned m_imuFrameListVersion;
+
+            // signalled after each segments frame is published
+            xsens::XsensMVNFrameSignal m_newFrame;
+
+            // called on the port thread at the arrival of each segments frame
+            yarp::experimental::dev::FrameListenerList m_frameListeners;
+
+            // Last segments frames, laid out as the published ones, for getFrameAt. The port
+            // thread holds the mutex only to push a frame
+            std::mutex m_historyMutex;
+            xsens::XsensMVNFrameHistory m_frameHistory;
+            // seconds the newest frame is returned after it, negative for one frame period
+            double m_frameHoldTime;
 
             XsensMVNRemotePrivate()
-                : m_segmentsStatus(yarp::experimental::dev::IFrameProviderStatusNoData)
-                , m_sensorsStatus(yarp::experimental::dev::IIMUFrameProviderStatusNoData)
-                , m_segmentsCount(0)
-                , m_sensorsCount(0)
+                : m_segments(yarp::experimental::dev::IFrameProviderStatusNoData)
+                , m_sensors(yarp::experimental::dev::IIMUFrameProviderStatusNoData)
+                , m_framesModelVersion(0)
+                , m_imuFramesModelVersion(0)
+                , m_streamFramesModelVersion(0)
+                , m_streamIMUFramesModelVersion(0)
+                , m_segmentsModelVersion(0)
+                , m_sensorsModelVersion(0)
+                , m_frameListVersion(0)
+                , m_imuFrameListVersion(0)
+                , m_newFrame(yarp::experimental::dev::IFrameProviderStatusNoData)
+                , m_frameHoldTime(-1)
             {}
 
             virtual ~XsensMVNRemotePrivate() {}
 
+            static unsigned nextVersion(const unsigned version)
+            {
+                // 0 would disable the frame table of IFrameProvider
+                return version + 1 == 0 ? 1 : version + 1;
+            }
+
+            // Fetch the segments list from the wrapper. Call with m_framesMutex locked
+            void fetchFrames()
+            {
+                // read the version first: a change during the fetch causes another fetch
+                m_framesModelVersion = m_xsensService.segments_order_version();
+                m_streamFramesModelVersion = m_framesModelVersion;
+                std::vector<xsens::FrameReferece> frames = m_xsensService.segments_order();
+                m_frames.clear();
+                m_frames.reserve(frames.size());
+                for (const xsens::FrameReferece& frame : frames) {
+                    yarp::experimental::dev::FrameReference referenceFrame;
+                    referenceFrame.frameReference = frame.frameReference;
+                    referenceFrame.frameName = frame.frameName;
+                    m_frames.push_back(referenceFrame);
+                }
+                m_frameListVersion = nextVersion(m_frameListVersion);
+            }
+
+            // Fetch the sensors list from the wrapper. Call with m_framesMutex locked
+            void fetchIMUFrames()
+            {
+                m_imuFramesModelVersion = m_xsensService.imu_segments_order_version();
+                m_streamIMUFramesModelVersion = m_imuFramesModelVersion;
+                std::vector<xsens::FrameReferece> imuFrames =
+                    m_xsensService.imu_segments_order();
+                m_imuFrames.clear();
+                m_imuFrames.reserve(imuFrames.size());
+                for (const xsens::FrameReferece& frame : imuFrames) {
+                    yarp::experimental::dev::IMUFrameReference referenceFrame;
+                    referenceFrame.IMUframeReference = frame.frameReference;
+                    referenceFrame.IMUframeName = frame.frameName;
+                    m_imuFrames.push_back(referenceFrame);
+                }
+                m_imuFrameListVersion = nextVersion(m_imuFrameListVersion);
+            }
+
+            // Copy the stamp and the requested quantities (the non null vectors) of the last
+            // sensors frame
+            yarp::experimental::dev::IIMUFrameProviderStatus
+            copySensors(std::vector<yarp::sig::Vector>* orientations,
+                        std::vector<yarp::sig::Vector>* angularVelocities,
+                        std::vector<yarp::sig::Vector>* linearAccelerations,
+                        std::vector<yarp::sig::Vector>* magneticFields,
+                        yarp::os::Stamp& timestamp) const
+            {
+                int status = yarp::experimental::dev::IIMUFrameProviderStatusNoData;
+                m_sensors.read([&](const xsens::XsensMVNSeqLock& frame) {
+                    timestamp = xsens::publishedFrameStamp(frame);
+                    status = xsens::publishedFrameStatus(frame);
+                    const std::size_t stride = yarp::experimental::dev::IMUFrameBulkStride;
+                    if (orientations)
+                        xsens::copyBlocks(
+                            frame,
+                            stride,
+                            yarp::experimental::dev::IMUFrameBulkOrientationOffset,
+                            4,
+                            *orientations);
+                    if (angularVelocities)
+                        xsens::copyBlocks(
+                            frame,
+                            stride,
+                            yarp::experimental::dev::IMUFrameBulkAngularVelocityOffset,
+                            3,
+                            *angularVelocities);
+                    if (linearAccelerations)
+                        xsens::copyBlocks(
+                            frame,
+                            stride,
+                            yarp::experimental::dev::IMUFrameBulkLinearAccelerationOffset,
+                            3,
+                            *linearAccelerations);
+                    if (magneticFields)
+                        xsens::copyBlocks(
+                            frame,
+                            stride,
+                            yarp::experimental::dev::IMUFrameBulkMagneticFieldOffset,
+                            3,
+                            *magneticFields);
+                });
+                return static_cast<yarp::experimental::dev::IIMUFrameProviderStatus>(status);
+            }
+
+            // Size the published frames as the frame lists. Called by open before the callbacks
+            // are registered: afterwards only the port threads resize them (see
+            // followSegmentsModel)
+            void resizeSegmentsBuffers()
+            {
+                m_segments.resize(m_frames.size() * yarp::experimental::dev::FrameBulkStride);
+                m_segmentsModelVersion = m_framesModelVersion;
+            }
+
+            void resizeSensorsBuffers()
+            {
+                m_sensors.resize(m_imuFrames.size() * yarp::experimental::dev::IMUFrameBulkStride);
+                m_sensorsModelVersion = m_imuFramesModelVersion;
+            }
+
+            // Fetch the lists again if the stream reported a new model. Call with m_framesMutex
+            // locked
+            void updateFrames()
+            {
+                if (m_streamFramesModelVersion != m_framesModelVersion) {
+                    fetchFrames();
+                }
+            }
+
+            void updateIMUFrames()
+            {
+                if (m_streamIMUFramesModelVersion != m_imuFramesModelVersion) {
+                    fetchIMUFrames();
+                }
+            }
+
+            // Called on the port thread before decoding a segments frame: the first frame of a
+            // new model with data resizes m_segments to it, so that the data of the new model is
+            // published as soon as it arrives. The lists are fetched again by the next frames()
+            // (or getFrameCount, ...) call
+            void followSegmentsModel(const xsens::XsensSegmentsFrame& frame)
+            {
+                m_streamFramesModelVersion = frame.modelVersion;
+                if (frame.modelVersion == m_segmentsModelVersion || frame.segmentsData.empty()) {
+                    return;
+                }
+                m_segmentsModelVersion = frame.modelVersion;
+                const std::size_t dataSize =
+                    frame.segmentsData.size() * yarp::experimental::dev::FrameBulkStride;
+                if (dataSize != m_segments.dataSize()) {
+                    m_segments.resize(dataSize);
+                }
+            }
+
+            void followSensorsModel(const xsens::XsensSensorsFrame& imuFrame)
+            {
+                m_streamIMUFramesModelVersion = imuFrame.modelVersion;
+                if (imuFrame.modelVersion == m_sensorsModelVersion
+                    || imuFrame.sensorsData.empty()) {
+                    return;
+                }
+                m_sensorsModelVersion = imuFrame.modelVersion;
+                const std::size_t dataSize =
+                    imuFrame.sensorsData.size() * yarp::experimental::dev::IMUFrameBulkStride;
+                if (dataSize != m_sensors.dataSize()) {
+                    m_sensors.resize(dataSize);
+                }
+            }
+
             // onRead callback for reading XSens Segments Frame data
             virtual void onRead(xsens::XsensSegmentsFrame& frame)
             {
-                yarp::os::LockGuard guard(m_mutex);
-                // get timestamp
-                m_inputSegmentsPort.getEnvelope(m_segmentsTimestamp);
-
-                m_segmentsStatus =
-                    static_cast<yarp::experimental::dev::IFrameProviderStatus>(frame.status);
+                // decode in the back buffer, then publish it at once
+                followSegmentsModel(frame);
+                double* buffer = m_segments.beginWrite();
+                yarp::os::Stamp timestamp;
+                m_inputSegmentsPort.getEnvelope(timestamp);
+                const yarp::experimental::dev::IFrameProviderStatus status =
+                    xsens::readSegments(frame,
+                                        timestamp,
+                                        frame.modelVersion == m_segmentsModelVersion,
+                                        m_segments.writeDataSize()
+                                            / yarp::experimental::dev::FrameBulkStride,
+                                        buffer);
+                m_segments.commitWrite();
+                if (status == yarp::experimental::dev::IFrameProviderStatusOK) {
+                    pushToHistory(buffer,
+                                  xsens::XsensMVNPublishedFrame::DataOffset
+                                      + m_segments.writeDataSize());
+                }
+                m_newFrame.notify(status);
+                m_frameListeners.notify(timestamp, status);
+            }
 
-                // if status is != OK we should not have any data
-                if (m_segmentsStatus != yarp::experimental::dev::IFrameProviderStatusOK)
+            // Add a segments frame to the history, unless it is republished. Called on the port
+            // thread
+            void pushToHistory(const double* frame, const std::size_t frameSize)
+            {
+                std::lock_guard<std::mutex> historyLock(m_historyMutex);
+                if (m_frameHistory.capacity() == 0) {
                     return;
+                }
+                const double time = frame[xsens::XsensMVNPublishedFrame::StampTimeOffset];
+                if (m_frameHistory.frameSize() != frameSize) {
+                    // new model: the old frames cannot be interpolated with the new ones
+                    m_frameHistory.reset(frameSize, m_frameHistory.capacity());
+                }
+                else if (m_frameHistory.size() > 0) {
+                    const double lastTime = m_frameHistory.frameAt(
+                        m_frameHistory.size() - 1)[xsens::XsensMVNPublishedFrame::StampTimeOffset];
+                    if (time == lastTime) {
+                        // same frame, republished without changes
+                        return;
+                    }
+                    if (time < lastTime) {
+                        // the stream restarted: keep the history in time order
+                        m_frameHistory.clear();
+                    }
+                }
+                m_frameHistory.push(frame);
+            }
 
-                for (unsigned seg = 0; seg < m_segmentsCount; ++seg) {
-                    xsens::Vector3& position = frame.segmentsData[seg].position;
-                    xsens::Quaternion& orientation = frame.segmentsData[seg].orientation;
-                    xsens::Vector3& linVelocity = frame.segmentsData[seg].velocity;
-                    xsens::Vector3& angVelocity = frame.segmentsData[seg].angularVelocity;
-                    xsens::Vector3& linAcceleration = frame.segmentsData[seg].acceleration;
-                    xsens::Vector3& angAcceleration = frame.segmentsData[seg].angularAcceleration;
-
-                    yarp::sig::Vector& newPose = m_poses[seg];
-                    yarp::sig::Vector& newVelocity = m_velocities[seg];
-                    yarp::sig::Vector& newAcceleration = m_accelerations[seg];
-
-                    newPose[0] = position.x;
-                    newPose[1] = position.y;
-                    newPose[2] = position.z;
-                    newPose[3] = orientation.w;
-                    newPose[4] = orientation.imaginary.x;
-                    newPose[5] = orientation.imaginary.y;
-                    newPose[6] = orientation.imaginary.z;
-
-                    newVelocity[0] = linVelocity.x;
-                    newVelocity[1] = linVelocity.y;
-                    newVelocity[2] = linVelocity.z;
-                    newVelocity[3] = angVelocity.x;
-                    newVelocity[4] = angVelocity.y;
-                    newVelocity[5] = angVelocity.z;
-
-                    newAcceleration[0] = linAcceleration.x;
-                    newAcceleration[1] = linAcceleration.y;
-                    newAcceleration[2] = linAcceleration.z;
-                    newAcceleration[3] = angAcceleration.x;
-                    newAcceleration[4] = angAcceleration.y;
-                    newAcceleration[5] = angAcceleration.z;
+            yarp::experimental::dev::IFrameProviderStatus
+            getFrameAt(const double time,
+                       std::vector<yarp::sig::Vector>& poses,
+                       std::vector<yarp::sig::Vector>& velocities,
+                       std::vector<yarp::sig::Vector>& accelerations)
+            {
+                std::lock_guard<std::mutex> historyLock(m_historyMutex);
+                switch (xsens::interpolateFrameAt(
+                    m_frameHistory, time, m_frameHoldTime, poses, velocities, accelerations)) {
+                    case xsens::FrameAtFound:
+                        return yarp::experimental::dev::IFrameProviderStatusOK;
+                    case xsens::FrameAtAfterHistory:
+                        // no frame of that time received (yet)
+                        return yarp::experimental::dev::IFrameProviderStatusTimeout;
+                    default:
+                        return yarp::experimental::dev::IFrameProviderStatusNoData;
                 }
             }
 
             // onRead callback for reading XSens Sensors Frame data
             virtual void onRead(xsens::XsensSensorsFrame& imuFrame)
             {
-                yarp::os::LockGuard guard(m_mutex);
+                followSensorsModel(imuFrame);
+                double* buffer = m_sensors.beginWrite();
                 // get timestamp
-                m_inputSensorsPort.getEnvelope(m_sensorsTimestamp);
-
-                m_sensorsStatus =
+                yarp::os::Stamp timestamp;
+                m_inputSensorsPort.getEnvelope(timestamp);
+                buffer[xsens::XsensMVNPublishedFrame::StampCountOffset] = timestamp.getCount();
+                buffer[xsens::XsensMVNPublishedFrame::StampTimeOffset] = timestamp.getTime();
+
+                const unsigned sensorsCount =
+                    m_sensors.writeDataSize() / yarp::experimental::dev::IMUFrameBulkStride;
+                yarp::experimental::dev::IIMUFrameProviderStatus status =
                     static_cast<yarp::experimental::dev::IIMUFrameProviderStatus>(imuFrame.status);
+                if (status == yarp::experimental::dev::IIMUFrameProviderStatusOK) {
+                    if (imuFrame.channelsDisabled) {
+                        // the wrapper streams no sensor channel: the last data is not current
+                        status = yarp::experimental::dev::IIMUFrameProviderStatusNoData;
+                    }
+                    else if (imuFrame.sensorsData.empty()) {
+                        // frames republished without changes carry only the status: keep the
+                        // last data, unless it belongs to a previous model
+                        if (imuFrame.modelVersion != m_sensorsModelVersion) {
+                            status = yarp::experimental::dev::IIMUFrameProviderStatusNoData;
+                        }
+                    }
+                    else if (imuFrame.sensorsData.size() != sensorsCount) {
+                        // data of another model under the same version
+                        status = yarp::experimental::dev::IIMUFrameProviderStatusError;
+                    }
+                }
+                buffer[xsens::XsensMVNPublishedFrame::StatusOffset] = status;
 
                 // if status is != OK we should not have any data
-                if (m_sensorsStatus != yarp::experimental::dev::IIMUFrameProviderStatusOK)
-                    return;
+                if (status == yarp::experimental::dev::IIMUFrameProviderStatusOK
+                    && !imuFrame.sensorsData.empty()) {
+                    readSensors(imuFrame, sensorsCount, buffer);
+                }
+                m_sensors.commitWrite();
+            }
 
-                for (unsigned sens = 0; sens < m_sensorsCount; ++sens) {
+            // Decode the data of the sensors frame in buffer
+            void readSensors(xsens::XsensSensorsFrame& imuFrame,
+                             const unsigned sensorsCount,
+                             double* buffer)
+            {
+                double* block = buffer + xsens::XsensMVNPublishedFrame::DataOffset;
+                for (unsigned sens = 0; sens < sensorsCount;
+                     ++sens, block += yarp::experimental::dev::IMUFrameBulkStride) {
                     xsens::Quaternion& imuOrientation = imuFrame.sensorsData[sens].orientation;
                     xsens::Vector3& imuAngularVelocity = imuFrame.sensorsData[sens].angularVelocity;
                     xsens::Vector3& imuLinearAcceleration = imuFrame.sensorsData[sens].acceleration;
                     xsens::Vector3& imuMagneticField = imuFrame.sensorsData[sens].magnetometer;
 
-                    yarp::sig::Vector& newImuOrientation = m_imuOrientations[sens];
-                    yarp::sig::Vector& newImuAngularVelocity = m_imuAngularVelocities[sens];
-                    yarp::sig::Vector& newImuLinearAcceleration = m_imuLinearAccelerations[sens];
-                    yarp::sig::Vector& newMagneticField = m_imuMagneticFields[sens];
-
-                    imuOrientation.w = newImuOrientation[0];
-                    imuOrientation.imaginary.x = newImuOrientation[1];
-                    imuOrientation.imaginary.y = newImuOrientation[2];
-                    imuOrientation.imaginary.z = newImuOrientation[3];
-
-                    imuAngularVelocity.x = newImuAngularVelocity[0];
-                    imuAngularVelocity.y = newImuAngularVelocity[1];
-                    imuAngularVelocity.z = newImuAngularVelocity[2];
-
-                    imuLinearAcceleration.x = newImuLinearAcceleration[0];
-                    imuLinearAcceleration.y = newImuLinearAcceleration[1];
-                    imuLinearAcceleration.z = newImuLinearAcceleration[2];
-
-                    imuMagneticField.x = newMagneticField[0];
-                    imuMagneticField.y = newMagneticField[1];
-                    imuMagneticField.z = newMagneticField[2];
+                    double* newImuOrientation =
+                        block + yarp::experimental::dev::IMUFrameBulkOrientationOffset;
+                    double* newImuAngularVelocity =
+                        block + yarp::experimental::dev::IMUFrameBulkAngularVelocityOffset;
+                    double* newImuLinearAcceleration =
+                        block + yarp::experimental::dev::IMUFrameBulkLinearAccelerationOffset;
+                    double* newMagneticField =
+                        block + yarp::experimental::dev::IMUFrameBulkMagneticFieldOffset;
+
+                    newImuOrientation[0] = imuOrientation.w;
+                    newImuOrientation[1] = imuOrientation.imaginary.x;
+                    newImuOrientation[2] = imuOrientation.imaginary.y;
+                    newImuOrientation[3] = imuOrientation.imaginary.z;
+
+                    newImuAngularVelocity[0] = imuAngularVelocity.x;
+                    newImuAngularVelocity[1] = imuAngularVelocity.y;
+                    newImuAngularVelocity[2] = imuAngularVelocity.z;
+
+                    newImuLinearAcceleration[0] = imuLinearAcceleration.x;
+                    newImuLinearAcceleration[1] = imuLinearAcceleration.y;
+                    newImuLinearAcceleration[2] = imuLinearAcceleration.z;
+
+                    newMagneticField[0] = imuMagneticField.x;
+                    newMagneticField[1] = imuMagneticField.y;
+                    newMagneticField[2] = imuMagneticField.z;
                 }
             }
         };
@@ -181,7 +452,7 @@ namespace yarp {
         bool XsensMVNRemote::open(yarp::os::Searchable& config)
         {
             assert(m_pimpl);
-            yarp::os::LockGuard guard(m_pimpl->m_mutex);
+            yarp::os::LockGuard framesGuard(m_pimpl->m_framesMutex);
 
             yarp::os::ConstString deviceName =
                 config.check("local", yarp::os::Value("/xsens_remote"), "Checking device name")
@@ -249,31 +520,40 @@ namespace yarp {
                 return false;
             }
 
-            // Obtain information regarding size of data
-            unsigned segmentCount = this->getFrameCount();
-            m_pimpl->m_poses.reserve(segmentCount);
-            m_pimpl->m_velocities.reserve(segmentCount);
-            m_pimpl->m_accelerations.reserve(segmentCount);
-            m_pimpl->m_segmentsCount = segmentCount;
-
-            for (unsigned i = 0; i < segmentCount; ++i) {
-                m_pimpl->m_poses.push_back(yarp::sig::Vector(7, 0.0));
-                m_pimpl->m_velocities.push_back(yarp::sig::Vector(6, 0.0));
-                m_pimpl->m_accelerations.push_back(yarp::sig::Vector(6, 0.0));
+            // Obtain the frame lists, and from them the size of data
+            m_pimpl->fetchFrames();
+            m_pimpl->resizeSegmentsBuffers();
+            m_pimpl->fetchIMUFrames();
+            m_pimpl->resizeSensorsBuffers();
+
+            // history of the segments frames, for getFrameAt
+            double historyDuration = config
+                                         .check("frame-history-duration",
+                                                yarp::os::Value(0.0),
+                                                "seconds of segments frames to keep (0 disables)")
+                                         .asDouble();
+            if (historyDuration < 0) {
+                yWarning("Invalid frame-history-duration %lf. Disabling the history",
+                         historyDuration);
+                historyDuration = 0;
             }
-
-            unsigned sensorsCount = this->getIMUFrameCount();
-            m_pimpl->m_imuOrientations.reserve(m_pimpl->m_sensorsCount);
-            m_pimpl->m_imuAngularVelocities.reserve(m_pimpl->m_sensorsCount);
-            m_pimpl->m_imuLinearAccelerations.reserve(m_pimpl->m_sensorsCount);
-            m_pimpl->m_imuMagneticFields.reserve(m_pimpl->m_sensorsCount);
-            m_pimpl->m_sensorsCount = sensorsCount;
-
-            for (unsigned i = 0; i < sensorsCount; ++i) {
-                m_pimpl->m_imuOrientations.push_back(yarp::sig::Vector(4, 0.0));
-                m_pimpl->m_imuAngularVelocities.push_back(yarp::sig::Vector(3, 0.0));
-                m_pimpl->m_imuLinearAccelerations.push_back(yarp::sig::Vector(3, 0.0));
-                m_pimpl->m_imuMagneticFields.push_back(yarp::sig::Vector(3, 0.0));
+            // the newest frame is returned up to frame-hold-time seconds after it, by default one
+            // frame period
+            double holdTime = -1;
+            if (config.check("frame-hold-time")) {
+                holdTime = config.find("frame-hold-time").asDouble();
+                if (holdTime < 0) {
+                    yWarning("Invalid frame-hold-time %lf. Holding the newest frame for one frame "
+                             "period",
+                             holdTime);
+                }
+            }
+            {
+                std::lock_guard<std::mutex> historyLock(m_pimpl->m_historyMutex);
+                m_pimpl->m_frameHoldTime = holdTime;
+                m_pimpl->m_frameHistory.reset(
+                    xsens::XsensMVNPublishedFrame::DataOffset + m_pimpl->m_segments.dataSize(),
+                    static_cast<std::size_t>(std::ceil(historyDuration * MaximumFrameRate)));
             }
 
             // register for callbacks
@@ -285,7 +565,6 @@ namespace yarp {
         bool XsensMVNRemote::close()
         {
             assert(m_pimpl);
-            yarp::os::LockGuard guard(m_pimpl->m_mutex);
 
             m_pimpl->m_inputSegmentsPort.disableCallback();
             m_pimpl->m_inputSensorsPort.disableCallback();
@@ -311,26 +590,24 @@ namespace yarp {
         yarp::os::Stamp XsensMVNRemote::getLastInputStamp()
         {
             assert(m_pimpl);
-            yarp::os::LockGuard guard(m_pimpl->m_mutex);
-            return m_pimpl->m_segmentsTimestamp;
-            ;
+            return xsens::lastPublishedStamp(m_pimpl->m_segments);
         }
 
         // IFrameProvider interface
         std::vector<yarp::experimental::dev::FrameReference> XsensMVNRemote::frames()
         {
             assert(m_pimpl);
-            std::vector<xsens::FrameReferece> frames = m_pimpl->m_xsensService.segments_order();
-            std::vector<yarp::experimental::dev::FrameReference> deserializedFrames;
-            deserializedFrames.reserve(frames.size());
-            std::for_each(frames.begin(), frames.end(), [&](xsens::FrameReferece& frame) {
-                yarp::experimental::dev::FrameReference referenceFrame;
-                referenceFrame.frameReference = frame.frameReference;
-                referenceFrame.frameName = frame.frameName;
-                deserializedFrames.push_back(referenceFrame);
-            });
+            yarp::os::LockGuard guard(m_pimpl->m_framesMutex);
+            m_pimpl->updateFrames();
+            return m_pimpl->m_frames;
+        }
 
-            return deserializedFrames;
+        unsigned XsensMVNRemote::frameListVersion()
+        {
+            assert(m_pimpl);
+            yarp::os::LockGuard guard(m_pimpl->m_framesMutex);
+            m_pimpl->updateFrames();
+            return m_pimpl->m_frameListVersion;
         }
 
         // Get Data
@@ -338,58 +615,68 @@ namespace yarp {
         XsensMVNRemote::getFramePoses(std::vector<yarp::sig::Vector>& segmentPoses)
         {
             assert(m_pimpl);
-            yarp::os::LockGuard guard(m_pimpl->m_mutex);
-            segmentPoses = m_pimpl->m_poses;
-            return m_pimpl->m_segmentsStatus;
+            yarp::os::Stamp timestamp;
+            return xsens::copySegments(
+                m_pimpl->m_segments, &segmentPoses, nullptr, nullptr, timestamp);
         }
 
         yarp::experimental::dev::IFrameProviderStatus
         XsensMVNRemote::getFrameVelocities(std::vector<yarp::sig::Vector>& segmentVelocities)
         {
             assert(m_pimpl);
-            yarp::os::LockGuard guard(m_pimpl->m_mutex);
-            segmentVelocities = m_pimpl->m_velocities;
-            return m_pimpl->m_segmentsStatus;
+            yarp::os::Stamp timestamp;
+            return xsens::copySegments(
+                m_pimpl->m_segments, nullptr, &segmentVelocities, nullptr, timestamp);
         }
 
         yarp::experimental::dev::IFrameProviderStatus
         XsensMVNRemote::getFrameAccelerations(std::vector<yarp::sig::Vector>& segmentAccelerations)
         {
             assert(m_pimpl);
-            yarp::os::LockGuard guard(m_pimpl->m_mutex);
-            segmentAccelerations = m_pimpl->m_accelerations;
-            return m_pimpl->m_segmentsStatus;
+            yarp::os::Stamp timestamp;
+            return xsens::copySegments(
+                m_pimpl->m_segments, nullptr, nullptr, &segmentAccelerations, timestamp);
         }
 
         yarp::experimental::dev::IFrameProviderStatus
         XsensMVNRemote::getFrameInformation(std::vector<yarp::sig::Vector>& segmentPoses,
                                             std::vector<yarp::sig::Vector>& segmentVelocities,
                                             std::vector<yarp::sig::Vector>& segmentAccelerations)
+        {
+            yarp::os::Stamp timestamp;
+            return getStampedFrameInformation(
+                segmentPoses, segmentVelocities, segmentAccelerations, timestamp);
+        }
+
+        yarp::experimental::dev::IFrameProviderStatus XsensMVNRemote::getStampedFrameInformation(
+            std::vector<yarp::sig::Vector>& segmentPoses,
+            std::vector<yarp::sig::Vector>& segmentVelocities,
+            std::vector<yarp::sig::Vector>& segmentAccelerations,
+            yarp::os::Stamp& timestamp)
         {
             assert(m_pimpl);
-            yarp::os::LockGuard guard(m_pimpl->m_mutex);
-            segmentPoses = m_pimpl->m_poses;
-            segmentVelocities = m_pimpl->m_velocities;
-            segmentAccelerations = m_pimpl->m_accelerations;
-            return m_pimpl->m_segmentsStatus;
+            return xsens::copySegments(m_pimpl->m_segments,
+                                       &segmentPoses,
+                                       &segmentVelocities,
+                                       &segmentAccelerations,
+                                       timestamp);
         }
 
         // IIMUFrameProvider interface
         std::vector<yarp::experimental::dev::IMUFrameReference> XsensMVNRemote::IMUFrames()
         {
             assert(m_pimpl);
-            std::vector<xsens::FrameReferece> imuFrames =
-                m_pimpl->m_xsensService.imu_segments_order();
-            std::vector<yarp::experimental::dev::IMUFrameReference> deserializedFrames;
-            deserializedFrames.reserve(imuFrames.size());
-            std::for_each(imuFrames.begin(), imuFrames.end(), [&](xsens::FrameReferece& frame) {
-                yarp::experimental::dev::IMUFrameReference referenceFrame;
-                referenceFrame.IMUframeReference = frame.frameReference;
-                referenceFrame.IMUframeName = frame.frameName;
-                deserializedFrames.push_back(referenceFrame);
-            });
+            yarp::os::LockGuard guard(m_pimpl->m_framesMutex);
+            m_pimpl->updateIMUFrames();
+            return m_pimpl->m_imuFrames;
+        }
 
-            return deserializedFrames;
+        unsigned XsensMVNRemote::IMUFrameListVersion()
+        {
+            assert(m_pimpl);
+            yarp::os::LockGuard guard(m_pimpl->m_framesMutex);
+            m_pimpl->updateIMUFrames();
+            return m_pimpl->m_imuFrameListVersion;
         }
 
         // Get Data
@@ -397,9 +684,8 @@ namespace yarp {
         XsensMVNRemote::getIMUFrameOrientations(std::vector<yarp::sig::Vector>& imuOrientations)
         {
             assert(m_pimpl);
-            yarp::os::LockGuard guard(m_pimpl->m_mutex);
-            imuOrientations = m_pimpl->m_imuOrientations;
-            return m_pimpl->m_sensorsStatus;
+            yarp::os::Stamp timestamp;
+            return m_pimpl->copySensors(&imuOrientations, nullptr, nullptr, nullptr, timestamp);
         }
 
         yarp::experimental::dev::IIMUFrameProviderStatus
@@ -407,9 +693,9 @@ namespace yarp {
             std::vector<yarp::sig::Vector>& imuAngularVelocities)
         {
             assert(m_pimpl);
-            yarp::os::LockGuard guard(m_pimpl->m_mutex);
-            imuAngularVelocities = m_pimpl->m_imuAngularVelocities;
-            return m_pimpl->m_sensorsStatus;
+            yarp::os::Stamp timestamp;
+            return m_pimpl->copySensors(
+                nullptr, &imuAngularVelocities, nullptr, nullptr, timestamp);
         }
 
         yarp::experimental::dev::IIMUFrameProviderStatus
@@ -417,18 +703,17 @@ namespace yarp {
             std::vector<yarp::sig::Vector>& imuLinearAccelerations)
         {
             assert(m_pimpl);
-            yarp::os::LockGuard guard(m_pimpl->m_mutex);
-            imuLinearAccelerations = m_pimpl->m_imuLinearAccelerations;
-            return m_pimpl->m_sensorsStatus;
+            yarp::os::Stamp timestamp;
+            return m_pimpl->copySensors(
+                nullptr, nullptr, &imuLinearAccelerations, nullptr, timestamp);
         }
 
         yarp::experimental::dev::IIMUFrameProviderStatus
         XsensMVNRemote::getIMUFrameMagneticFields(std::vector<yarp::sig::Vector>& imuMagneticFields)
         {
             assert(m_pimpl);
-            yarp::os::LockGuard guard(m_pimpl->m_mutex);
-            imuMagneticFields = m_pimpl->m_imuMagneticFields;
-            return m_pimpl->m_sensorsStatus;
+            yarp::os::Stamp timestamp;
+            return m_pimpl->copySensors(nullptr, nullptr, nullptr, &imuMagneticFields, timestamp);
         }
 
         yarp::experimental::dev::IIMUFrameProviderStatus XsensMVNRemote::getIMUFrameInformation(
@@ -436,14 +721,91 @@ namespace yarp {
             std::vector<yarp::sig::Vector>& imuAngularVelocities,
             std::vector<yarp::sig::Vector>& imuLinearAccelerations,
             std::vector<yarp::sig::Vector>& imuMagneticFields)
+        {
+            yarp::os::Stamp timestamp;
+            return getStampedIMUFrameInformation(imuOrientations,
+                                                 imuAngularVelocities,
+                                                 imuLinearAccelerations,
+                                                 imuMagneticFields,
+                                                 timestamp);
+        }
+
+        yarp::experimental::dev::IIMUFrameProviderStatus
+        XsensMVNRemote::getStampedIMUFrameInformation(
+            std::vector<yarp::sig::Vector>& imuOrientations,
+            std::vector<yarp::sig::Vector>& imuAngularVelocities,
+            std::vector<yarp::sig::Vector>& imuLinearAccelerations,
+            std::vector<yarp::sig::Vector>& imuMagneticFields,
+            yarp::os::Stamp& timestamp)
         {
             assert(m_pimpl);
-            yarp::os::LockGuard guard(m_pimpl->m_mutex);
-            imuOrientations = m_pimpl->m_imuOrientations;
-            imuAngularVelocities = m_pimpl->m_imuAngularVelocities;
-            imuLinearAccelerations = m_pimpl->m_imuLinearAccelerations;
-            imuMagneticFields = m_pimpl->m_imuMagneticFields;
-            return m_pimpl->m_sensorsStatus;
+            return m_pimpl->copySensors(&imuOrientations,
+                                        &imuAngularVelocities,
+                                        &imuLinearAccelerations,
+                                        &imuMagneticFields,
+                                        timestamp);
+        }
+
+        // IFrameNotifier interface
+        bool XsensMVNRemote::waitForNextFrame(const yarp::os::Stamp& lastStamp,
+                                              const double timeout)
+        {
+            assert(m_pimpl);
+            return m_pimpl->m_newFrame.waitForNextFrame(
+                m_pimpl->m_segments, lastStamp.getCount(), lastStamp.getTime(), timeout);
+        }
+
+        // IFrameListenerRegistry interface
+        bool XsensMVNRemote::addFrameListener(yarp::experimental::dev::FrameListener& listener)
+        {
+            assert(m_pimpl);
+            return m_pimpl->m_frameListeners.add(listener);
+        }
+
+        bool XsensMVNRemote::removeFrameListener(yarp::experimental::dev::FrameListener& listener)
+        {
+            assert(m_pimpl);
+            return m_pimpl->m_frameListeners.remove(listener);
+        }
+
+        // IFrameProviderBulk interface
+        std::size_t XsensMVNRemote::frameBulkSize()
+        {
+            assert(m_pimpl);
+            return m_pimpl->m_segments.dataSize();
+        }
+
+        yarp::experimental::dev::IFrameProviderStatus XsensMVNRemote::getFrameBulk(
+            double* buffer,
+            const std::size_t bufferSize,
+            yarp::os::Stamp& timestamp)
+        {
+            assert(m_pimpl);
+            return xsens::copyBulk(m_pimpl->m_segments,
+                                   buffer,
+                                   bufferSize,
+                                   timestamp,
+                                   yarp::experimental::dev::IFrameProviderStatusError);
+        }
+
+        // IIMUFrameProviderBulk interface
+        std::size_t XsensMVNRemote::IMUFrameBulkSize()
+        {
+            assert(m_pimpl);
+            return m_pimpl->m_sensors.dataSize();
+        }
+
+        yarp::experimental::dev::IIMUFrameProviderStatus XsensMVNRemote::getIMUFrameBulk(
+            double* buffer,
+            const std::size_t bufferSize,
+            yarp::os::Stamp& timestamp)
+        {
+            assert(m_pimpl);
+            return xsens::copyBulk(m_pimpl->m_sensors,
+                                   buffer,
+                                   bufferSize,
+                                   timestamp,
+                                   yarp::experimental::dev::IIMUFrameProviderStatusError);
         }
 
         // IXsensMVNInterface interface
@@ -496,5 +858,17 @@ namespace yarp {
             return true;
         }
 
+        // IFrameHistoryProvider interface
+        yarp::experimental::dev::IFrameProviderStatus
+        XsensMVNRemote::getFrameAt(const double time,
+                                   std::vector<yarp::sig::Vector>& segmentPoses,
+                                   std::vector<yarp::sig::Vector>& segmentVelocities,
+                                   std::vector<yarp::sig::Vector>& segmentAccelerations)
+        {
+            assert(m_pimpl);
+            return m_pimpl->getFrameAt(
+                time, segmentPoses, segmentVelocities, segmentAccelerations);
+        }
+
     } // namespace dev
 } // namespace yarp
@@ -8,7 +8,10 @@
 #define YARP_XSENSMVNREMOTELIGHT_H
 
 #include <yarp/dev/DeviceDriver.h>
+#include <yarp/dev/IFrameListener.h>
+#include <yarp/dev/IFrameNotifier.h>
 #include <yarp/dev/IFrameProvider.h>
+#include <yarp/dev/IFrameProviderBulk.h>
 #include <yarp/dev/PreciselyTimed.h>
 
 namespace yarp {
@@ -21,6 +24,9 @@ class yarp::dev::XsensMVNRemoteLight
     : public yarp::dev::DeviceDriver
     , public yarp::dev::IPreciselyTimed
     , public yarp::experimental::dev::IFrameProvider
+    , public yarp::experimental::dev::IFrameProviderBulk
+    , public yarp::experimental::dev::IFrameNotifier
+    , public yarp::experimental::dev::IFrameListenerRegistry
 {
     class XsensMVNRemoteLightPrivate;
     XsensMVNRemoteLightPrivate* m_pimpl;
@@ -38,6 +44,7 @@ public:
 
     // IFrameProvider interface
     virtual std::vector<yarp::experimental::dev::FrameReference> frames();
+    virtual unsigned frameListVersion();
 
     virtual yarp::experimental::dev::IFrameProviderStatus
     getFramePoses(std::vector<yarp::sig::Vector>& segmentPoses);
@@ -49,6 +56,23 @@ public:
     getFrameInformation(std::vector<yarp::sig::Vector>& segmentPoses,
                         std::vector<yarp::sig::Vector>& segmentVelocities,
                         std::vector<yarp::sig::Vector>& segmentAccelerations);
+    virtual yarp::experimental::dev::IFrameProviderStatus
+    getStampedFrameInformation(std::vector<yarp::sig::Vector>& segmentPoses,
+                               std::vector<yarp::sig::Vector>& segmentVelocities,
+                               std::vector<yarp::sig::Vector>& segmentAccelerations,
+                               yarp::os::Stamp& timestamp);
+
+    // IFrameNotifier interface
+    virtual bool waitForNextFrame(const yarp::os::Stamp& lastStamp, const double timeout);
+
+    // IFrameListenerRegistry interface
+    virtual bool addFrameListener(yarp::experimental::dev::FrameListener& listener);
+    virtual bool removeFrameListener(yarp::experimental::dev::FrameListener& listener);
+
+    // IFrameProviderBulk interface
+    virtual std::size_t frameBulkSize();
+    virtual yarp::experimental::dev::IFrameProviderStatus
+    getFrameBulk(double* buffer, const std::size_t bufferSize, yarp::os::Stamp& timestamp);
 };
 
 #endif /* end of include guard: YARP_XSENSMVNREMOTELIGHT_H */
@@ -5,13 +5,13 @@
  */
 
 #include "XsensMVNRemoteLight.h"
+#include "XsensMVNPublishedFrame.h"
+#include "XsensMVNRemoteFrames.h"
 
 #include <thrift/XsensSegmentsFrame.h>
 
 #include <yarp/os/BufferedPort.h>
-#include <yarp/os/LockGuard.h>
 #include <yarp/os/LogStream.h>
-#include <yarp/os/Mutex.h>
 #include <yarp/os/Port.h>
 #include <yarp/os/Searchable.h>
 #include <yarp/os/Value.h>
@@ -35,70 +35,42 @@ namespace yarp {
             yarp::os::BufferedPort<xsens::XsensSegmentsFrame> m_inputPort;
             yarp::os::ConstString m_remoteStreamingPortName;
 
-            // Buffers for read & associated mutex
-            yarp::os::Mutex m_mutex;
-            std::vector<yarp::sig::Vector> m_poses;
-            std::vector<yarp::sig::Vector> m_velocities;
-            std::vector<yarp::sig::Vector> m_accelerations;
-            yarp::experimental::dev::IFrameProviderStatus m_status;
-            yarp::os::Stamp m_timestamp;
+            // Last frame decoded by the port thread, with the segments data laid out as in
+            // FrameBulkLayout. The getters read it without blocking the port thread
+            xsens::XsensMVNPublishedFrame m_segments;
 
             std::vector<yarp::experimental::dev::FrameReference> m_frames;
 
-            unsigned m_segmentsCount;
+            // signalled after each frame is published
+            xsens::XsensMVNFrameSignal m_newFrame;
+
+            // called on the port thread at the arrival of each frame
+            yarp::experimental::dev::FrameListenerList m_frameListeners;
 
             XsensMVNRemoteLightPrivate()
-                : m_status(yarp::experimental::dev::IFrameProviderStatusNoData)
-                , m_segmentsCount(0)
+                : m_segments(yarp::experimental::dev::IFrameProviderStatusNoData)
+                , m_newFrame(yarp::experimental::dev::IFrameProviderStatusNoData)
             {}
 
             virtual ~XsensMVNRemoteLightPrivate() {}
 
             virtual void onRead(xsens::XsensSegmentsFrame& frame)
             {
-                yarp::os::LockGuard guard(m_mutex);
-                // get timestamp
-                m_inputPort.getEnvelope(m_timestamp);
-                m_status = static_cast<yarp::experimental::dev::IFrameProviderStatus>(frame.status);
-
-                // if status is != OK we should not have any data
-                if (m_status != yarp::experimental::dev::IFrameProviderStatusOK)
-                    return;
-
-                for (unsigned seg = 0; seg < m_segmentsCount; ++seg) {
-                    xsens::Vector3& position = frame.segmentsData[seg].position;
-                    xsens::Quaternion& orientation = frame.segmentsData[seg].orientation;
-                    xsens::Vector3& linVelocity = frame.segmentsData[seg].velocity;
-                    xsens::Vector3& angVelocity = frame.segmentsData[seg].angularVelocity;
-                    xsens::Vector3& linAcceleration = frame.segmentsData[seg].acceleration;
-                    xsens::Vector3& angAcceleration = frame.segmentsData[seg].angularAcceleration;
-
-                    yarp::sig::Vector& newPose = m_poses[seg];
-                    yarp::sig::Vector& newVelocity = m_velocities[seg];
-                    yarp::sig::Vector& newAcceleration = m_accelerations[seg];
-
-                    newPose[0] = position.x;
-                    newPose[1] = position.y;
-                    newPose[2] = position.z;
-                    newPose[3] = orientation.w;
-                    newPose[4] = orientation.imaginary.x;
-                    newPose[5] = orientation.imaginary.y;
-                    newPose[6] = orientation.imaginary.z;
-
-                    newVelocity[0] = linVelocity.x;
-                    newVelocity[1] = linVelocity.y;
-                    newVelocity[2] = linVelocity.z;
-                    newVelocity[3] = angVelocity.x;
-                    newVelocity[4] = angVelocity.y;
-                    newVelocity[5] = angVelocity.z;
-
-                    newAcceleration[0] = linAcceleration.x;
-                    newAcceleration[1] = linAcceleration.y;
-                    newAcceleration[2] = linAcceleration.z;
-                    newAcceleration[3] = angAcceleration.x;
-                    newAcceleration[4] = angAcceleration.y;
-                    newAcceleration[5] = angAcceleration.z;
-                }
+                // decode in the back buffer, then publish it at once
+                double* buffer = m_segments.beginWrite();
+                yarp::os::Stamp timestamp;
+                m_inputPort.getEnvelope(timestamp);
+                // the frames list is fixed by the configuration: any data belongs to it
+                const yarp::experimental::dev::IFrameProviderStatus status =
+                    xsens::readSegments(frame,
+                                        timestamp,
+                                        true,
+                                        m_segments.writeDataSize()
+                                            / yarp::experimental::dev::FrameBulkStride,
+                                        buffer);
+                m_segments.commitWrite();
+                m_newFrame.notify(status);
+                m_frameListeners.notify(timestamp, status);
             }
         };
 
@@ -117,7 +89,6 @@ namespace yarp {
         bool XsensMVNRemoteLight::open(yarp::os::Searchable& config)
         {
             assert(m_pimpl);
-            yarp::os::LockGuard guard(m_pimpl->m_mutex);
 
             // as this is the light version read the frame information from a Bottle list
             if (!parseFrameListOption(config.find("segments"), m_pimpl->m_frames)) {
@@ -170,17 +141,8 @@ namespace yarp {
             }
 
             // Obtain information regarding size of data
-            size_t segmentCount = m_pimpl->m_frames.size();
-            m_pimpl->m_poses.reserve(segmentCount);
-            m_pimpl->m_velocities.reserve(segmentCount);
-            m_pimpl->m_accelerations.reserve(segmentCount);
-            m_pimpl->m_segmentsCount = segmentCount;
-
-            for (size_t i = 0; i < segmentCount; ++i) {
-                m_pimpl->m_poses.push_back(yarp::sig::Vector(7, 0.0));
-                m_pimpl->m_velocities.push_back(yarp::sig::Vector(6, 0.0));
-                m_pimpl->m_accelerations.push_back(yarp::sig::Vector(6, 0.0));
-            }
+            m_pimpl->m_segments.resize(m_pimpl->m_frames.size()
+                                       * yarp::experimental::dev::FrameBulkStride);
 
             // register for callbacks
             m_pimpl->m_inputPort.useCallback(*m_pimpl);
@@ -190,7 +152,6 @@ namespace yarp {
         bool XsensMVNRemoteLight::close()
         {
             assert(m_pimpl);
-            yarp::os::LockGuard guard(m_pimpl->m_mutex);
 
             m_pimpl->m_inputPort.disableCallback();
 
@@ -205,9 +166,7 @@ namespace yarp {
         yarp::os::Stamp XsensMVNRemoteLight::getLastInputStamp()
         {
             assert(m_pimpl);
-            yarp::os::LockGuard guard(m_pimpl->m_mutex);
-            return m_pimpl->m_timestamp;
-            ;
+            return xsens::lastPublishedStamp(m_pimpl->m_segments);
         }
 
         // IFrameProvider interface
@@ -217,45 +176,106 @@ namespace yarp {
             return m_pimpl->m_frames;
         }
 
+        unsigned XsensMVNRemoteLight::frameListVersion()
+        {
+            // the frames are read from the configuration and never change
+            return 1;
+        }
+
         // Get Data
         yarp::experimental::dev::IFrameProviderStatus
         XsensMVNRemoteLight::getFramePoses(std::vector<yarp::sig::Vector>& segmentPoses)
         {
             assert(m_pimpl);
-            yarp::os::LockGuard guard(m_pimpl->m_mutex);
-            segmentPoses = m_pimpl->m_poses;
-            return m_pimpl->m_status;
+            yarp::os::Stamp timestamp;
+            return xsens::copySegments(
+                m_pimpl->m_segments, &segmentPoses, nullptr, nullptr, timestamp);
         }
 
         yarp::experimental::dev::IFrameProviderStatus
         XsensMVNRemoteLight::getFrameVelocities(std::vector<yarp::sig::Vector>& segmentVelocities)
         {
             assert(m_pimpl);
-            yarp::os::LockGuard guard(m_pimpl->m_mutex);
-            segmentVelocities = m_pimpl->m_velocities;
-            return m_pimpl->m_status;
+            yarp::os::Stamp timestamp;
+            return xsens::copySegments(
+                m_pimpl->m_segments, nullptr, &segmentVelocities, nullptr, timestamp);
         }
 
         yarp::experimental::dev::IFrameProviderStatus XsensMVNRemoteLight::getFrameAccelerations(
             std::vector<yarp::sig::Vector>& segmentAccelerations)
         {
             assert(m_pimpl);
-            yarp::os::LockGuard guard(m_pimpl->m_mutex);
-            segmentAccelerations = m_pimpl->m_accelerations;
-            return m_pimpl->m_status;
+            yarp::os::Stamp timestamp;
+            return xsens::copySegments(
+                m_pimpl->m_segments, nullptr, nullptr, &segmentAccelerations, timestamp);
         }
 
         yarp::experimental::dev::IFrameProviderStatus XsensMVNRemoteLight::getFrameInformation(
             std::vector<yarp::sig::Vector>& segmentPoses,
             std::vector<yarp::sig::Vector>& segmentVelocities,
             std::vector<yarp::sig::Vector>& segmentAccelerations)
+        {
+            yarp::os::Stamp timestamp;
+            return getStampedFrameInformation(
+                segmentPoses, segmentVelocities, segmentAccelerations, timestamp);
+        }
+
+        yarp::experimental::dev::IFrameProviderStatus
+        XsensMVNRemoteLight::getStampedFrameInformation(
+            std::vector<yarp::sig::Vector>& segmentPoses,
+            std::vector<yarp::sig::Vector>& segmentVelocities,
+            std::vector<yarp::sig::Vector>& segmentAccelerations,
+            yarp::os::Stamp& timestamp)
+        {
+            assert(m_pimpl);
+            return xsens::copySegments(m_pimpl->m_segments,
+                                       &segmentPoses,
+                                       &segmentVelocities,
+                                       &segmentAccelerations,
+                                       timestamp);
+        }
+
+        // IFrameNotifier interface
+        bool XsensMVNRemoteLight::waitForNextFrame(const yarp::os::Stamp& lastStamp,
+                                                   const double timeout)
+        {
+            assert(m_pimpl);
+            return m_pimpl->m_newFrame.waitForNextFrame(
+                m_pimpl->m_segments, lastStamp.getCount(), lastStamp.getTime(), timeout);
+        }
+
+        // IFrameListenerRegistry interface
+        bool XsensMVNRemoteLight::addFrameListener(yarp::experimental::dev::FrameListener& listener)
+        {
+            assert(m_pimpl);
+            return m_pimpl->m_frameListeners.add(listener);
+        }
+
+        bool
+        XsensMVNRemoteLight::removeFrameListener(yarp::experimental::dev::FrameListener& listener)
+        {
+            assert(m_pimpl);
+            return m_pimpl->m_frameListeners.remove(listener);
+        }
+
+        // IFrameProviderBulk interface
+        std::size_t XsensMVNRemoteLight::frameBulkSize()
+        {
+            assert(m_pimpl);
+            return m_pimpl->m_segments.dataSize();
+        }
+
+        yarp::experimental::dev::IFrameProviderStatus XsensMVNRemoteLight::getFrameBulk(
+            double* buffer,
+            const std::size_t bufferSize,
+            yarp::os::Stamp& timestamp)
         {
             assert(m_pimpl);
-            yarp::os::LockGuard guard(m_pimpl->m_mutex);
-            segmentPoses = m_pimpl->m_poses;
-            segmentVelocities = m_pimpl->m_velocities;
-            segmentAccelerations = m_pimpl->m_accelerations;
-            return m_pimpl->m_status;
+            return xsens::copyBulk(m_pimpl->m_segments,
+                                   buffer,
+                                   bufferSize,
+                                   timestamp,
+                                   yarp::experimental::dev::IFrameProviderStatusError);
         }
 
         static bool
@@ -26,6 +26,7 @@ namespace yarp {
 namespace xsens {
     class XsensSegmentsFrame;
     class XsensSensorsFrame;
+    class XsensStatusFrame;
 } // namespace xsens
 
 class yarp::dev::XsensMVNWrapper
@@ -42,6 +43,7 @@ class yarp::dev::XsensMVNWrapper
     // explicitly define the ports we open
     yarp::os::BufferedPort<xsens::XsensSegmentsFrame>* m_segmentsOutputPort;
     yarp::os::BufferedPort<xsens::XsensSensorsFrame>* m_sensorsOutputPort;
+    yarp::os::BufferedPort<xsens::XsensStatusFrame>* m_statusOutputPort;
     yarp::os::Port* m_commandPort; // this implements the RPC thrift/XsensDriverService service
 
 public:
@@ -11,9 +11,15 @@
 #include <thrift/XsensDriverService.h>
 #include <thrift/XsensSegmentsFrame.h>
 #include <thrift/XsensSensorsFrame.h>
+#include <thrift/XsensStatusFrame.h>
+#include <yarp/dev/IFrameChannelSelection.h>
+#include <yarp/dev/IFrameDataProvider.h>
+#include <yarp/dev/IFrameNotifier.h>
 #include <yarp/dev/IFrameProvider.h>
 #include <yarp/dev/IIMUFrameProvider.h>
+#include <yarp/dev/IXsensMVNDiagnostics.h>
 #include <yarp/dev/IXsensMVNInterface.h>
+#include <yarp/dev/ThreadScheduling.h>
 #include <yarp/os/BufferedPort.h>
 #include <yarp/os/LockGuard.h>
 #include <yarp/os/LogStream.h>
@@ -21,11 +27,14 @@
 #include <yarp/os/Port.h>
 #include <yarp/os/RateThread.h>
 #include <yarp/os/Searchable.h>
+#include <yarp/os/Time.h>
 #include <yarp/os/Value.h>
 #include <yarp/sig/Vector.h>
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cmath>
 #include <vector>
 
 namespace yarp {
@@ -46,7 +55,24 @@ namespace yarp {
                 , m_imuFrameProvider(0)
                 , m_xsensInterface(0)
                 , m_timedDriver(0)
+                , m_diagnostics(0)
+                , m_frameNotifier(0)
+                , m_channelSelection(0)
+                , m_frameDataProvider(0)
                 , m_frameCount(0)
+                , m_imuFrameCount(0)
+                , m_frameListVersion(0)
+                , m_imuFrameListVersion(0)
+                , m_latencyReportPeriod(0)
+                , m_lastLatencyReportTime(0)
+                , m_lastStatusTime(0)
+                , m_lastFrameStatus(yarp::experimental::dev::IFrameProviderStatusNoData)
+                , m_period(100)
+                , m_publishOnNewFrame(false)
+                , m_minimumPublishInterval(0)
+                , m_lastPublishTime(0)
+                , m_unchangedFrames(UnchangedFramesRepublish)
+                , m_hasPublishedData(false)
             {}
 
             virtual ~XsensMVNWrapperPrivate() {}
@@ -55,6 +81,14 @@ namespace yarp {
             yarp::experimental::dev::IIMUFrameProvider* m_imuFrameProvider;
             yarp::experimental::dev::IXsensMVNInterface* m_xsensInterface;
             yarp::dev::IPreciselyTimed* m_timedDriver;
+            // optional, the device diagnostics are reported together with the wrapper ones
+            yarp::experimental::dev::IXsensMVNDiagnostics* m_diagnostics;
+            // optional, needed to publish on new frames
+            yarp::experimental::dev::IFrameNotifier* m_frameNotifier;
+            // optional, without it all the channels are written
+            yarp::experimental::dev::IFrameChannelSelection* m_channelSelection;
+            // optional, without it frames_since returns no frames
+            yarp::experimental::dev::IFrameDataProvider* m_frameDataProvider;
 
             std::vector<yarp::sig::Vector> m_poses;
             std::vector<yarp::sig::Vector> m_velocities;
@@ -67,37 +101,218 @@ namespace yarp {
 
             unsigned m_frameCount;
             unsigned m_imuFrameCount;
+            // versions of the frame lists, written in the frames so that the remotes can cache
+            // the lists. The frame counts are read again when they change
+            unsigned m_frameListVersion;
+            unsigned m_imuFrameListVersion;
+
+            // latency of the wrapper stages: pose time to read from the device, read to write
+            yarp::experimental::dev::LatencyHistogram m_poseToReadLatency;
+            yarp::experimental::dev::LatencyHistogram m_readToWriteLatency;
+            // distance of the periodic runs from the configured period
+            yarp::experimental::dev::LatencyHistogram m_periodJitter;
+            std::chrono::steady_clock::time_point m_lastRunTime;
+            // seconds, 0 to disable the periodic report
+            double m_latencyReportPeriod;
+            double m_lastLatencyReportTime;
+
+            // frames skipped or published more than once by the wrapper
+            yarp::experimental::dev::FrameContinuityMonitor m_publishedContinuity;
+            double m_lastStatusTime;
+            // the status port is also written at each change of the device status
+            yarp::experimental::dev::IFrameProviderStatus m_lastFrameStatus;
+
+            // period [ms] of the polling mode, and timeout of the wait for a new frame
+            int m_period;
+            // publish once per new frame instead of once per period
+            bool m_publishOnNewFrame;
+            // seconds, 0 for no rate cap
+            double m_minimumPublishInterval;
+            double m_lastPublishTime;
+            yarp::os::Stamp m_lastPublishedStamp;
+
+            yarp::experimental::dev::ThreadScheduling m_scheduling;
+
+            // what to write when the device stamp did not advance since the last data written
+            enum UnchangedFramesPolicy
+            {
+                UnchangedFramesRepublish,
+                UnchangedFramesSkip,
+                UnchangedFramesStatusOnly,
+            };
+            UnchangedFramesPolicy m_unchangedFrames;
+            // stamp of the last frame written with data
+            yarp::os::Stamp m_lastDataStamp;
+            bool m_hasPublishedData;
+
+            void setPublishMode(const bool publishOnNewFrame)
+            {
+                // When publishing on new frames the thread waits inside run(): keep the period
+                // short so that the next wait starts right after the publication
+                setRate(publishOnNewFrame ? 1 : m_period);
+            }
+
+            void writeStatus()
+            {
+                xsens::XsensStatusFrame& status = m_wrapper.m_statusOutputPort->prepare();
+                status.frameContinuity = frame_continuity_statistics();
+                status.status = static_cast<std::int32_t>(m_lastFrameStatus);
+                m_wrapper.m_statusOutputPort->write();
+            }
+
+            void reportLatencyStatistics()
+            {
+                std::vector<xsens::LatencyStatistics> statistics = latency_statistics();
+                for (const xsens::LatencyStatistics& stage : statistics) {
+                    yInfo("Latency %s: %lld samples, mean %.3lf ms, min %.3lf ms, max %.3lf ms, "
+                          "median %.3lf ms, 99%% %.3lf ms",
+                          stage.stage.c_str(),
+                          static_cast<long long>(stage.count),
+                          stage.mean * 1e3,
+                          stage.minimum * 1e3,
+                          stage.maximum * 1e3,
+                          stage.median * 1e3,
+                          stage.percentile99 * 1e3);
+                }
+            }
+
+            virtual bool threadInit()
+            {
+                if (!yarp::experimental::dev::applyThreadScheduling(m_scheduling)) {
+                    yWarning("Wrapper thread running without some of the thread options");
+                }
+                m_lastRunTime = std::chrono::steady_clock::time_point();
+                return true;
+            }
 
             virtual void run()
             {
                 assert(m_wrapper.m_segmentsOutputPort);
                 assert(m_wrapper.m_sensorsOutputPort);
 
-                if (!m_frameProvider || !m_imuFrameProvider)
+                // the interfaces change in attach() and detach(), under m_mutex
+                bool attached;
+                yarp::experimental::dev::IFrameNotifier* frameNotifier;
+                {
+                    yarp::os::LockGuard guard(m_mutex);
+                    attached = m_frameProvider && m_imuFrameProvider;
+                    frameNotifier = m_publishOnNewFrame ? m_frameNotifier : 0;
+                }
+
+                if (!frameNotifier) {
+                    const std::chrono::steady_clock::time_point runTime =
+                        std::chrono::steady_clock::now();
+                    if (m_lastRunTime != std::chrono::steady_clock::time_point()) {
+                        const double interval =
+                            std::chrono::duration<double>(runTime - m_lastRunTime).count();
+                        m_periodJitter.record(std::abs(interval - m_period / 1000.0));
+                    }
+                    m_lastRunTime = runTime;
+                }
+
+                if (!attached)
                     return;
+
+                if (frameNotifier) {
+                    if (m_minimumPublishInterval > 0) {
+                        double remaining =
+                            m_lastPublishTime + m_minimumPublishInterval - yarp::os::Time::now();
+                        if (remaining > 0) {
+                            yarp::os::Time::delay(remaining);
+                        }
+                    }
+                    // On timeout the unchanged frame is handled as in the periodic mode. The wait
+                    // is outside m_mutex: detach() stops this thread before the device can go
+                    frameNotifier->waitForNextFrame(m_lastPublishedStamp, m_period / 1000.0);
+                }
+
                 // read from device
                 yarp::os::LockGuard guard(m_mutex);
+                if (!m_frameProvider || !m_imuFrameProvider)
+                    return;
+                const std::chrono::steady_clock::time_point readTime =
+                    std::chrono::steady_clock::now();
 
+                // the stamp is read together with the segments, so that it is the one of the data
+                yarp::os::Stamp timestamp;
                 yarp::experimental::dev::IFrameProviderStatus frameStatus =
-                    m_frameProvider->getFrameInformation(m_poses, m_velocities, m_accelerations);
+                    m_frameProvider->getStampedFrameInformation(
+                        m_poses, m_velocities, m_accelerations, timestamp);
                 yarp::experimental::dev::IIMUFrameProviderStatus imuFrameStatus =
                     m_imuFrameProvider->getIMUFrameInformation(m_imuOrientations,
                                                                m_imuAngularVelocities,
                                                                m_imuLinearAccelerations,
                                                                m_imuMagneticFields);
+                if (!timestamp.isValid()) {
+                    // the provider does not stamp its frames
+                    timestamp = m_timedDriver->getLastInputStamp();
+                }
+                m_lastPublishedStamp = timestamp;
+                // the stamp carries the SDK time (system time), as yarp::os::Time
+                const double now = yarp::os::Time::now();
+                m_lastPublishTime = now;
+
+                m_publishedContinuity.advance(now);
+                const bool statusChanged = frameStatus != m_lastFrameStatus;
+                if (statusChanged) {
+                    m_lastFrameStatus = frameStatus;
+                }
+                if (statusChanged || now - m_lastStatusTime >= 1.0) {
+                    writeStatus();
+                    m_lastStatusTime = now;
+                }
+
+                const bool dataAvailable =
+                    frameStatus == yarp::experimental::dev::IFrameProviderStatusOK
+                    && imuFrameStatus == yarp::experimental::dev::IIMUFrameProviderStatusOK;
+                const bool newFrame = dataAvailable
+                                      && (!m_hasPublishedData
+                                          || timestamp.getCount() != m_lastDataStamp.getCount()
+                                          || timestamp.getTime() != m_lastDataStamp.getTime());
+                // the frames without data carry no pose time, and an unchanged frame was measured
+                // when it was first read
+                if (newFrame) {
+                    m_poseToReadLatency.record(now - timestamp.getTime());
+                }
+                const bool unchanged =
+                    dataAvailable && !newFrame && m_unchangedFrames != UnchangedFramesRepublish;
+                if (unchanged && m_unchangedFrames == UnchangedFramesSkip) {
+                    return;
+                }
+
                 xsens::XsensSegmentsFrame& frame = m_wrapper.m_segmentsOutputPort->prepare();
                 xsens::XsensSensorsFrame& imuFrame = m_wrapper.m_sensorsOutputPort->prepare();
 
-                yarp::os::Stamp timestamp = m_timedDriver->getLastInputStamp();
-
                 m_wrapper.m_segmentsOutputPort->setEnvelope(timestamp);
                 m_wrapper.m_sensorsOutputPort->setEnvelope(timestamp);
 
+                const unsigned frameListVersion = m_frameProvider->frameListVersion();
+                if (frameListVersion != m_frameListVersion) {
+                    m_frameListVersion = frameListVersion;
+                    m_frameCount = m_frameProvider->getFrameCount();
+                }
+                const unsigned imuFrameListVersion = m_imuFrameProvider->IMUFrameListVersion();
+                if (imuFrameListVersion != m_imuFrameListVersion) {
+                    m_imuFrameListVersion = imuFrameListVersion;
+                    m_imuFrameCount = m_imuFrameProvider->getIMUFrameCount();
+                }
+
                 frame.status = static_cast<xsens::XsensStatus>(frameStatus);
                 imuFrame.status = static_cast<xsens::XsensStatus>(imuFrameStatus);
-
-                if (frameStatus != yarp::experimental::dev::IFrameProviderStatusOK
-                    || imuFrameStatus != yarp::experimental::dev::IFrameProviderStatusOK) {
+                frame.modelVersion = static_cast<std::int32_t>(m_frameListVersion);
+                imuFrame.modelVersion = static_cast<std::int32_t>(m_imuFrameListVersion);
+
+                // disabled channels are written as zeros. A group without enabled channels is
+                // written without data and flagged, as an empty frame of status OK is an unchanged
+                // frame, whose last data the remotes keep
+                const unsigned channels = m_channelSelection
+                                              ? m_channelSelection->enabledChannels()
+                                              : yarp::experimental::dev::FrameChannelAll;
+                frame.channelsDisabled =
+                    !(channels & yarp::experimental::dev::FrameChannelSegments);
+                imuFrame.channelsDisabled = !(channels & yarp::experimental::dev::FrameChannelIMUs);
+
+                if (!dataAvailable || unchanged) {
                     // write without data. Only status
                     // I would like to clear the data so as to transmit only the status.
                     frame.segmentsData.resize(0);
@@ -107,8 +322,25 @@ namespace yarp {
                     return;
                 }
 
-                frame.segmentsData.resize(m_frameCount);
-                for (unsigned seg = 0; seg < m_frameCount; ++seg) {
+                m_publishedContinuity.recordFrame(timestamp.getCount());
+                m_lastDataStamp = timestamp;
+                m_hasPublishedData = true;
+
+                const bool pose = channels & yarp::experimental::dev::FrameChannelPose;
+                const bool velocity = channels & yarp::experimental::dev::FrameChannelVelocity;
+                const bool acceleration =
+                    channels & yarp::experimental::dev::FrameChannelAcceleration;
+
+                // the model may change between the read of the data and of the frame count: never
+                // fill past the vectors read
+                const std::size_t segmentCount =
+                    std::min<std::size_t>(m_frameCount,
+                                          std::min(m_poses.size(),
+                                                   std::min(m_velocities.size(),
+                                                            m_accelerations.size())));
+                frame.segmentsData.resize(
+                    channels & yarp::experimental::dev::FrameChannelSegments ? segmentCount : 0);
+                for (unsigned seg = 0; seg < frame.segmentsData.size(); ++seg) {
                     xsens::Vector3& position = frame.segmentsData[seg].position;
                     xsens::Quaternion& orientation = frame.segmentsData[seg].orientation;
                     xsens::Vector3& linVelocity = frame.segmentsData[seg].velocity;
@@ -120,31 +352,64 @@ namespace yarp {
                     yarp::sig::Vector& newVelocity = m_velocities[seg];
                     yarp::sig::Vector& newAcceleration = m_accelerations[seg];
 
-                    position.x = newPose[0];
-                    position.y = newPose[1];
-                    position.z = newPose[2];
-                    orientation.w = newPose[3];
-                    orientation.imaginary.x = newPose[4];
-                    orientation.imaginary.y = newPose[5];
-                    orientation.imaginary.z = newPose[6];
-
-                    linVelocity.x = newVelocity[0];
-                    linVelocity.y = newVelocity[1];
-                    linVelocity.z = newVelocity[2];
-                    angVelocity.x = newVelocity[3];
-                    angVelocity.y = newVelocity[4];
-                    angVelocity.z = newVelocity[5];
-
-                    linAcceleration.x = newAcceleration[0];
-                    linAcceleration.y = newAcceleration[1];
-                    linAcceleration.z = newAcceleration[2];
-                    angAcceleration.x = newAcceleration[3];
-                    angAcceleration.y = newAcceleration[4];
-                    angAcceleration.z = newAcceleration[5];
+                    if (pose) {
+                        position.x = newPose[0];
+                        position.y = newPose[1];
+                        position.z = newPose[2];
+                        orientation.w = newPose[3];
+                        orientation.imaginary.x = newPose[4];
+                        orientation.imaginary.y = newPose[5];
+                        orientation.imaginary.z = newPose[6];
+                    }
+                    else {
+                        position = xsens::Vector3();
+                        orientation = xsens::Quaternion();
+                    }
+
+                    if (velocity) {
+                        linVelocity.x = newVelocity[0];
+                        linVelocity.y = newVelocity[1];
+                        linVelocity.z = newVelocity[2];
+                        angVelocity.x = newVelocity[3];
+                        angVelocity.y = newVelocity[4];
+                        angVelocity.z = newVelocity[5];
+                    }
+                    else {
+                        linVelocity = xsens::Vector3();
+                        angVelocity = xsens::Vector3();
+                    }
+
+                    if (acceleration) {
+                        linAcceleration.x = newAcceleration[0];
+                        linAcceleration.y = newAcceleration[1];
+                        linAcceleration.z = newAcceleration[2];
+                        angAcceleration.x = newAcceleration[3];
+                        angAcceleration.y = newAcceleration[4];
+                        angAcceleration.z = newAcceleration[5];
+                    }
+                    else {
+                        linAcceleration = xsens::Vector3();
+                        angAcceleration = xsens::Vector3();
+                    }
                 }
 
-                imuFrame.sensorsData.resize(m_imuFrameCount);
-                for (unsigned sens = 0; sens < m_imuFrameCount; ++sens) {
+                const bool imuOrientations =
+                    channels & yarp::experimental::dev::FrameChannelIMUOrientation;
+                const bool imuAngularVelocities =
+                    channels & yarp::experimental::dev::FrameChannelIMUAngularVelocity;
+                const bool imuLinearAccelerations =
+                    channels & yarp::experimental::dev::FrameChannelIMULinearAcceleration;
+                const bool imuMagneticFields =
+                    channels & yarp::experimental::dev::FrameChannelIMUMagneticField;
+
+                const std::size_t imuCount = std::min<std::size_t>(
+                    m_imuFrameCount,
+                    std::min(std::min(m_imuOrientations.size(), m_imuAngularVelocities.size()),
+                             std::min(m_imuLinearAccelerations.size(),
+                                      m_imuMagneticFields.size())));
+                imuFrame.sensorsData.resize(
+                    channels & yarp::experimental::dev::FrameChannelIMUs ? imuCount : 0);
+                for (unsigned sens = 0; sens < imuFrame.sensorsData.size(); ++sens) {
                     xsens::Quaternion& imuOrientation = imuFrame.sensorsData[sens].orientation;
                     xsens::Vector3& imuAngularVelocity = imuFrame.sensorsData[sens].angularVelocity;
                     xsens::Vector3& imuLinearAcceleration = imuFrame.sensorsData[sens].acceleration;
@@ -155,25 +420,54 @@ namespace yarp {
                     yarp::sig::Vector& newImuLinearAcceleration = m_imuLinearAccelerations[sens];
                     yarp::sig::Vector& newMagneticField = m_imuMagneticFields[sens];
 
-                    imuOrientation.w = newImuOrientation[0];
-                    imuOrientation.imaginary.x = newImuOrientation[1];
-                    imuOrientation.imaginary.y = newImuOrientation[2];
-                    imuOrientation.imaginary.z = newImuOrientation[3];
-
-                    imuAngularVelocity.x = newImuAngularVelocity[0];
-                    imuAngularVelocity.y = newImuAngularVelocity[1];
-                    imuAngularVelocity.z = newImuAngularVelocity[2];
-
-                    imuLinearAcceleration.x = newImuLinearAcceleration[0];
-                    imuLinearAcceleration.y = newImuLinearAcceleration[1];
-                    imuLinearAcceleration.z = newImuLinearAcceleration[2];
-
-                    imuMagneticField.x = newMagneticField[0];
-                    imuMagneticField.y = newMagneticField[1];
-                    imuMagneticField.z = newMagneticField[2];
+                    if (imuOrientations) {
+                        imuOrientation.w = newImuOrientation[0];
+                        imuOrientation.imaginary.x = newImuOrientation[1];
+                        imuOrientation.imaginary.y = newImuOrientation[2];
+                        imuOrientation.imaginary.z = newImuOrientation[3];
+                    }
+                    else {
+                        imuOrientation = xsens::Quaternion();
+                    }
+
+                    if (imuAngularVelocities) {
+                        imuAngularVelocity.x = newImuAngularVelocity[0];
+                        imuAngularVelocity.y = newImuAngularVelocity[1];
+                        imuAngularVelocity.z = newImuAngularVelocity[2];
+                    }
+                    else {
+                        imuAngularVelocity = xsens::Vector3();
+                    }
+
+                    if (imuLinearAccelerations) {
+                        imuLinearAcceleration.x = newImuLinearAcceleration[0];
+                        imuLinearAcceleration.y = newImuLinearAcceleration[1];
+                        imuLinearAcceleration.z = newImuLinearAcceleration[2];
+                    }
+                    else {
+                        imuLinearAcceleration = xsens::Vector3();
+                    }
+
+                    if (imuMagneticFields) {
+                        imuMagneticField.x = newMagneticField[0];
+                        imuMagneticField.y = newMagneticField[1];
+                        imuMagneticField.z = newMagneticField[2];
+                    }
+                    else {
+                        imuMagneticField = xsens::Vector3();
+                    }
                 }
                 m_wrapper.m_segmentsOutputPort->write();
                 m_wrapper.m_sensorsOutputPort->write();
+                m_readToWriteLatency.record(
+                    std::chrono::duration<double>(std::chrono::steady_clock::now() - readTime)
+                        .count());
+
+                if (m_latencyReportPeriod > 0
+                    && yarp::os::Time::now() - m_lastLatencyReportTime > m_latencyReportPeriod) {
+                    reportLatencyStatistics();
+                    m_lastLatencyReportTime = yarp::os::Time::now();
+                }
             }
 
             virtual void calibrateAsync() { calibrateWithType(""); }
@@ -251,6 +545,20 @@ namespace yarp {
                 return serializableObject;
             }
 
+            virtual std::int32_t segments_order_version()
+            {
+                if (!m_frameProvider)
+                    return 0;
+                return static_cast<std::int32_t>(m_frameProvider->frameListVersion());
+            }
+
+            virtual std::int32_t imu_segments_order_version()
+            {
+                if (!m_imuFrameProvider)
+                    return 0;
+                return static_cast<std::int32_t>(m_imuFrameProvider->IMUFrameListVersion());
+            }
+
             virtual std::map<std::string, double> bodyDimensions()
             {
                 if (!m_xsensInterface)
@@ -272,12 +580,142 @@ namespace yarp {
                     return false;
                 return m_xsensInterface->setBodyDimensions(dimensions);
             }
+
+            virtual std::vector<xsens::LatencyStatistics> latency_statistics()
+            {
+                std::vector<yarp::experimental::dev::LatencyStatistics> statistics;
+                if (m_diagnostics) {
+                    statistics = m_diagnostics->latencyStatistics();
+                }
+                statistics.push_back(m_poseToReadLatency.statistics("wrapper/pose-to-read"));
+                statistics.push_back(m_readToWriteLatency.statistics("wrapper/read-to-write"));
+                statistics.push_back(m_periodJitter.statistics("wrapper/period-jitter"));
+
+                // convert from underlining yarp::dev object into thrift object
+                std::vector<xsens::LatencyStatistics> serializableObject;
+                serializableObject.reserve(statistics.size());
+                for (const yarp::experimental::dev::LatencyStatistics& stage : statistics) {
+                    xsens::LatencyStatistics serializableStage;
+                    serializableStage.stage = stage.stage;
+                    serializableStage.count = static_cast<std::int64_t>(stage.count);
+                    serializableStage.mean = stage.mean;
+                    serializableStage.minimum = stage.minimum;
+                    serializableStage.maximum = stage.maximum;
+                    serializableStage.median = stage.median;
+                    serializableStage.percentile99 = stage.percentile99;
+                    serializableObject.push_back(serializableStage);
+                }
+                return serializableObject;
+            }
+
+            virtual void reset_latency_statistics()
+            {
+                if (m_diagnostics) {
+                    m_diagnostics->resetLatencyStatistics();
+                }
+                m_poseToReadLatency.reset();
+                m_readToWriteLatency.reset();
+                m_periodJitter.reset();
+            }
+
+            virtual std::vector<xsens::FrameContinuityStatistics> frame_continuity_statistics()
+            {
+                std::vector<yarp::experimental::dev::FrameContinuityStatistics> statistics;
+                if (m_diagnostics) {
+                    statistics = m_diagnostics->frameContinuityStatistics();
+                }
+                statistics.push_back(m_publishedContinuity.statistics("wrapper"));
+
+                // convert from underlining yarp::dev object into thrift object
+                std::vector<xsens::FrameContinuityStatistics> serializableObject;
+                serializableObject.reserve(statistics.size());
+                for (const yarp::experimental::dev::FrameContinuityStatistics& source :
+                     statistics) {
+                    xsens::FrameContinuityStatistics serializableSource;
+                    serializableSource.source = source.source;
+                    serializableSource.total = toSerializable(source.total);
+                    serializableSource.lastSecond = toSerializable(source.lastSecond);
+                    serializableObject.push_back(serializableSource);
+                }
+                return serializableObject;
+            }
+
+            virtual void reset_frame_continuity_statistics()
+            {
+                if (m_diagnostics) {
+                    m_diagnostics->resetFrameContinuityStatistics();
+                }
+                m_publishedContinuity.reset();
+            }
+
+            virtual xsens::FrameDataHistory frames_since(const std::int32_t lastFrameNumber)
+            {
+                xsens::FrameDataHistory serializableObject;
+                serializableObject.segmentCount = 0;
+                serializableObject.sensorCount = 0;
+                serializableObject.frameCount = 0;
+                unsigned segmentCount = 0;
+                unsigned sensorCount = 0;
+                if (!m_frameDataProvider
+                    || !m_frameDataProvider->frameDataLayout(segmentCount, sensorCount)) {
+                    return serializableObject;
+                }
+                serializableObject.segmentCount = static_cast<std::int32_t>(segmentCount);
+                serializableObject.sensorCount = static_cast<std::int32_t>(sensorCount);
+                serializableObject.frameCount = static_cast<std::int32_t>(
+                    m_frameDataProvider->getFramesSince(lastFrameNumber, serializableObject.data));
+                return serializableObject;
+            }
+
+            virtual bool set_enabled_channels(const std::string& segments,
+                                              const std::string& sensors)
+            {
+                if (!m_channelSelection) {
+                    yError("The device does not support the selection of the channels");
+                    return false;
+                }
+                unsigned segmentChannels = 0;
+                unsigned imuChannels = 0;
+                if (!yarp::experimental::dev::parseSegmentChannels(segments, segmentChannels)
+                    || !yarp::experimental::dev::parseIMUChannels(sensors, imuChannels)) {
+                    yError("Invalid channels: segments '%s', sensors '%s'",
+                           segments.c_str(),
+                           sensors.c_str());
+                    return false;
+                }
+                return m_channelSelection->setEnabledChannels(segmentChannels | imuChannels);
+            }
+
+            virtual xsens::EnabledChannels enabled_channels()
+            {
+                const unsigned channels = m_channelSelection
+                                              ? m_channelSelection->enabledChannels()
+                                              : yarp::experimental::dev::FrameChannelAll;
+                xsens::EnabledChannels serializableObject;
+                serializableObject.segments =
+                    yarp::experimental::dev::segmentChannelsToString(channels);
+                serializableObject.sensors = yarp::experimental::dev::imuChannelsToString(channels);
+                return serializableObject;
+            }
+
+            static xsens::FrameCounters
+            toSerializable(const yarp::experimental::dev::FrameCounters& counters)
+            {
+                xsens::FrameCounters serializableCounters;
+                serializableCounters.frames = static_cast<std::int64_t>(counters.frames);
+                serializableCounters.missing = static_cast<std::int64_t>(counters.missing);
+                serializableCounters.duplicated = static_cast<std::int64_t>(counters.duplicated);
+                serializableCounters.outOfOrder = static_cast<std::int64_t>(counters.outOfOrder);
+                serializableCounters.dropped = static_cast<std::int64_t>(counters.dropped);
+                return serializableCounters;
+            }
         };
 
         XsensMVNWrapper::XsensMVNWrapper()
             : m_pimpl(new XsensMVNWrapperPrivate(*this))
             , m_segmentsOutputPort(0)
             , m_sensorsOutputPort(0)
+            , m_statusOutputPort(0)
             , m_commandPort(0)
         {}
 
@@ -295,7 +733,57 @@ namespace yarp {
             int period =
                 config.check("period", yarp::os::Value(100), "Checking wrapper period [ms]")
                     .asInt();
-            m_pimpl->setRate(period);
+            m_pimpl->m_period = period;
+            yarp::os::ConstString publishMode =
+                config
+                    .check("publish-mode",
+                           yarp::os::Value("periodic"),
+                           "Checking publish mode (periodic or on-new-frame)")
+                    .asString();
+            if (publishMode != "periodic" && publishMode != "on-new-frame") {
+                yError("Invalid publish-mode '%s'", publishMode.c_str());
+                return false;
+            }
+            m_pimpl->m_publishOnNewFrame = publishMode == "on-new-frame";
+            double maxPublishRate =
+                config
+                    .check("max-publish-rate",
+                           yarp::os::Value(0.0),
+                           "Checking maximum publish rate in on-new-frame mode [Hz] (0 for none)")
+                    .asDouble();
+            m_pimpl->m_minimumPublishInterval = maxPublishRate > 0 ? 1.0 / maxPublishRate : 0;
+            // periodic until attach() finds a device notifying its frames
+            m_pimpl->setPublishMode(false);
+            yarp::os::ConstString unchangedFrames =
+                config
+                    .check("unchanged-frames",
+                           yarp::os::Value("republish"),
+                           "Checking how frames with an unchanged stamp are written "
+                           "(republish, skip or status-only)")
+                    .asString();
+            if (unchangedFrames == "republish") {
+                m_pimpl->m_unchangedFrames = XsensMVNWrapperPrivate::UnchangedFramesRepublish;
+            }
+            else if (unchangedFrames == "skip") {
+                m_pimpl->m_unchangedFrames = XsensMVNWrapperPrivate::UnchangedFramesSkip;
+            }
+            else if (unchangedFrames == "status-only") {
+                m_pimpl->m_unchangedFrames = XsensMVNWrapperPrivate::UnchangedFramesStatusOnly;
+            }
+            else {
+                yError("Invalid unchanged-frames '%s'", unchangedFrames.c_str());
+                return false;
+            }
+            if (!yarp::experimental::dev::parseThreadScheduling(
+                    config, "thread", m_pimpl->m_scheduling)) {
+                return false;
+            }
+            m_pimpl->m_latencyReportPeriod =
+                config
+                    .check("latency-report-period",
+                           yarp::os::Value(0.0),
+                           "Checking period of the latency report [s] (0 to disable)")
+                    .asDouble();
             yarp::os::ConstString wrapperName =
                 config.check("name", yarp::os::Value("/xsens"), "Checking wrapper name").asString();
             if (wrapperName.empty() || wrapperName.at(0) != '/') {
@@ -319,6 +807,14 @@ namespace yarp {
                 return false;
             }
 
+            m_statusOutputPort = new yarp::os::BufferedPort<xsens::XsensStatusFrame>();
+
+            if (!m_statusOutputPort || !m_statusOutputPort->open(wrapperName + "/status:o")) {
+                yError("Could not open status output port");
+                close();
+                return false;
+            }
+
             m_commandPort = new yarp::os::Port();
             if (!m_commandPort || !m_commandPort->open(wrapperName + "/cmd:i")) {
                 yError("Could not open command input port");
@@ -347,6 +843,11 @@ namespace yarp {
                 delete m_sensorsOutputPort;
                 m_sensorsOutputPort = 0;
             }
+            if (m_statusOutputPort) {
+                m_statusOutputPort->close();
+                delete m_statusOutputPort;
+                m_statusOutputPort = 0;
+            }
             if (m_commandPort) {
                 m_commandPort->close();
                 delete m_commandPort;
@@ -386,7 +887,28 @@ namespace yarp {
             if (!poly->view(m_pimpl->m_timedDriver) || !m_pimpl->m_timedDriver)
                 return false;
 
+            // diagnostics are optional
+            if (!poly->view(m_pimpl->m_diagnostics)) {
+                m_pimpl->m_diagnostics = 0;
+            }
+
+            if (!poly->view(m_pimpl->m_frameNotifier)) {
+                m_pimpl->m_frameNotifier = 0;
+            }
+            if (!poly->view(m_pimpl->m_channelSelection)) {
+                m_pimpl->m_channelSelection = 0;
+            }
+            if (!poly->view(m_pimpl->m_frameDataProvider)) {
+                m_pimpl->m_frameDataProvider = 0;
+            }
+            if (m_pimpl->m_publishOnNewFrame && !m_pimpl->m_frameNotifier) {
+                yWarning("The device does not notify new frames. Publishing every %d ms",
+                         m_pimpl->m_period);
+            }
+            m_pimpl->setPublishMode(m_pimpl->m_publishOnNewFrame && m_pimpl->m_frameNotifier);
+
             // resize the vectors
+            m_pimpl->m_frameListVersion = m_pimpl->m_frameProvider->frameListVersion();
             m_pimpl->m_frameCount = m_pimpl->m_frameProvider->getFrameCount();
             m_pimpl->m_poses.resize(m_pimpl->m_frameCount);
             m_pimpl->m_velocities.resize(m_pimpl->m_frameCount);
@@ -400,6 +922,7 @@ namespace yarp {
             frame.segmentsData.reserve(m_pimpl->m_frameCount);
             m_segmentsOutputPort->unprepare();
 
+            m_pimpl->m_imuFrameListVersion = m_pimpl->m_imuFrameProvider->IMUFrameListVersion();
             m_pimpl->m_imuFrameCount = m_pimpl->m_imuFrameProvider->getIMUFrameCount();
             m_pimpl->m_imuOrientations.resize(m_pimpl->m_imuFrameCount);
             m_pimpl->m_imuAngularVelocities.resize(m_pimpl->m_imuFrameCount);
@@ -422,12 +945,25 @@ namespace yarp {
         bool XsensMVNWrapper::detach()
         {
             assert(m_pimpl);
-            yarp::os::LockGuard guard(m_pimpl->m_mutex);
-            m_pimpl->m_frameProvider = 0;
-            m_pimpl->m_imuFrameProvider = 0;
-            m_pimpl->m_xsensInterface = 0;
-            m_pimpl->m_timedDriver = 0;
-            return true;
+            // run() waits for the frames of the device outside m_mutex: stop it before the device
+            // can be closed, and restart it for the next device
+            const bool running = m_pimpl->isRunning();
+            if (running) {
+                m_pimpl->stop();
+            }
+            {
+                yarp::os::LockGuard guard(m_pimpl->m_mutex);
+                m_pimpl->m_frameProvider = 0;
+                m_pimpl->m_imuFrameProvider = 0;
+                m_pimpl->m_xsensInterface = 0;
+                m_pimpl->m_timedDriver = 0;
+                m_pimpl->m_diagnostics = 0;
+                m_pimpl->m_frameNotifier = 0;
+                m_pimpl->m_channelSelection = 0;
+                m_pimpl->m_frameDataProvider = 0;
+                m_pimpl->setPublishMode(false);
+            }
+            return running ? m_pimpl->start() : true;
         }
 
         bool XsensMVNWrapper::attachAll(const yarp::dev::PolyDriverList& driverList)
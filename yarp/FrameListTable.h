@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef YARP_DEV_FRAMELISTTABLE_H
+#define YARP_DEV_FRAMELISTTABLE_H
+
+#include <algorithm>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace yarp {
+    namespace experimental {
+        namespace dev {
+            template <typename Reference, typename Hash>
+            class FrameListTable;
+        } // namespace dev
+    } // namespace experimental
+} // namespace yarp
+
+// Frame list of a provider and its index, cached by the default implementations of the lookup
+// methods of IFrameProvider and IIMUFrameProvider. Private to yarp_experimental: it does not
+// depend on YARP, so that it can be tested alone
+template <typename Reference, typename Hash>
+class yarp::experimental::dev::FrameListTable
+{
+public:
+    std::mutex mutex;
+    // 0 when the table is empty (the version of the unversioned providers)
+    unsigned version;
+    std::vector<Reference> frames;
+    std::unordered_map<Reference, int, Hash> indices;
+
+    FrameListTable()
+        : version(0)
+    {}
+
+    // Rebuild the table from listFrames() if the provider has a newer version (currentVersion).
+    // Call with mutex locked
+    template <typename ListFrames>
+    void update(const unsigned currentVersion, ListFrames listFrames)
+    {
+        if (currentVersion == 0) {
+            // unversioned provider: never cache
+            frames = listFrames();
+            indices.clear();
+            version = 0;
+            return;
+        }
+        if (currentVersion == version) {
+            return;
+        }
+        frames = listFrames();
+        indices.clear();
+        indices.reserve(frames.size());
+        for (unsigned index = 0; index < frames.size(); ++index) {
+            // the first occurrence wins, as in a linear search
+            indices.insert(std::make_pair(frames[index], static_cast<int>(index)));
+        }
+        version = currentVersion;
+    }
+
+    // The frame at index, or a frame of empty names if index is out of range
+    Reference frameAt(const unsigned index) const
+    {
+        if (index >= frames.size()) {
+            return Reference();
+        }
+        return frames[index];
+    }
+
+    int indexOf(const Reference& frame) const
+    {
+        if (version == 0) {
+            typename std::vector<Reference>::const_iterator found =
+                std::find(frames.begin(), frames.end(), frame);
+            if (found == frames.end())
+                return -1;
+            return static_cast<int>(std::distance(frames.begin(), found));
+        }
+        typename std::unordered_map<Reference, int, Hash>::const_iterator found =
+            indices.find(frame);
+        return found == indices.end() ? -1 : found->second;
+    }
+};
+
+#endif /* End of YARP_DEV_FRAMELISTTABLE_H */
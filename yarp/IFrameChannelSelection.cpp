@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "IFrameChannelSelection.h"
+
+namespace {
+    struct ChannelName
+    {
+        const char* name;
+        unsigned channel;
+    };
+
+    const ChannelName SegmentChannelNames[] = {
+        {"pose", yarp::experimental::dev::FrameChannelPose},
+        {"velocity", yarp::experimental::dev::FrameChannelVelocity},
+        {"acceleration", yarp::experimental::dev::FrameChannelAcceleration},
+    };
+
+    const ChannelName IMUChannelNames[] = {
+        {"orientation", yarp::experimental::dev::FrameChannelIMUOrientation},
+        {"angular-velocity", yarp::experimental::dev::FrameChannelIMUAngularVelocity},
+        {"linear-acceleration", yarp::experimental::dev::FrameChannelIMULinearAcceleration},
+        {"magnetic-field", yarp::experimental::dev::FrameChannelIMUMagneticField},
+    };
+
+    template <std::size_t N>
+    bool parseChannels(const std::string& names,
+                       const ChannelName (&table)[N],
+                       const unsigned allChannels,
+                       unsigned& channels)
+    {
+        if (names == "all") {
+            channels = allChannels;
+            return true;
+        }
+        unsigned parsed = 0;
+        if (names != "none") {
+            std::string::size_type begin = 0;
+            while (begin <= names.size()) {
+                std::string::size_type end = names.find(',', begin);
+                if (end == std::string::npos) {
+                    end = names.size();
+                }
+                const std::string name = names.substr(begin, end - begin);
+                bool found = false;
+                for (const ChannelName& entry : table) {
+                    if (name == entry.name) {
+                        parsed |= entry.channel;
+                        found = true;
+                        break;
+                    }
+                }
+                if (!found) {
+                    return false;
+                }
+                begin = end + 1;
+            }
+        }
+        channels = parsed;
+        return true;
+    }
+
+    template <std::size_t N>
+    std::string channelsToString(const unsigned channels,
+                                 const ChannelName (&table)[N],
+                                 const unsigned allChannels)
+    {
+        if ((channels & allChannels) == allChannels) {
+            return "all";
+        }
+        std::string names;
+        for (const ChannelName& entry : table) {
+            if (channels & entry.channel) {
+                if (!names.empty()) {
+                    names += ",";
+                }
+                names += entry.name;
+            }
+        }
+        return names.empty() ? "none" : names;
+    }
+} // namespace
+
+bool yarp::experimental::dev::parseSegmentChannels(const std::string& names, unsigned& channels)
+{
+    return parseChannels(names, SegmentChannelNames, FrameChannelSegments, channels);
+}
+
+bool yarp::experimental::dev::parseIMUChannels(const std::string& names, unsigned& channels)
+{
+    return parseChannels(names, IMUChannelNames, FrameChannelIMUs, channels);
+}
+
+std::string yarp::experimental::dev::segmentChannelsToString(const unsigned channels)
+{
+    return channelsToString(channels, SegmentChannelNames, FrameChannelSegments);
+}
+
+std::string yarp::experimental::dev::imuChannelsToString(const unsigned channels)
+{
+    return channelsToString(channels, IMUChannelNames, FrameChannelIMUs);
+}
+
+yarp::experimental::dev::IFrameChannelSelection::~IFrameChannelSelection() {}
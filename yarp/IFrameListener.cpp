@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "IFrameListener.h"
+
+#include <algorithm>
+#include <iterator>
+
+yarp::experimental::dev::FrameListener::~FrameListener() {}
+
+yarp::experimental::dev::IFrameListenerRegistry::~IFrameListenerRegistry() {}
+
+yarp::experimental::dev::FrameListenerList::FrameListenerList()
+    : m_listeners(std::make_shared<const std::vector<FrameListener*>>())
+    , m_runningNotifications(0)
+    , m_lastStatus(IFrameProviderStatusNoData)
+{}
+
+bool yarp::experimental::dev::FrameListenerList::add(FrameListener& listener)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (std::find(m_listeners->begin(), m_listeners->end(), &listener) != m_listeners->end()) {
+        return false;
+    }
+    std::shared_ptr<std::vector<FrameListener*>> listeners =
+        std::make_shared<std::vector<FrameListener*>>(*m_listeners);
+    listeners->push_back(&listener);
+    m_listeners = listeners;
+    return true;
+}
+
+bool yarp::experimental::dev::FrameListenerList::remove(FrameListener& listener)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (std::find(m_listeners->begin(), m_listeners->end(), &listener) == m_listeners->end()) {
+        return false;
+    }
+    std::shared_ptr<std::vector<FrameListener*>> listeners =
+        std::make_shared<std::vector<FrameListener*>>();
+    listeners->reserve(m_listeners->size() - 1);
+    std::remove_copy(
+        m_listeners->begin(), m_listeners->end(), std::back_inserter(*listeners), &listener);
+    m_listeners = listeners;
+    // waits for the running notifications, which may still call the listener, so that it is not
+    // called after this returns
+    m_notificationsDone.wait(lock, [this]() { return m_runningNotifications == 0; });
+    return true;
+}
+
+void yarp::experimental::dev::FrameListenerList::notify(const yarp::os::Stamp& timestamp,
+                                                        const IFrameProviderStatus status)
+{
+    std::shared_ptr<const std::vector<FrameListener*>> listeners;
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        if (status == m_lastStatus && timestamp.getCount() == m_lastStamp.getCount()
+            && timestamp.getTime() == m_lastStamp.getTime()) {
+            return;
+        }
+        m_lastStamp = timestamp;
+        m_lastStatus = status;
+        listeners = m_listeners;
+        ++m_runningNotifications;
+    }
+    // without the lock: a listener may call the provider, whose threads may be adding or removing
+    // listeners meanwhile
+    for (FrameListener* listener : *listeners) {
+        listener->onNewFrame(timestamp, status);
+    }
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        --m_runningNotifications;
+    }
+    m_notificationsDone.notify_all();
+}
@@ -8,38 +8,65 @@
 
 #include "IFrameProvider.h"
 
-#include <algorithm>
+#include "FrameListTable.h"
+
+#include <yarp/os/Stamp.h>
+
+#include <functional>
+#include <mutex>
+
+namespace {
+    struct FrameReferenceHash
+    {
+        std::size_t operator()(const yarp::experimental::dev::FrameReference& frame) const
+        {
+            std::hash<std::string> hash;
+            return hash(frame.frameReference) * 31 + hash(frame.frameName);
+        }
+    };
+} // namespace
 
 namespace yarp {
     namespace experimental {
         namespace dev {
 
+            class IFrameProvider::FrameTable
+                : public FrameListTable<FrameReference, FrameReferenceHash>
+            {};
+
             bool FrameReference::operator==(const FrameReference& frame) const
             {
                 return frame.frameName == this->frameName
                        && frame.frameReference == this->frameReference;
             }
 
-            IFrameProvider::~IFrameProvider() {}
+            IFrameProvider::IFrameProvider()
+                : m_frameTable(new FrameTable())
+            {}
+
+            IFrameProvider::~IFrameProvider() { delete m_frameTable; }
+
+            unsigned IFrameProvider::frameListVersion() { return 0; }
+
+            unsigned IFrameProvider::getFrameCount()
+            {
+                std::lock_guard<std::mutex> guard(m_frameTable->mutex);
+                m_frameTable->update(frameListVersion(), [this]() { return frames(); });
+                return m_frameTable->frames.size();
+            }
 
-            unsigned IFrameProvider::getFrameCount() { return frames().size(); }
             FrameReference IFrameProvider::frameAtIndex(unsigned frameIndex)
             {
-                if (frameIndex >= getFrameCount()) {
-                    FrameReference dummy = {"", ""};
-                    return dummy;
-                }
-                return frames()[frameIndex];
+                std::lock_guard<std::mutex> guard(m_frameTable->mutex);
+                m_frameTable->update(frameListVersion(), [this]() { return frames(); });
+                return m_frameTable->frameAt(frameIndex);
             }
 
             int IFrameProvider::frameIndexForFrame(const FrameReference& frame)
             {
-                std::vector<FrameReference> frames = this->frames();
-                std::vector<FrameReference>::iterator found =
-                    std::find(frames.begin(), frames.end(), frame);
-                if (found == frames.end())
-                    return -1;
-                return std::distance(frames.begin(), found);
+                std::lock_guard<std::mutex> guard(m_frameTable->mutex);
+                m_frameTable->update(frameListVersion(), [this]() { return frames(); });
+                return m_frameTable->indexOf(frame);
             }
 
             IFrameProviderStatus IFrameProvider::getFrameInformation(
@@ -58,6 +85,16 @@ namespace yarp {
                 return getFrameAccelerations(segmentAccelerations);
             }
 
+            IFrameProviderStatus IFrameProvider::getStampedFrameInformation(
+                std::vector<yarp::sig::Vector>& segmentPoses,
+                std::vector<yarp::sig::Vector>& segmentVelocities,
+                std::vector<yarp::sig::Vector>& segmentAccelerations,
+                yarp::os::Stamp& timestamp)
+            {
+                timestamp = yarp::os::Stamp();
+                return getFrameInformation(segmentPoses, segmentVelocities, segmentAccelerations);
+            }
+
         } // namespace dev
     } // namespace experimental
 } // namespace yarp
@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "IFrameProviderBulk.h"
+
+#include <yarp/sig/Vector.h>
+
+void yarp::experimental::dev::copyFromFrameBulk(const double* buffer,
+                                                const unsigned count,
+                                                const std::size_t stride,
+                                                const std::size_t offset,
+                                                const std::size_t width,
+                                                std::vector<yarp::sig::Vector>& values)
+{
+    if (values.size() != count) {
+        values.resize(count);
+    }
+    for (unsigned index = 0; index < count; ++index) {
+        yarp::sig::Vector& value = values[index];
+        if (value.size() != width) {
+            value.resize(width);
+        }
+        const double* block = buffer + stride * index + offset;
+        for (std::size_t k = 0; k < width; ++k) {
+            value(k) = block[k];
+        }
+    }
+}
+
+yarp::experimental::dev::IFrameProviderBulk::~IFrameProviderBulk() {}
+
+yarp::experimental::dev::IIMUFrameProviderBulk::~IIMUFrameProviderBulk() {}
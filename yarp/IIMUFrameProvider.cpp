@@ -8,39 +8,65 @@
 
 #include "IIMUFrameProvider.h"
 
-#include <algorithm>
+#include "FrameListTable.h"
+
+#include <yarp/os/Stamp.h>
+
+#include <functional>
+#include <mutex>
+
+namespace {
+    struct IMUFrameReferenceHash
+    {
+        std::size_t operator()(const yarp::experimental::dev::IMUFrameReference& frame) const
+        {
+            std::hash<std::string> hash;
+            return hash(frame.IMUframeReference) * 31 + hash(frame.IMUframeName);
+        }
+    };
+} // namespace
 
 namespace yarp {
     namespace experimental {
         namespace dev {
 
+            class IIMUFrameProvider::IMUFrameTable
+                : public FrameListTable<IMUFrameReference, IMUFrameReferenceHash>
+            {};
+
             bool IMUFrameReference::operator==(const IMUFrameReference& frame) const
             {
                 return frame.IMUframeName == this->IMUframeName
                        && frame.IMUframeReference == this->IMUframeReference;
             }
 
-            IIMUFrameProvider::~IIMUFrameProvider() {}
+            IIMUFrameProvider::IIMUFrameProvider()
+                : m_IMUFrameTable(new IMUFrameTable())
+            {}
 
-            unsigned IIMUFrameProvider::getIMUFrameCount() { return IMUFrames().size(); }
+            IIMUFrameProvider::~IIMUFrameProvider() { delete m_IMUFrameTable; }
+
+            unsigned IIMUFrameProvider::IMUFrameListVersion() { return 0; }
+
+            unsigned IIMUFrameProvider::getIMUFrameCount()
+            {
+                std::lock_guard<std::mutex> guard(m_IMUFrameTable->mutex);
+                m_IMUFrameTable->update(IMUFrameListVersion(), [this]() { return IMUFrames(); });
+                return m_IMUFrameTable->frames.size();
+            }
 
             IMUFrameReference IIMUFrameProvider::IMUFrameAtIndex(unsigned IMUFrameIndex)
             {
-                if (IMUFrameIndex >= getIMUFrameCount()) {
-                    IMUFrameReference dummy = {"", ""};
-                    return dummy;
-                }
-                return IMUFrames()[IMUFrameIndex];
+                std::lock_guard<std::mutex> guard(m_IMUFrameTable->mutex);
+                m_IMUFrameTable->update(IMUFrameListVersion(), [this]() { return IMUFrames(); });
+                return m_IMUFrameTable->frameAt(IMUFrameIndex);
             }
 
             int IIMUFrameProvider::IMUFrameIndexForIMUFrame(const IMUFrameReference& frame)
             {
-                std::vector<IMUFrameReference> frames = this->IMUFrames();
-                std::vector<IMUFrameReference>::iterator found =
-                    std::find(frames.begin(), frames.end(), frame);
-                if (found == frames.end())
-                    return -1;
-                return std::distance(frames.begin(), found);
+                std::lock_guard<std::mutex> guard(m_IMUFrameTable->mutex);
+                m_IMUFrameTable->update(IMUFrameListVersion(), [this]() { return IMUFrames(); });
+                return m_IMUFrameTable->indexOf(frame);
             }
 
             IIMUFrameProviderStatus IIMUFrameProvider::getIMUFrameInformation(
@@ -63,6 +89,20 @@ namespace yarp {
                 }
                 return getIMUFrameMagneticFields(imuMagneticFields);
             }
+
+            IIMUFrameProviderStatus IIMUFrameProvider::getStampedIMUFrameInformation(
+                std::vector<yarp::sig::Vector>& imuOrientations,
+                std::vector<yarp::sig::Vector>& imuAngularVelocities,
+                std::vector<yarp::sig::Vector>& imuLinearAccelerations,
+                std::vector<yarp::sig::Vector>& imuMagneticFields,
+                yarp::os::Stamp& timestamp)
+            {
+                timestamp = yarp::os::Stamp();
+                return getIMUFrameInformation(imuOrientations,
+                                              imuAngularVelocities,
+                                              imuLinearAccelerations,
+                                              imuMagneticFields);
+            }
         } // namespace dev
     } // namespace experimental
 } // namespace yarp
@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "IXsensMVNDiagnostics.h"
+
+#include <cmath>
+#include <limits>
+
+namespace {
+    // Bins 0-3 count 0-3 us, then every octave [2^e, 2^(e+1)) us is split in four bins
+    unsigned binForMicroseconds(const std::uint64_t microseconds)
+    {
+        if (microseconds < 4) {
+            return static_cast<unsigned>(microseconds);
+        }
+        unsigned exponent = 2;
+        while (exponent < 63 && (microseconds >> (exponent + 1)) != 0) {
+            ++exponent;
+        }
+        const unsigned subBin = static_cast<unsigned>((microseconds >> (exponent - 2)) & 3);
+        const unsigned bin = 4 * (exponent - 1) + subBin;
+        return bin < yarp::experimental::dev::LatencyHistogram::BinCount
+                   ? bin
+                   : yarp::experimental::dev::LatencyHistogram::BinCount - 1;
+    }
+
+    // Centre of the bin, in seconds
+    double binLatency(const unsigned bin)
+    {
+        if (bin < 4) {
+            return bin * 1e-6;
+        }
+        const unsigned exponent = bin / 4 + 1;
+        const double lower = static_cast<double>(4 + bin % 4) * (1ull << (exponent - 2));
+        const double width = static_cast<double>(1ull << (exponent - 2));
+        return (lower + width / 2) * 1e-6;
+    }
+} // namespace
+
+yarp::experimental::dev::LatencyHistogram::LatencyHistogram()
+{
+    reset();
+}
+
+void yarp::experimental::dev::LatencyHistogram::record(const double latency)
+{
+    // Negative latencies come from stamps of another clock (e.g. of another machine), non finite
+    // or huge ones from invalid stamps: they would spoil the mean and the extremes. An hour also
+    // keeps the conversion to nanoseconds in range
+    if (!std::isfinite(latency) || latency < 0 || latency > MaximumLatency) {
+        return;
+    }
+    const std::int64_t nanoseconds = static_cast<std::int64_t>(latency * 1e9);
+    const std::uint64_t microseconds = static_cast<std::uint64_t>(nanoseconds / 1000);
+
+    m_bins[binForMicroseconds(microseconds)].fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(nanoseconds, std::memory_order_relaxed);
+
+    std::int64_t minimum = m_minimum.load(std::memory_order_relaxed);
+    while (nanoseconds < minimum
+           && !m_minimum.compare_exchange_weak(minimum, nanoseconds, std::memory_order_relaxed)) {
+    }
+    std::int64_t maximum = m_maximum.load(std::memory_order_relaxed);
+    while (nanoseconds > maximum
+           && !m_maximum.compare_exchange_weak(maximum, nanoseconds, std::memory_order_relaxed)) {
+    }
+    m_count.fetch_add(1, std::memory_order_release);
+}
+
+void yarp::experimental::dev::LatencyHistogram::reset()
+{
+    for (unsigned bin = 0; bin < BinCount; ++bin) {
+        m_bins[bin].store(0, std::memory_order_relaxed);
+    }
+    m_sum.store(0, std::memory_order_relaxed);
+    m_minimum.store(std::numeric_limits<std::int64_t>::max(), std::memory_order_relaxed);
+    m_maximum.store(std::numeric_limits<std::int64_t>::min(), std::memory_order_relaxed);
+    m_count.store(0, std::memory_order_release);
+}
+
+yarp::experimental::dev::LatencyStatistics
+yarp::experimental::dev::LatencyHistogram::statistics(const std::string& stage) const
+{
+    // The counters are read one by one: a sample recorded meanwhile may be partially included
+    LatencyStatistics statistics = {stage, 0, 0, 0, 0, 0, 0};
+    statistics.count = m_count.load(std::memory_order_acquire);
+    if (statistics.count == 0) {
+        return statistics;
+    }
+    statistics.mean = m_sum.load(std::memory_order_relaxed) * 1e-9 / statistics.count;
+    statistics.minimum = m_minimum.load(std::memory_order_relaxed) * 1e-9;
+    statistics.maximum = m_maximum.load(std::memory_order_relaxed) * 1e-9;
+
+    std::uint64_t bins[BinCount];
+    std::uint64_t binnedCount = 0;
+    for (unsigned bin = 0; bin < BinCount; ++bin) {
+        bins[bin] = m_bins[bin].load(std::memory_order_relaxed);
+        binnedCount += bins[bin];
+    }
+    const double medianRank = 0.5 * binnedCount;
+    const double percentile99Rank = 0.99 * binnedCount;
+    std::uint64_t cumulativeCount = 0;
+    bool medianFound = false;
+    for (unsigned bin = 0; bin < BinCount; ++bin) {
+        cumulativeCount += bins[bin];
+        if (!medianFound && cumulativeCount >= medianRank) {
+            statistics.median = binLatency(bin);
+            medianFound = true;
+        }
+        if (cumulativeCount >= percentile99Rank) {
+            statistics.percentile99 = binLatency(bin);
+            break;
+        }
+    }
+    return statistics;
+}
+
+yarp::experimental::dev::FrameContinuityMonitor::FrameContinuityMonitor()
+    : m_resetRequested(true)
+    , m_secondStart(0)
+    , m_lastFrameNumber(0)
+    , m_hasFrame(false)
+{
+    for (unsigned counter = 0; counter < CounterCount; ++counter) {
+        m_total[counter].store(0, std::memory_order_relaxed);
+        m_lastSecond[counter].store(0, std::memory_order_relaxed);
+        m_currentSecond[counter] = 0;
+    }
+}
+
+void yarp::experimental::dev::FrameContinuityMonitor::count(const Counter counter,
+                                                            const std::uint64_t value)
+{
+    m_total[counter].fetch_add(value, std::memory_order_relaxed);
+    m_currentSecond[counter] += value;
+}
+
+void yarp::experimental::dev::FrameContinuityMonitor::recordFrame(const long long frameNumber)
+{
+    count(Frames, 1);
+    if (!m_hasFrame) {
+        m_hasFrame = true;
+        m_lastFrameNumber = frameNumber;
+        return;
+    }
+    if (frameNumber == m_lastFrameNumber) {
+        count(Duplicated, 1);
+    }
+    else if (frameNumber < m_lastFrameNumber - RestartJump) {
+        // new numbering: counting the next frames against the old one would make them all out of
+        // order
+        m_lastFrameNumber = frameNumber;
+    }
+    else if (frameNumber < m_lastFrameNumber) {
+        // the previous frame stays the reference for the next ones
+        count(OutOfOrder, 1);
+    }
+    else {
+        count(Missing, static_cast<std::uint64_t>(frameNumber - m_lastFrameNumber - 1));
+        m_lastFrameNumber = frameNumber;
+    }
+}
+
+void yarp::experimental::dev::FrameContinuityMonitor::recordDropped(const std::uint64_t count)
+{
+    if (count > 0) {
+        this->count(Dropped, count);
+    }
+}
+
+void yarp::experimental::dev::FrameContinuityMonitor::advance(const double now)
+{
+    if (m_resetRequested.exchange(false)) {
+        // counters are cleared by reset(), here only the state of the recording thread
+        for (unsigned counter = 0; counter < CounterCount; ++counter) {
+            m_currentSecond[counter] = 0;
+        }
+        m_secondStart = now;
+        m_hasFrame = false;
+        return;
+    }
+    if (now - m_secondStart < 1.0) {
+        return;
+    }
+    // more than a second without advancing: the last complete second saw nothing
+    const bool idle = now - m_secondStart >= 2.0;
+    for (unsigned counter = 0; counter < CounterCount; ++counter) {
+        m_lastSecond[counter].store(idle ? 0 : m_currentSecond[counter],
+                                    std::memory_order_relaxed);
+        m_currentSecond[counter] = 0;
+    }
+    m_secondStart = idle ? now : m_secondStart + 1.0;
+}
+
+void yarp::experimental::dev::FrameContinuityMonitor::reset()
+{
+    for (unsigned counter = 0; counter < CounterCount; ++counter) {
+        m_total[counter].store(0, std::memory_order_relaxed);
+        m_lastSecond[counter].store(0, std::memory_order_relaxed);
+    }
+    m_resetRequested.store(true);
+}
+
+yarp::experimental::dev::FrameContinuityStatistics
+yarp::experimental::dev::FrameContinuityMonitor::statistics(const std::string& source) const
+{
+    // The counters are read one by one: they may be off by the frames recorded meanwhile
+    std::uint64_t total[CounterCount];
+    std::uint64_t lastSecond[CounterCount];
+    for (unsigned counter = 0; counter < CounterCount; ++counter) {
+        total[counter] = m_total[counter].load(std::memory_order_relaxed);
+        lastSecond[counter] = m_lastSecond[counter].load(std::memory_order_relaxed);
+    }
+    FrameContinuityStatistics statistics = {
+        source,
+        {total[Frames], total[Missing], total[Duplicated], total[OutOfOrder], total[Dropped]},
+        {lastSecond[Frames],
+         lastSecond[Missing],
+         lastSecond[Duplicated],
+         lastSecond[OutOfOrder],
+         lastSecond[Dropped]}};
+    return statistics;
+}
+
+yarp::experimental::dev::IXsensMVNDiagnostics::~IXsensMVNDiagnostics() {}
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "ThreadScheduling.h"
+
+#include <yarp/os/Bottle.h>
+#include <yarp/os/LogStream.h>
+#include <yarp/os/Searchable.h>
+#include <yarp/os/Value.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <cstring>
+#endif
+
+bool yarp::experimental::dev::parseThreadScheduling(yarp::os::Searchable& config,
+                                                    const std::string& prefix,
+                                                    ThreadScheduling& scheduling)
+{
+    scheduling = ThreadScheduling();
+
+    const std::string policyKey = prefix + "-policy";
+    yarp::os::ConstString policy =
+        config
+            .check(policyKey,
+                   yarp::os::Value("default"),
+                   "Checking scheduling policy (default, fifo or round-robin)")
+            .asString();
+    if (policy == "fifo") {
+        scheduling.policy = ThreadScheduling::PolicyFIFO;
+    }
+    else if (policy == "round-robin") {
+        scheduling.policy = ThreadScheduling::PolicyRoundRobin;
+    }
+    else if (policy != "default") {
+        yError("Invalid %s '%s'", policyKey.c_str(), policy.c_str());
+        return false;
+    }
+
+    const std::string priorityKey = prefix + "-priority";
+    scheduling.priority =
+        config
+            .check(priorityKey,
+                   yarp::os::Value(0),
+                   "Checking priority of the real-time scheduling policies")
+            .asInt();
+    if (scheduling.policy != ThreadScheduling::PolicyDefault && scheduling.priority <= 0) {
+        yError("%s must be positive with a real-time policy", priorityKey.c_str());
+        return false;
+    }
+
+    const std::string cpusKey = prefix + "-cpus";
+    if (config.check(cpusKey)) {
+        yarp::os::Value& cpus = config.find(cpusKey);
+        if (cpus.isInt()) {
+            scheduling.cpus.push_back(cpus.asInt());
+        }
+        else if (cpus.isList()) {
+            yarp::os::Bottle* list = cpus.asList();
+            for (int i = 0; i < list->size(); ++i) {
+                if (!list->get(i).isInt()) {
+                    yError("%s must contain CPU indices", cpusKey.c_str());
+                    return false;
+                }
+                scheduling.cpus.push_back(list->get(i).asInt());
+            }
+        }
+        else {
+            yError("%s must be a CPU index or a list of CPU indices", cpusKey.c_str());
+            return false;
+        }
+        for (int cpu : scheduling.cpus) {
+            if (cpu < 0) {
+                yError("Invalid CPU index %d in %s", cpu, cpusKey.c_str());
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+#if defined(__linux__)
+bool yarp::experimental::dev::applyThreadScheduling(const ThreadScheduling& scheduling)
+{
+    bool result = true;
+    if (scheduling.policy != ThreadScheduling::PolicyDefault) {
+        sched_param parameters;
+        std::memset(&parameters, 0, sizeof(parameters));
+        parameters.sched_priority = scheduling.priority;
+        const int policy =
+            scheduling.policy == ThreadScheduling::PolicyFIFO ? SCHED_FIFO : SCHED_RR;
+        int error = pthread_setschedparam(pthread_self(), policy, &parameters);
+        if (error != 0) {
+            yWarning("Failed to set the scheduling policy: %s", std::strerror(error));
+            result = false;
+        }
+    }
+    if (!scheduling.cpus.empty()) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (int cpu : scheduling.cpus) {
+            if (cpu < CPU_SETSIZE) {
+                CPU_SET(cpu, &cpus);
+            }
+        }
+        int error = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        if (error != 0) {
+            yWarning("Failed to set the CPU affinity: %s", std::strerror(error));
+            result = false;
+        }
+    }
+    return result;
+}
+#elif defined(_WIN32)
+bool yarp::experimental::dev::applyThreadScheduling(const ThreadScheduling& scheduling)
+{
+    bool result = true;
+    if (scheduling.policy != ThreadScheduling::PolicyDefault) {
+        if (!SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL)) {
+            yWarning("Failed to set the thread priority: error %lu", GetLastError());
+            result = false;
+        }
+    }
+    if (!scheduling.cpus.empty()) {
+        DWORD_PTR mask = 0;
+        for (int cpu : scheduling.cpus) {
+            if (cpu < static_cast<int>(8 * sizeof(DWORD_PTR))) {
+                mask |= static_cast<DWORD_PTR>(1) << cpu;
+            }
+        }
+        if (!SetThreadAffinityMask(GetCurrentThread(), mask)) {
+            yWarning("Failed to set the CPU affinity: error %lu", GetLastError());
+            result = false;
+        }
+    }
+    return result;
+}
+#else
+bool yarp::experimental::dev::applyThreadScheduling(const ThreadScheduling& scheduling)
+{
+    if (scheduling.policy != ThreadScheduling::PolicyDefault || !scheduling.cpus.empty()) {
+        yWarning("Thread scheduling options are not supported on this platform");
+        return false;
+    }
+    return true;
+}
+#endif
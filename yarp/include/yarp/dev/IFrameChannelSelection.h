@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef YARP_DEV_IFRAMECHANNELSELECTION_H
+#define YARP_DEV_IFRAMECHANNELSELECTION_H
+
+#include <yarp/dev/api.h>
+
+#include <string>
+
+namespace yarp {
+    namespace experimental {
+        namespace dev {
+            class IFrameChannelSelection;
+
+            /**
+             * Channels of the frame and IMU frame providers, to be combined in a mask.
+             * Each segment channel carries both the linear and the angular part
+             */
+            enum FrameChannel
+            {
+                FrameChannelPose = 1 << 0,
+                FrameChannelVelocity = 1 << 1,
+                FrameChannelAcceleration = 1 << 2,
+                FrameChannelIMUOrientation = 1 << 3,
+                FrameChannelIMUAngularVelocity = 1 << 4,
+                FrameChannelIMULinearAcceleration = 1 << 5,
+                FrameChannelIMUMagneticField = 1 << 6,
+
+                FrameChannelSegments =
+                    FrameChannelPose | FrameChannelVelocity | FrameChannelAcceleration,
+                FrameChannelIMUs = FrameChannelIMUOrientation | FrameChannelIMUAngularVelocity
+                                   | FrameChannelIMULinearAcceleration
+                                   | FrameChannelIMUMagneticField,
+                FrameChannelAll = FrameChannelSegments | FrameChannelIMUs
+            };
+
+            /**
+             * Parse a comma separated list of segment channels (pose, velocity, acceleration),
+             * or "all", or "none", into a mask of FrameChannel
+             * @return false if a channel is unknown
+             */
+            bool parseSegmentChannels(const std::string& names, unsigned& channels);
+            /**
+             * Parse a comma separated list of IMU channels (orientation, angular-velocity,
+             * linear-acceleration, magnetic-field), or "all", or "none", into a mask of
+             * FrameChannel
+             * @return false if a channel is unknown
+             */
+            bool parseIMUChannels(const std::string& names, unsigned& channels);
+            // Inverse of the parse functions: only the channels of the respective group are used
+            std::string segmentChannelsToString(const unsigned channels);
+            std::string imuChannelsToString(const unsigned channels);
+        } // namespace dev
+    } // namespace experimental
+} // namespace yarp
+
+/**
+ * Interface of the frame providers that can skip the processing of the channels nobody uses
+ * \since 2.3.69
+ */
+class yarp::experimental::dev::IFrameChannelSelection
+{
+public:
+    virtual ~IFrameChannelSelection();
+
+    /**
+     * Enables the channels in the mask and disables the others. Disabled channels are neither
+     * processed nor copied by the getters, which leave the corresponding vectors untouched
+     * @param channels combination of FrameChannel
+     * @return true if the channels are valid and were applied
+     */
+    virtual bool setEnabledChannels(const unsigned channels) = 0;
+
+    /**
+     * @return the mask (combination of FrameChannel) of the enabled channels
+     */
+    virtual unsigned enabledChannels() = 0;
+};
+
+#endif /* end of include guard: YARP_DEV_IFRAMECHANNELSELECTION_H */
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef YARP_DEV_IFRAMEDATAPROVIDER_H
+#define YARP_DEV_IFRAMEDATAPROVIDER_H
+
+#include <yarp/dev/IFrameProvider.h>
+#include <yarp/dev/api.h>
+#include <yarp/os/Stamp.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace yarp {
+    namespace experimental {
+        namespace dev {
+            class IFrameDataProvider;
+        } // namespace dev
+    } // namespace experimental
+} // namespace yarp
+
+/**
+ * Interface of the providers that copy the segments and the IMUs of a frame at once, and keep a
+ * history of the last frames for the consumers slower than the device.
+ *
+ * A frame is a flat buffer [frame number, time | one block per channel], with the blocks in the
+ * order: segment positions, segment orientations, segment linear velocities, segment angular
+ * velocities, segment linear accelerations, segment angular accelerations, IMU orientations, IMU
+ * angular velocities, IMU linear accelerations, IMU magnetic fields. Each block stores the values
+ * of all the segments (or IMUs) contiguously, orientations as (w, x, y, z) and the other channels
+ * as (x, y, z).
+ * \since 2.3.69
+ */
+class yarp::experimental::dev::IFrameDataProvider
+{
+public:
+    virtual ~IFrameDataProvider();
+
+    /**
+     * Number of segments and IMUs of the frames, which fix their layout
+     * @return false if the provider has no model yet
+     */
+    virtual bool frameDataLayout(unsigned& segmentCount, unsigned& imuCount) = 0;
+
+    /**
+     * Copies the last frame in frameData, resized only if its size does not match
+     * @param timestamp stamp of the copied frame
+     * @return the status of the provider
+     */
+    virtual IFrameProviderStatus getLastFrameData(yarp::os::Stamp& timestamp,
+                                                  std::vector<double>& frameData) = 0;
+
+    /**
+     * Copies the frames of the history newer than lastFrameNumber, oldest first, one after the
+     * other in framesData. If the newest frame is older than lastFrameNumber the frame numbering
+     * restarted, and the whole history is returned
+     * @param lastFrameNumber last frame already processed, -1 for the whole history
+     * @return the number of frames copied
+     */
+    virtual std::size_t getFramesSince(const int lastFrameNumber,
+                                       std::vector<double>& framesData) = 0;
+};
+
+#endif /* end of include guard: YARP_DEV_IFRAMEDATAPROVIDER_H */
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef YARP_DEV_IFRAMEHISTORYPROVIDER_H
+#define YARP_DEV_IFRAMEHISTORYPROVIDER_H
+
+#include <yarp/dev/IFrameProvider.h>
+#include <yarp/dev/api.h>
+#include <yarp/sig/Vector.h>
+
+#include <vector>
+
+namespace yarp {
+    namespace experimental {
+        namespace dev {
+            class IFrameHistoryProvider;
+        } // namespace dev
+    } // namespace experimental
+} // namespace yarp
+
+/**
+ * Interface of the frame providers that keep a history of the last segments frames, to sample the
+ * segments at a time of the consumer (e.g. the stamp of a camera image) instead of taking the last
+ * frame
+ * \since 2.3.69
+ */
+class yarp::experimental::dev::IFrameHistoryProvider
+{
+public:
+    virtual ~IFrameHistoryProvider();
+
+    /**
+     * Segments data at time, interpolated between the two frames of the history around it:
+     * positions, velocities and accelerations linearly, orientations by slerp. No extrapolation
+     * is done: after the newest frame the newest frame is returned, but only up to a hold time
+     * of the provider (about one frame period). The vectors are resized only if their size does
+     * not match
+     * @param time time in the time base of the frame stamps
+     * @return IFrameProviderStatusNoData if the history is disabled, empty or does not reach back
+     * to time, IFrameProviderStatusTimeout if time is after the newest frame by more than the
+     * hold time, IFrameProviderStatusOK otherwise
+     */
+    virtual IFrameProviderStatus
+    getFrameAt(const double time,
+               std::vector<yarp::sig::Vector>& segmentPoses,
+               std::vector<yarp::sig::Vector>& segmentVelocities,
+               std::vector<yarp::sig::Vector>& segmentAccelerations) = 0;
+};
+
+#endif /* end of include guard: YARP_DEV_IFRAMEHISTORYPROVIDER_H */
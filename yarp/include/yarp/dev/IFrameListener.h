@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef YARP_DEV_IFRAMELISTENER_H
+#define YARP_DEV_IFRAMELISTENER_H
+
+#include <yarp/dev/IFrameProvider.h>
+#include <yarp/dev/api.h>
+#include <yarp/os/Stamp.h>
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace yarp {
+    namespace experimental {
+        namespace dev {
+            class FrameListener;
+            class IFrameListenerRegistry;
+            class FrameListenerList;
+        } // namespace dev
+    } // namespace experimental
+} // namespace yarp
+
+/**
+ * Receiver of the new frames of an IFrameListenerRegistry
+ * \since 2.3.69
+ */
+class yarp::experimental::dev::FrameListener
+{
+public:
+    virtual ~FrameListener();
+
+    /**
+     * Called once per new frame, and at each change of the status of the provider, from a thread
+     * of the provider (e.g. the processor thread of the driver, the port thread of a remote)
+     *
+     * The provider can not deliver the next frame until all the listeners returned: keep the
+     * handler short and non-blocking, e.g. copy the data with the getters of the provider or
+     * signal a thread of yours, and never wait for the provider itself. The handler is called
+     * without locks held, so it can add listeners, but it must not remove any: a removal waits
+     * for the running notifications
+     * @param timestamp stamp of the new frame (of the last frame on a status change)
+     * @param status status of the provider
+     */
+    virtual void onNewFrame(const yarp::os::Stamp& timestamp,
+                            const IFrameProviderStatus status) = 0;
+};
+
+/**
+ * Interface of the frame providers that push their new frames to listeners, instead of being
+ * polled
+ * \since 2.3.69
+ */
+class yarp::experimental::dev::IFrameListenerRegistry
+{
+public:
+    virtual ~IFrameListenerRegistry();
+
+    /**
+     * Registers listener, which must stay valid until it is removed
+     * @return false if the listener was already registered
+     */
+    virtual bool addFrameListener(FrameListener& listener) = 0;
+
+    /**
+     * Unregisters listener. Once this returns the listener is not called anymore
+     * @return false if the listener was not registered
+     */
+    virtual bool removeFrameListener(FrameListener& listener) = 0;
+};
+
+/**
+ * Thread safe list of listeners, for the implementations of IFrameListenerRegistry. The listeners
+ * are called without any lock held, neither by the list nor (see the implementations) by the
+ * provider
+ */
+class yarp::experimental::dev::FrameListenerList
+{
+    std::mutex m_mutex;
+    // Replaced, never modified, by add and remove: notify calls the listeners of the list it
+    // copied without holding m_mutex
+    std::shared_ptr<const std::vector<FrameListener*>> m_listeners;
+    // notifications calling the listeners, waited for by remove
+    unsigned m_runningNotifications;
+    std::condition_variable m_notificationsDone;
+    // last notification, to skip the frames republished without changes
+    yarp::os::Stamp m_lastStamp;
+    IFrameProviderStatus m_lastStatus;
+
+public:
+    FrameListenerList();
+    FrameListenerList(const FrameListenerList&) = delete;
+    FrameListenerList& operator=(const FrameListenerList&) = delete;
+
+    bool add(FrameListener& listener);
+    bool remove(FrameListener& listener);
+
+    // Calls the listeners, unless stamp and status are the ones of the last notification
+    void notify(const yarp::os::Stamp& timestamp, const IFrameProviderStatus status);
+};
+
+#endif /* end of include guard: YARP_DEV_IFRAMELISTENER_H */
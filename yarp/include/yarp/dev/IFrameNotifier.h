@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef YARP_DEV_IFRAMENOTIFIER_H
+#define YARP_DEV_IFRAMENOTIFIER_H
+
+#include <yarp/dev/api.h>
+#include <yarp/os/Stamp.h>
+
+namespace yarp {
+    namespace experimental {
+        namespace dev {
+            class IFrameNotifier;
+        }
+    } // namespace experimental
+} // namespace yarp
+
+/**
+ * Interface of the frame providers that can signal the arrival of a new frame, so that consumers
+ * can run in lock-step with the data instead of polling
+ * \since 2.3.69
+ */
+class yarp::experimental::dev::IFrameNotifier
+{
+public:
+    virtual ~IFrameNotifier();
+
+    /**
+     * Blocks until the stamp of the last frame differs from lastStamp, the status of the provider
+     * changes (e.g. to timeout), or timeout seconds elapsed
+     * @param lastStamp stamp of the last frame already consumed
+     * @param timeout maximum waiting time in seconds
+     * @return true if a new frame is available or the status changed, false on timeout
+     */
+    virtual bool waitForNextFrame(const yarp::os::Stamp& lastStamp, const double timeout) = 0;
+};
+
+#endif /* end of include guard: YARP_DEV_IFRAMENOTIFIER_H */
@@ -36,6 +36,10 @@ namespace yarp {
         class VectorOf;
         typedef VectorOf<double> Vector;
     } // namespace sig
+
+    namespace os {
+        class Stamp;
+    } // namespace os
 } // namespace yarp
 
 /**
@@ -54,7 +58,14 @@ struct yarp::experimental::dev::FrameReference
  */
 class yarp::experimental::dev::IFrameProvider
 {
+    // frames() and their index, cached by the default implementations of the lookup methods
+    class FrameTable;
+    FrameTable* m_frameTable;
+
 public:
+    IFrameProvider();
+    IFrameProvider(const IFrameProvider&) = delete;
+    IFrameProvider& operator=(const IFrameProvider&) = delete;
     virtual ~IFrameProvider();
 
     virtual unsigned getFrameCount();
@@ -62,6 +73,18 @@ public:
     virtual std::vector<FrameReference> frames() = 0;
     virtual int frameIndexForFrame(const FrameReference& frame);
 
+    /**
+     * Version of the list returned by frames()
+     *
+     * Providers whose frames can change (e.g. when a new model is loaded) return a different
+     * value after each change. The default implementations of getFrameCount, frameAtIndex and
+     * frameIndexForFrame then use a cached copy of the list, with a hash index, which is rebuilt
+     * only when the version changes.
+     * The default implementation returns 0, which disables the cache: frames() is called by
+     * every lookup
+     */
+    virtual unsigned frameListVersion();
+
     /**
      * Retrieve the last read poses of all frames
      *
@@ -85,6 +108,21 @@ public:
     getFrameInformation(std::vector<yarp::sig::Vector>& segmentPoses,
                         std::vector<yarp::sig::Vector>& segmentVelocities,
                         std::vector<yarp::sig::Vector>& segmentAccelerations);
+
+    /**
+     * As getFrameInformation, also returning the stamp of the frame the data belong to
+     *
+     * Data, stamp and status are read together, so that the stamp is the one of the returned
+     * data (calling getFrameInformation and then IPreciselyTimed::getLastInputStamp the frame can
+     * change in between).
+     * The default implementation, for the providers without a stamp, calls getFrameInformation
+     * and returns an invalid stamp
+     */
+    virtual yarp::experimental::dev::IFrameProviderStatus
+    getStampedFrameInformation(std::vector<yarp::sig::Vector>& segmentPoses,
+                               std::vector<yarp::sig::Vector>& segmentVelocities,
+                               std::vector<yarp::sig::Vector>& segmentAccelerations,
+                               yarp::os::Stamp& timestamp);
 };
 
 #endif /* End of YARP_DEV_IFRAMEPROVIDER_H */
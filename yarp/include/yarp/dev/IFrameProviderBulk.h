@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef YARP_DEV_IFRAMEPROVIDERBULK_H
+#define YARP_DEV_IFRAMEPROVIDERBULK_H
+
+#include <yarp/dev/IFrameProvider.h>
+#include <yarp/dev/IIMUFrameProvider.h>
+#include <yarp/dev/api.h>
+#include <yarp/os/Stamp.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace yarp {
+    namespace experimental {
+        namespace dev {
+            class IFrameProviderBulk;
+            class IIMUFrameProviderBulk;
+
+            /**
+             * Layout of the buffers of IFrameProviderBulk: one block of FrameBulkStride values
+             * per frame, in the order of IFrameProvider::frames(). Each block holds the values
+             * returned by the getters of IFrameProvider, i.e. pose (x, y, z, qw, qx, qy, qz),
+             * velocity (linear, angular) and acceleration (linear, angular)
+             */
+            enum FrameBulkLayout
+            {
+                FrameBulkPoseOffset = 0,
+                FrameBulkVelocityOffset = 7,
+                FrameBulkAccelerationOffset = 13,
+                FrameBulkStride = 19
+            };
+
+            /**
+             * Layout of the buffers of IIMUFrameProviderBulk: one block of IMUFrameBulkStride
+             * values per IMU, in the order of IIMUFrameProvider::IMUFrames(). Each block holds
+             * orientation (qw, qx, qy, qz), angular velocity, linear acceleration and magnetic
+             * field
+             */
+            enum IMUFrameBulkLayout
+            {
+                IMUFrameBulkOrientationOffset = 0,
+                IMUFrameBulkAngularVelocityOffset = 4,
+                IMUFrameBulkLinearAccelerationOffset = 7,
+                IMUFrameBulkMagneticFieldOffset = 10,
+                IMUFrameBulkStride = 13
+            };
+
+            /**
+             * Copy width values at offset of each of the count blocks of a bulk buffer into
+             * values, e.g. the poses out of a buffer of IFrameProviderBulk. The vectors are
+             * resized only if their size does not match
+             */
+            void copyFromFrameBulk(const double* buffer,
+                                   const unsigned count,
+                                   const std::size_t stride,
+                                   const std::size_t offset,
+                                   const std::size_t width,
+                                   std::vector<yarp::sig::Vector>& values);
+        } // namespace dev
+    } // namespace experimental
+} // namespace yarp
+
+/**
+ * Interface of the frame providers that can copy a whole frame in a buffer owned by the caller,
+ * instead of one vector per frame and quantity
+ * \since 2.3.69
+ */
+class yarp::experimental::dev::IFrameProviderBulk
+{
+public:
+    virtual ~IFrameProviderBulk();
+
+    /**
+     * @return the number of values of a frame, i.e. the frame count times FrameBulkStride
+     */
+    virtual std::size_t frameBulkSize() = 0;
+
+    /**
+     * Copies the last frame in buffer, laid out as described by FrameBulkLayout, together with
+     * its stamp. As in the getters of IFrameProvider, the values of the channels disabled in the
+     * provider (see IFrameChannelSelection) are left untouched
+     * @param buffer destination of the frame
+     * @param bufferSize number of values of buffer, at least frameBulkSize()
+     * @param timestamp stamp of the copied frame
+     * @return the status of the provider, or IFrameProviderStatusError (and nothing is written)
+     * if the buffer is too small
+     */
+    virtual IFrameProviderStatus
+    getFrameBulk(double* buffer, const std::size_t bufferSize, yarp::os::Stamp& timestamp) = 0;
+};
+
+/**
+ * As IFrameProviderBulk, for the IMUs of IIMUFrameProvider
+ * \since 2.3.69
+ */
+class yarp::experimental::dev::IIMUFrameProviderBulk
+{
+public:
+    virtual ~IIMUFrameProviderBulk();
+
+    /**
+     * @return the number of values of an IMU frame, i.e. the IMU count times IMUFrameBulkStride
+     */
+    virtual std::size_t IMUFrameBulkSize() = 0;
+
+    /**
+     * Copies the last IMU frame in buffer, laid out as described by IMUFrameBulkLayout
+     * @see IFrameProviderBulk::getFrameBulk
+     */
+    virtual IIMUFrameProviderStatus
+    getIMUFrameBulk(double* buffer, const std::size_t bufferSize, yarp::os::Stamp& timestamp) = 0;
+};
+
+#endif /* end of include guard: YARP_DEV_IFRAMEPROVIDERBULK_H */
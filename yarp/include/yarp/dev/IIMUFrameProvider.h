@@ -35,6 +35,10 @@ namespace yarp {
         class VectorOf;
         typedef VectorOf<double> Vector;
     } // namespace sig
+
+    namespace os {
+        class Stamp;
+    } // namespace os
 } // namespace yarp
 
 /**
@@ -53,13 +57,26 @@ struct yarp::experimental::dev::IMUFrameReference
  */
 class yarp::experimental::dev::IIMUFrameProvider
 {
+    // IMUFrames() and their index, cached by the default implementations of the lookup methods
+    class IMUFrameTable;
+    IMUFrameTable* m_IMUFrameTable;
+
 public:
+    IIMUFrameProvider();
+    IIMUFrameProvider(const IIMUFrameProvider&) = delete;
+    IIMUFrameProvider& operator=(const IIMUFrameProvider&) = delete;
     virtual ~IIMUFrameProvider();
 
     virtual unsigned getIMUFrameCount();
     virtual IMUFrameReference IMUFrameAtIndex(unsigned IMUFrameIndex);
     virtual int IMUFrameIndexForIMUFrame(const IMUFrameReference& IMUFrame);
 
+    /**
+     * Version of the list returned by IMUFrames(), as IFrameProvider::frameListVersion.
+     * The default implementation returns 0, which disables the cache
+     */
+    virtual unsigned IMUFrameListVersion();
+
     virtual std::vector<IMUFrameReference> IMUFrames() = 0;
     virtual yarp::experimental::dev::IIMUFrameProviderStatus
     getIMUFrameOrientations(std::vector<yarp::sig::Vector>& imuOrientations) = 0;
@@ -74,6 +91,17 @@ public:
                            std::vector<yarp::sig::Vector>& imuAngularVelocities,
                            std::vector<yarp::sig::Vector>& imuLinearAccelerations,
                            std::vector<yarp::sig::Vector>& imuMagneticFields);
+
+    /**
+     * As getIMUFrameInformation, also returning the stamp of the frame the data belong to
+     * \see IFrameProvider::getStampedFrameInformation
+     */
+    virtual yarp::experimental::dev::IIMUFrameProviderStatus
+    getStampedIMUFrameInformation(std::vector<yarp::sig::Vector>& imuOrientations,
+                                  std::vector<yarp::sig::Vector>& imuAngularVelocities,
+                                  std::vector<yarp::sig::Vector>& imuLinearAccelerations,
+                                  std::vector<yarp::sig::Vector>& imuMagneticFields,
+                                  yarp::os::Stamp& timestamp);
 };
 
 #endif /* End of YARP_DEV_IIMUFRAMEPROVIDER_H */
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef YARP_DEV_IXSENSMVNDIAGNOSTICS_H
+#define YARP_DEV_IXSENSMVNDIAGNOSTICS_H
+
+#include <yarp/dev/api.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace yarp {
+    namespace experimental {
+        namespace dev {
+            class IXsensMVNDiagnostics;
+            class LatencyHistogram;
+            struct LatencyStatistics;
+            class FrameContinuityMonitor;
+            struct FrameCounters;
+            struct FrameContinuityStatistics;
+        } // namespace dev
+    } // namespace experimental
+} // namespace yarp
+
+/**
+ * Latency of one stage of the acquisition path. All the times are in seconds.
+ * \since 2.3.69
+ */
+struct yarp::experimental::dev::LatencyStatistics
+{
+    std::string stage;
+    std::uint64_t count;
+    double mean;
+    double minimum;
+    double maximum;
+    // estimated from the histogram, with a resolution of a quarter of octave
+    double median;
+    double percentile99;
+};
+
+/**
+ * Lock-free latency recorder: any number of threads can call record() concurrently with
+ * statistics(). Latencies are counted in bins of microseconds with four bins per octave.
+ * Negative, non finite and larger than MaximumLatency samples are ignored.
+ * \since 2.3.69
+ */
+class yarp::experimental::dev::LatencyHistogram
+{
+public:
+    static const unsigned BinCount = 128;
+    // seconds
+    static constexpr double MaximumLatency = 3600.0;
+
+    LatencyHistogram();
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void record(const double latency);
+    void reset();
+    LatencyStatistics statistics(const std::string& stage) const;
+
+private:
+    std::atomic<std::uint64_t> m_bins[BinCount];
+    std::atomic<std::uint64_t> m_count;
+    // nanoseconds
+    std::atomic<std::int64_t> m_sum;
+    std::atomic<std::int64_t> m_minimum;
+    std::atomic<std::int64_t> m_maximum;
+};
+
+/**
+ * Counters of the frames seen by one stage of the acquisition path
+ * \since 2.3.69
+ */
+struct yarp::experimental::dev::FrameCounters
+{
+    std::uint64_t frames;
+    // frame numbers skipped between two consecutive frames
+    std::uint64_t missing;
+    // frames with the same number as the previous one
+    std::uint64_t duplicated;
+    // frames older than the previous one
+    std::uint64_t outOfOrder;
+    // frames discarded by the stage itself (e.g. buffer overruns)
+    std::uint64_t dropped;
+};
+
+/**
+ * \since 2.3.69
+ */
+struct yarp::experimental::dev::FrameContinuityStatistics
+{
+    std::string source;
+    FrameCounters total;
+    // counters of the last complete second
+    FrameCounters lastSecond;
+};
+
+/**
+ * Detects gaps in the frame numbers seen by a stage and aggregates them per second.
+ * record*() and advance() must be called by a single thread; statistics() and reset() can be
+ * called concurrently by any thread.
+ * A frame more than RestartJump frames older than the previous one starts a new numbering (e.g.
+ * the device restarted): it becomes the reference of the next frames instead of being counted as
+ * out of order.
+ * \since 2.3.69
+ */
+class yarp::experimental::dev::FrameContinuityMonitor
+{
+public:
+    static const long long RestartJump = 1000;
+
+    FrameContinuityMonitor();
+    FrameContinuityMonitor(const FrameContinuityMonitor&) = delete;
+    FrameContinuityMonitor& operator=(const FrameContinuityMonitor&) = delete;
+
+    void recordFrame(const long long frameNumber);
+    void recordDropped(const std::uint64_t count);
+    // Closes the current second if now (in seconds) is past its end. Call it periodically
+    void advance(const double now);
+
+    void reset();
+    FrameContinuityStatistics statistics(const std::string& source) const;
+
+private:
+    enum Counter
+    {
+        Frames = 0,
+        Missing,
+        Duplicated,
+        OutOfOrder,
+        Dropped,
+        CounterCount
+    };
+
+    void count(const Counter counter, const std::uint64_t value);
+
+    std::atomic<std::uint64_t> m_total[CounterCount];
+    std::atomic<std::uint64_t> m_lastSecond[CounterCount];
+    std::atomic<bool> m_resetRequested;
+    // owned by the recording thread
+    std::uint64_t m_currentSecond[CounterCount];
+    double m_secondStart;
+    long long m_lastFrameNumber;
+    bool m_hasFrame;
+};
+
+/**
+ * Interface to the run-time diagnostics of the Xsens acquisition path
+ * \since 2.3.69
+ */
+class yarp::experimental::dev::IXsensMVNDiagnostics
+{
+public:
+    virtual ~IXsensMVNDiagnostics();
+
+    // Latency of each stage measured by the device, in the order of the acquisition path
+    virtual std::vector<LatencyStatistics> latencyStatistics() = 0;
+    virtual void resetLatencyStatistics() = 0;
+
+    // Frame continuity seen by each stage of the device, in the order of the acquisition path
+    virtual std::vector<FrameContinuityStatistics> frameContinuityStatistics() = 0;
+    virtual void resetFrameContinuityStatistics() = 0;
+};
+
+#endif /* end of include guard: YARP_DEV_IXSENSMVNDIAGNOSTICS_H */
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#ifndef YARP_DEV_THREADSCHEDULING_H
+#define YARP_DEV_THREADSCHEDULING_H
+
+#include <yarp/dev/api.h>
+
+#include <string>
+#include <vector>
+
+namespace yarp {
+    namespace os {
+        class Searchable;
+    }
+    namespace experimental {
+        namespace dev {
+            struct ThreadScheduling;
+
+            /**
+             * Read the scheduling options <prefix>-policy (default, fifo or round-robin),
+             * <prefix>-priority and <prefix>-cpus (a CPU index or a list of indices)
+             * @return false if an option is invalid
+             */
+            bool parseThreadScheduling(yarp::os::Searchable& config,
+                                       const std::string& prefix,
+                                       ThreadScheduling& scheduling);
+
+            /**
+             * Apply the scheduling options to the calling thread.
+             * On Linux the policy and priority are set with pthread_setschedparam, which usually
+             * needs the CAP_SYS_NICE capability. On Windows a real-time policy raises the thread
+             * to THREAD_PRIORITY_TIME_CRITICAL and the priority value is not used.
+             * @return false if an option could not be applied (the others are applied anyway)
+             */
+            bool applyThreadScheduling(const ThreadScheduling& scheduling);
+        } // namespace dev
+    } // namespace experimental
+} // namespace yarp
+
+/**
+ * Scheduling policy, priority and CPU affinity of a thread.
+ * The default values leave the thread as created by the system
+ * \since 2.3.69
+ */
+struct yarp::experimental::dev::ThreadScheduling
+{
+    enum Policy
+    {
+        PolicyDefault = 0,
+        PolicyFIFO,
+        PolicyRoundRobin
+    };
+
+    Policy policy;
+    // priority of the real-time policies (1 to 99 on Linux)
+    int priority;
+    // CPUs the thread may run on, empty for any
+    std::vector<int> cpus;
+
+    ThreadScheduling()
+        : policy(PolicyDefault)
+        , priority(0)
+    {}
+};
+
+#endif /* end of include guard: YARP_DEV_THREADSCHEDULING_H */
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2018 Istituto Italiano di Tecnologia (IIT)
+ * All rights reserved.
+ *
+ * This software may be modified and distributed under the terms of the
+ * GNU Lesser General Public License v2.1 or any later version.
+ */
+
+#include "FrameListTable.h"
+
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Stands for FrameReference and IMUFrameReference, which need YARP for their operator==
+struct Reference
+{
+    std::string reference;
+    std::string name;
+    bool operator==(const Reference& frame) const
+    {
+        return frame.name == name && frame.reference == reference;
+    }
+};
+
+struct ReferenceHash
+{
+    std::size_t operator()(const Reference& frame) const
+    {
+        std::hash<std::string> hash;
+        return hash(frame.reference) * 31 + hash(frame.name);
+    }
+};
+
+typedef yarp::experimental::dev::FrameListTable<Reference, ReferenceHash> Table;
+
+namespace {
+    // The frames() of a provider, counting its calls
+    class Provider
+    {
+    public:
+        std::vector<Reference> frames;
+        unsigned calls;
+
+        Provider()
+            : calls(0)
+        {}
+
+        std::vector<Reference> operator()()
+        {
+            ++calls;
+            return frames;
+        }
+    };
+
+    Reference frame(const std::string& name)
+    {
+        Reference reference = {"world", name};
+        return reference;
+    }
+
+    // std::ref: the table copies the callable it is given
+    void update(Table& table, const unsigned version, Provider& provider)
+    {
+        table.update(version, std::ref(provider));
+    }
+} // namespace
+
+// Version 0 lists the frames at every lookup, and finds them linearly
+bool check_unversioned()
+{
+    Table table;
+    Provider provider;
+    provider.frames = {frame("pelvis"), frame("head")};
+    update(table, 0, provider);
+    update(table, 0, provider);
+    if (provider.calls != 2) {
+        std::cerr << "Unversioned provider listed " << provider.calls << " times in 2 lookups"
+                  << std::endl;
+        return false;
+    }
+    if (table.indexOf(frame("head")) != 1 || table.indexOf(frame("hand")) != -1) {
+        std::cerr << "Unversioned lookup: head at " << table.indexOf(frame("head")) << ", hand at "
+                  << table.indexOf(frame("hand")) << std::endl;
+        return false;
+    }
+
+    // a change of the list is seen at the next lookup
+    provider.frames.push_back(frame("hand"));
+    update(table, 0, provider);
+    if (table.frames.size() != 3 || table.indexOf(frame("hand")) != 2) {
+        std::cerr << "Unversioned provider: a new frame is not seen" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// A versioned list is cached until the version changes, also back to 0
+bool check_versioned()
+{
+    Table table;
+    Provider provider;
+    provider.frames = {frame("pelvis"), frame("head")};
+    update(table, 1, provider);
+    update(table, 1, provider);
+    if (provider.calls != 1 || table.version != 1) {
+        std::cerr << "Version 1 listed " << provider.calls << " times in 2 lookups" << std::endl;
+        return false;
+    }
+
+    // the list changes without a new version: the cache is kept
+    provider.frames = {frame("head")};
+    update(table, 1, provider);
+    if (provider.calls != 1 || table.indexOf(frame("pelvis")) != 0) {
+        std::cerr << "The cache of version 1 was rebuilt without a version change" << std::endl;
+        return false;
+    }
+
+    update(table, 2, provider);
+    if (provider.calls != 2 || table.frames.size() != 1 || table.indexOf(frame("head")) != 0
+        || table.indexOf(frame("pelvis")) != -1) {
+        std::cerr << "The cache was not rebuilt for version 2" << std::endl;
+        return false;
+    }
+
+    provider.frames = {frame("pelvis"), frame("head")};
+    update(table, 0, provider);
+    if (provider.calls != 3 || table.version != 0 || !table.indices.empty()
+        || table.indexOf(frame("head")) != 1) {
+        std::cerr << "The cache was kept after the provider went back to version 0" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// A name listed twice is found at its first index, cached or not
+bool check_duplicates()
+{
+    Provider provider;
+    provider.frames = {frame("pelvis"), frame("head"), frame("pelvis")};
+    for (const unsigned version : {0u, 1u}) {
+        Table table;
+        update(table, version, provider);
+        if (table.indexOf(frame("pelvis")) != 0 || table.indexOf(frame("head")) != 1) {
+            std::cerr << "Version " << version << ": duplicate pelvis at "
+                      << table.indexOf(frame("pelvis")) << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Out of range indices give a frame of empty names
+bool check_frame_at()
+{
+    Table table;
+    Provider provider;
+    provider.frames = {frame("pelvis"), frame("head")};
+    update(table, 1, provider);
+    if (!(table.frameAt(1) == frame("head"))) {
+        std::cerr << "Frame 1 is " << table.frameAt(1).name << std::endl;
+        return false;
+    }
+    for (const unsigned index : {2u, 1000u}) {
+        const Reference outOfRange = table.frameAt(index);
+        if (!outOfRange.reference.empty() || !outOfRange.name.empty()) {
+            std::cerr << "Frame " << index << " of 2 is " << outOfRange.reference << "/"
+                      << outOfRange.name << std::endl;
+            return false;
+        }
+    }
+
+    Table empty;
+    if (!empty.frameAt(0).name.empty() || empty.indexOf(frame("pelvis")) != -1) {
+        std::cerr << "An empty table has frames" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main()
+{
+    if (!check_unversioned() || !check_versioned() || !check_duplicates() || !check_frame_at()) {
+        return EXIT_FAILURE;
+    }
+    std::cout << "OK" << std::endl;
+    return EXIT_SUCCESS;
+}